@@ -0,0 +1,164 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Project include(s).
+#include "traccc/definitions/common.hpp"
+#include "traccc/definitions/primitives.hpp"
+#include "traccc/edm/cell.hpp"
+#include "traccc/edm/spacepoint.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/memory_resource.hpp>
+
+// System include(s).
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <set>
+#include <utility>
+
+namespace traccc::benchmarks {
+
+/// Number of channels of the synthetic modules, in both directions
+inline constexpr channel_id n_module_channels = 256;
+
+/// Radii of the barrel layers of the toy detector used for the seeding
+inline constexpr std::array<scalar, 4u> toy_layer_radii{
+    34.f * unit<scalar>::mm, 71.f * unit<scalar>::mm,
+    116.f * unit<scalar>::mm, 172.f * unit<scalar>::mm};
+
+/// Magnetic field of the toy detector used for the seeding
+inline constexpr vector3 toy_bfield{0.f, 0.f, 2.f * unit<scalar>::T};
+
+/// Cells of a synthetic event, with the modules that they belong to
+struct synthetic_cells {
+    /// All cells of the event, sorted the way clusterization expects them
+    cell_collection_types::host cells;
+    /// The modules of the event
+    cell_module_collection_types::host modules;
+};
+
+/// Generate the cells of an event on square pixel modules
+///
+/// The cells are grouped into small, randomly placed clusters of up to 3x3
+/// pixels. They are sorted by module and in column major order inside of
+/// the modules, as expected by the clusterization algorithms.
+///
+/// @param mr        The memory resource to create the collections with
+/// @param n_modules The number of modules to generate cells on
+/// @param occupancy The fraction of the pixels of each module that are hit
+/// @param seed      The seed of the random number generator
+///
+inline synthetic_cells make_cells(vecmem::memory_resource& mr,
+                                  unsigned int n_modules, double occupancy,
+                                  unsigned int seed = 42u) {
+
+    synthetic_cells result{cell_collection_types::host{&mr},
+                           cell_module_collection_types::host{&mr}};
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<channel_id> channel(0,
+                                                      n_module_channels - 1);
+    std::uniform_int_distribution<channel_id> extent(1, 3);
+    std::uniform_real_distribution<scalar> activation(0.1f, 1.f);
+
+    const std::size_t n_hits_per_module = static_cast<std::size_t>(
+        occupancy * n_module_channels * n_module_channels);
+
+    for (unsigned int m = 0; m < n_modules; ++m) {
+
+        cell_module module;
+        module.surface_link = detray::geometry::barcode{m};
+        result.modules.push_back(module);
+
+        // The hit pixels of the module, as (channel1, channel0) pairs, to
+        // get them in column major order
+        std::set<std::pair<channel_id, channel_id>> hits;
+        while (hits.size() < n_hits_per_module) {
+            const channel_id c0 = channel(rng), c1 = channel(rng);
+            const channel_id size0 = extent(rng), size1 = extent(rng);
+            for (channel_id i = 0; i < size0; ++i) {
+                for (channel_id j = 0; j < size1; ++j) {
+                    if ((c0 + i < n_module_channels) &&
+                        (c1 + j < n_module_channels)) {
+                        hits.emplace(c1 + j, c0 + i);
+                    }
+                }
+            }
+        }
+
+        for (const auto& [c1, c0] : hits) {
+            result.cells.push_back({c0, c1, activation(rng), 0.f, m});
+        }
+    }
+    return result;
+}
+
+/// Generate the spacepoints of an event in the toy barrel detector
+///
+/// Charged particles are propagated as helices from the luminous region
+/// through the layers of @c toy_layer_radii, in the field of @c toy_bfield.
+/// Uniformly distributed noise hits are added on top of the particle hits.
+///
+/// @param mr       The memory resource to create the collection with
+/// @param n_tracks The number of particles to generate
+/// @param noise    The number of noise hits, relative to the particle hits
+/// @param seed     The seed of the random number generator
+///
+inline spacepoint_collection_types::host make_spacepoints(
+    vecmem::memory_resource& mr, unsigned int n_tracks, double noise,
+    unsigned int seed = 42u) {
+
+    spacepoint_collection_types::host result{&mr};
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<scalar> pt(1.f * unit<scalar>::GeV,
+                                              10.f * unit<scalar>::GeV);
+    std::uniform_real_distribution<scalar> phi(-M_PI, M_PI);
+    std::uniform_real_distribution<scalar> eta(-2.f, 2.f);
+    std::normal_distribution<scalar> z0(0.f, 30.f * unit<scalar>::mm);
+    std::bernoulli_distribution positive(0.5);
+
+    for (unsigned int t = 0; t < n_tracks; ++t) {
+
+        // Radius of the helix, and the charge of the particle
+        const scalar radius = pt(rng) / toy_bfield[2];
+        const scalar charge = (positive(rng) ? 1.f : -1.f);
+        const scalar phi0 = phi(rng);
+        const scalar cot_theta = std::sinh(eta(rng));
+        const scalar z_origin = z0(rng);
+
+        for (const scalar r : toy_layer_radii) {
+            // Turning angle and path length in the transverse plane
+            const scalar alpha = std::asin(r / (2.f * radius));
+            const scalar phi_r = phi0 - charge * alpha;
+            const scalar z = z_origin + 2.f * radius * alpha * cot_theta;
+            result.push_back(
+                {{r * std::cos(phi_r), r * std::sin(phi_r), z}, {}});
+        }
+    }
+
+    // Add the noise hits
+    const std::size_t n_noise =
+        static_cast<std::size_t>(noise * static_cast<double>(result.size()));
+    std::uniform_int_distribution<std::size_t> layer(
+        0, toy_layer_radii.size() - 1);
+    std::uniform_real_distribution<scalar> z(-500.f * unit<scalar>::mm,
+                                             500.f * unit<scalar>::mm);
+    for (std::size_t i = 0; i < n_noise; ++i) {
+        const scalar r = toy_layer_radii[layer(rng)];
+        const scalar phi_r = phi(rng);
+        result.push_back({{r * std::cos(phi_r), r * std::sin(phi_r), z(rng)},
+                          {}});
+    }
+    return result;
+}
+
+}  // namespace traccc::benchmarks
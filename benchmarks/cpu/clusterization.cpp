@@ -0,0 +1,116 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/clusterization/component_connection.hpp"
+#include "traccc/clusterization/detail/sparse_ccl.hpp"
+#include "traccc/clusterization/measurement_creation.hpp"
+#include "traccc/clusterization/spacepoint_formation.hpp"
+
+// Local include(s).
+#include "benchmarks/synthetic_events.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/host_memory_resource.hpp>
+
+// Google Benchmark include(s).
+#include <benchmark/benchmark.h>
+
+// System include(s).
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+/// Occupancy of the modules, from the benchmark's (per mille) argument
+double occupancy(const benchmark::State& state) {
+    return static_cast<double>(state.range(1)) * 1e-3;
+}
+
+/// Set the counters common to all of the clusterization benchmarks
+void set_counters(benchmark::State& state,
+                  const traccc::benchmarks::synthetic_cells& event) {
+    state.counters["cells"] = static_cast<double>(event.cells.size());
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() *
+                                                      event.cells.size()));
+}
+
+}  // namespace
+
+/// Connected component labeling of the cells, one module at a time
+static void BM_sparse_ccl(benchmark::State& state) {
+
+    vecmem::host_memory_resource host_mr;
+    const auto event = traccc::benchmarks::make_cells(
+        host_mr, static_cast<unsigned int>(state.range(0)), occupancy(state));
+
+    // Split the cells by module, the way the algorithm is used
+    std::vector<traccc::cell_collection_types::host> cells_per_module(
+        event.modules.size(), traccc::cell_collection_types::host{&host_mr});
+    for (const traccc::cell& c : event.cells) {
+        cells_per_module[c.module_link].push_back(c);
+    }
+    std::vector<unsigned int> labels;
+
+    for (auto _ : state) {
+        for (const auto& cells : cells_per_module) {
+            labels.resize(cells.size());
+            benchmark::DoNotOptimize(
+                traccc::detail::sparse_ccl(cells, labels));
+        }
+        benchmark::ClobberMemory();
+    }
+    set_counters(state, event);
+}
+
+/// Creation of the measurements from the clusters of cells
+static void BM_measurement_creation(benchmark::State& state) {
+
+    vecmem::host_memory_resource host_mr;
+    const auto event = traccc::benchmarks::make_cells(
+        host_mr, static_cast<unsigned int>(state.range(0)), occupancy(state));
+    const auto clusters = traccc::component_connection{host_mr}(event.cells);
+    traccc::measurement_creation algorithm{host_mr};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(algorithm(clusters, event.modules));
+    }
+    set_counters(state, event);
+    state.counters["clusters"] = static_cast<double>(clusters.size());
+}
+
+/// Local-to-global transformation of the measurements
+static void BM_spacepoint_formation(benchmark::State& state) {
+
+    vecmem::host_memory_resource host_mr;
+    const auto event = traccc::benchmarks::make_cells(
+        host_mr, static_cast<unsigned int>(state.range(0)), occupancy(state));
+    const auto measurements = traccc::measurement_creation{host_mr}(
+        traccc::component_connection{host_mr}(event.cells), event.modules);
+    traccc::spacepoint_formation algorithm{host_mr};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(algorithm(measurements, event.modules));
+    }
+    set_counters(state, event);
+    state.counters["measurements"] = static_cast<double>(measurements.size());
+}
+
+// The number of modules, and their occupancy in per mille
+BENCHMARK(BM_sparse_ccl)
+    ->ArgNames({"modules", "occupancy_permille"})
+    ->ArgsProduct({{100, 1000}, {1, 5, 20}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_measurement_creation)
+    ->ArgNames({"modules", "occupancy_permille"})
+    ->ArgsProduct({{100, 1000}, {1, 5, 20}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_spacepoint_formation)
+    ->ArgNames({"modules", "occupancy_permille"})
+    ->ArgsProduct({{100, 1000}, {1, 5, 20}})
+    ->Unit(benchmark::kMicrosecond);
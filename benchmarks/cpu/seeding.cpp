@@ -0,0 +1,131 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/seeding/detail/seeding_config.hpp"
+#include "traccc/seeding/seed_finding.hpp"
+#include "traccc/seeding/spacepoint_binning.hpp"
+#include "traccc/seeding/track_params_estimation.hpp"
+
+// Local include(s).
+#include "benchmarks/synthetic_events.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/host_memory_resource.hpp>
+
+// Google Benchmark include(s).
+#include <benchmark/benchmark.h>
+
+// System include(s).
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+/// Configuration of the seeding, the same as in the seeding unit tests
+struct seeding_setup {
+    seeding_setup() {
+        finder_config.deltaRMax = 100.f * traccc::unit<traccc::scalar>::mm;
+        finder_config.maxPtScattering =
+            0.5f * traccc::unit<traccc::scalar>::GeV;
+    }
+    traccc::seedfinder_config finder_config;
+    traccc::seedfilter_config filter_config;
+};
+
+/// Generate the spacepoints of the benchmark's (tracks, noise %) arguments
+traccc::spacepoint_collection_types::host make_event(
+    vecmem::memory_resource& mr, const benchmark::State& state) {
+
+    return traccc::benchmarks::make_spacepoints(
+        mr, static_cast<unsigned int>(state.range(0)),
+        static_cast<double>(state.range(1)) * 1e-2);
+}
+
+/// Set the counters common to all of the seeding benchmarks
+void set_counters(benchmark::State& state,
+                  const traccc::spacepoint_collection_types::host& sps) {
+    state.counters["spacepoints"] = static_cast<double>(sps.size());
+    state.SetItemsProcessed(
+        static_cast<std::int64_t>(state.iterations() * sps.size()));
+}
+
+}  // namespace
+
+/// Binning of the spacepoints into the phi-z grid
+static void BM_spacepoint_binning(benchmark::State& state) {
+
+    vecmem::host_memory_resource host_mr;
+    const auto spacepoints = make_event(host_mr, state);
+    const seeding_setup setup;
+    traccc::spacepoint_binning algorithm(
+        setup.finder_config,
+        traccc::spacepoint_grid_config{setup.finder_config}, host_mr);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(algorithm(spacepoints));
+    }
+    set_counters(state, spacepoints);
+}
+
+/// Triplet seed finding on the binned spacepoints
+static void BM_seed_finding(benchmark::State& state) {
+
+    vecmem::host_memory_resource host_mr;
+    const auto spacepoints = make_event(host_mr, state);
+    const seeding_setup setup;
+    const auto grid = traccc::spacepoint_binning(
+        setup.finder_config,
+        traccc::spacepoint_grid_config{setup.finder_config},
+        host_mr)(spacepoints);
+    traccc::seed_finding algorithm(setup.finder_config, setup.filter_config);
+
+    std::size_t n_seeds = 0;
+    for (auto _ : state) {
+        const auto seeds = algorithm(spacepoints, grid);
+        n_seeds = seeds.size();
+    }
+    set_counters(state, spacepoints);
+    state.counters["seeds"] = static_cast<double>(n_seeds);
+}
+
+/// Estimation of the track parameters of the seeds
+static void BM_track_params_estimation(benchmark::State& state) {
+
+    vecmem::host_memory_resource host_mr;
+    const auto spacepoints = make_event(host_mr, state);
+    const seeding_setup setup;
+    const auto seeds = traccc::seed_finding(
+        setup.finder_config, setup.filter_config)(
+        spacepoints, traccc::spacepoint_binning(
+                         setup.finder_config,
+                         traccc::spacepoint_grid_config{setup.finder_config},
+                         host_mr)(spacepoints));
+    traccc::track_params_estimation algorithm(host_mr);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            algorithm(spacepoints, seeds, traccc::benchmarks::toy_bfield));
+    }
+    state.counters["seeds"] = static_cast<double>(seeds.size());
+    state.SetItemsProcessed(
+        static_cast<std::int64_t>(state.iterations() * seeds.size()));
+}
+
+// The number of particles, and the amount of noise in percent
+BENCHMARK(BM_spacepoint_binning)
+    ->ArgNames({"tracks", "noise_percent"})
+    ->ArgsProduct({{100, 1000, 5000}, {0, 50}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_seed_finding)
+    ->ArgNames({"tracks", "noise_percent"})
+    ->ArgsProduct({{100, 1000, 5000}, {0, 50}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_track_params_estimation)
+    ->ArgNames({"tracks", "noise_percent"})
+    ->ArgsProduct({{100, 1000, 5000}, {0, 50}})
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,312 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/finding/finding_algorithm.hpp"
+#include "traccc/fitting/fitting_algorithm.hpp"
+#include "traccc/fitting/kalman_filter/kalman_fitter.hpp"
+#include "traccc/io/csv/make_hit_reader.hpp"
+#include "traccc/io/csv/make_particle_reader.hpp"
+#include "traccc/io/read_measurements.hpp"
+#include "traccc/io/utils.hpp"
+#include "traccc/simulation/simulator.hpp"
+#include "traccc/utils/seed_generator.hpp"
+
+// Detray include(s).
+#include "detray/core/detector.hpp"
+#include "detray/core/detector_metadata.hpp"
+#include "detray/detectors/bfield.hpp"
+#include "detray/detectors/create_telescope_detector.hpp"
+#include "detray/io/common/detector_reader.hpp"
+#include "detray/io/common/detector_writer.hpp"
+#include "detray/propagator/navigator.hpp"
+#include "detray/propagator/rk_stepper.hpp"
+#include "detray/simulation/event_generator/track_generators.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/host_memory_resource.hpp>
+
+// Google Benchmark include(s).
+#include <benchmark/benchmark.h>
+
+// System include(s).
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// Type declarations, the same as in the Kalman fitting unit tests
+using host_detector_type =
+    detray::detector<detray::default_metadata, detray::host_container_types>;
+using b_field_t = covfie::field<detray::bfield::const_bknd_t>;
+using rk_stepper_type =
+    detray::rk_stepper<b_field_t::view_t, traccc::transform3,
+                       detray::constrained_step<>>;
+using navigator_type = detray::navigator<const host_detector_type>;
+using fitter_type = traccc::kalman_fitter<rk_stepper_type, navigator_type>;
+using finding_type = traccc::finding_algorithm<rk_stepper_type, navigator_type>;
+using fitting_type = traccc::fitting_algorithm<fitter_type>;
+
+using uniform_gen_t =
+    detray::random_numbers<traccc::scalar,
+                           std::uniform_real_distribution<traccc::scalar>,
+                           std::seed_seq>;
+using generator_type =
+    detray::random_track_generator<traccc::free_track_parameters,
+                                   uniform_gen_t>;
+using writer_type = traccc::smearing_writer<
+    traccc::measurement_smearer<traccc::transform3>>;
+
+/// Position of the telescope planes
+const std::vector<traccc::scalar> plane_positions = {
+    20., 40., 60., 80., 100., 120., 140, 160, 180.};
+
+/// Magnetic field of the telescope
+constexpr traccc::vector3 B{2 * detray::unit<traccc::scalar>::T, 0, 0};
+
+/// Standard deviations for the truth seed track parameters
+constexpr std::array<traccc::scalar, traccc::e_bound_size> stddevs = {
+    0.03 * detray::unit<traccc::scalar>::mm,
+    0.03 * detray::unit<traccc::scalar>::mm,
+    0.017,
+    0.017,
+    0.001 / detray::unit<traccc::scalar>::GeV,
+    1 * detray::unit<traccc::scalar>::ns};
+
+/// Build the telescope detector of the Kalman fitting unit tests
+///
+/// It is written out to, and read back from JSON files in a given directory,
+/// to get it with the default detector metadata.
+///
+host_detector_type build_telescope(vecmem::memory_resource& mr,
+                                   const std::filesystem::path& directory) {
+
+    const detray::mask<detray::rectangle2D<>> rectangle{0u, 100000.f,
+                                                        100000.f};
+    detray::tel_det_config<> tel_cfg{rectangle};
+    tel_cfg.positions(plane_positions);
+    tel_cfg.module_material(detray::silicon_tml<traccc::scalar>{});
+    tel_cfg.mat_thickness(0.5 * detray::unit<traccc::scalar>::mm);
+    tel_cfg.pilot_track(
+        detray::detail::ray<traccc::transform3>{{0, 0, 0}, 0, {1, 0, 0}, -1});
+
+    auto [det, name_map] = create_telescope_detector(mr, tel_cfg);
+    detray::io::write_detector(det, name_map,
+                               detray::io::detector_writer_config{}
+                                   .format(detray::io::format::json)
+                                   .path(directory.string() + "/")
+                                   .replace_files(true));
+
+    detray::io::detector_reader_config reader_cfg{};
+    reader_cfg
+        .add_file((directory / "telescope_detector_geometry.json").string())
+        .add_file((directory / "telescope_detector_homogeneous_material.json")
+                      .string())
+        .add_file(
+            (directory / "telescope_detector_surface_grids.json").string());
+    auto [host_det, names] =
+        detray::io::read_detector<host_detector_type>(mr, reader_cfg);
+    return std::move(host_det);
+}
+
+/// Create a new, uniquely named temporary directory
+std::filesystem::path make_temporary_directory() {
+
+    std::random_device rd;
+    std::filesystem::path directory;
+    do {
+        directory = std::filesystem::temp_directory_path() /
+                    ("traccc_benchmark_tracking_" + std::to_string(rd()));
+    } while (!std::filesystem::create_directory(directory));
+    return directory;
+}
+
+/// The telescope setup, shared by all of the benchmarks
+///
+/// All files of the benchmarks are written into a temporary directory, which
+/// is removed again at the end of the job.
+///
+struct telescope {
+    telescope()
+        : directory(make_temporary_directory()),
+          detector(build_telescope(mr, directory)),
+          field(detray::bfield::create_const_field(B)) {}
+    ~telescope() {
+        std::error_code ec;
+        std::filesystem::remove_all(directory, ec);
+    }
+    telescope(const telescope&) = delete;
+    telescope& operator=(const telescope&) = delete;
+
+    std::filesystem::path directory;
+    vecmem::host_memory_resource mr;
+    host_detector_type detector;
+    b_field_t field;
+};
+
+/// Get the (lazily built) telescope setup
+telescope& get_telescope() {
+    static telescope tel;
+    return tel;
+}
+
+/// Input of the tracking, for one simulated event
+struct telescope_event {
+    traccc::measurement_collection_types::host measurements;
+    traccc::bound_track_parameters_collection_types::host seeds;
+};
+
+/// Simulate an event with a given number of tracks in the telescope
+///
+/// The event is simulated once per track multiplicity, into the temporary
+/// directory of the telescope, and then read back. The truth seeds of the
+/// tracks are made from the first simulated hit of every particle.
+///
+const telescope_event& get_event(unsigned int n_tracks) {
+
+    static std::map<unsigned int, telescope_event> events;
+    if (auto it = events.find(n_tracks); it != events.end()) {
+        return it->second;
+    }
+    telescope& tel = get_telescope();
+
+    // Simulate the event
+    generator_type::configuration gen_cfg{};
+    gen_cfg.n_tracks(n_tracks);
+    gen_cfg.origin({0.f, 0.f, 0.f});
+    gen_cfg.origin_stddev({0.f, 200.f, 200.f});
+    gen_cfg.phi_range(0.f, 0.f);
+    gen_cfg.theta_range(static_cast<traccc::scalar>(M_PI_2),
+                        static_cast<traccc::scalar>(M_PI_2));
+    gen_cfg.mom_range(1.f * detray::unit<traccc::scalar>::GeV,
+                      1.f * detray::unit<traccc::scalar>::GeV);
+
+    traccc::measurement_smearer<traccc::transform3> meas_smearer(
+        50 * detray::unit<traccc::scalar>::um,
+        50 * detray::unit<traccc::scalar>::um);
+    typename writer_type::config smearer_writer_cfg{meas_smearer};
+
+    const std::filesystem::path directory =
+        tel.directory / ("telescope_" + std::to_string(n_tracks));
+    std::filesystem::create_directories(directory);
+    auto sim =
+        traccc::simulator<host_detector_type, b_field_t, generator_type,
+                          writer_type>(1, tel.detector, tel.field,
+                                       generator_type(gen_cfg),
+                                       std::move(smearer_writer_cfg),
+                                       directory.string() + "/");
+    sim.run();
+
+    // Read it back
+    const auto event_file = [&directory](std::string_view suffix) {
+        return (directory / traccc::io::get_event_filename(0, suffix))
+            .string();
+    };
+
+    telescope_event event{
+        traccc::measurement_collection_types::host{&tel.mr},
+        traccc::bound_track_parameters_collection_types::host{&tel.mr}};
+    traccc::io::measurement_reader_output readOut(&tel.mr);
+    traccc::io::read_measurements(readOut, event_file("-measurements.csv"),
+                                  traccc::data_format::csv);
+    event.measurements = std::move(readOut.measurements);
+
+    std::map<std::uint64_t, traccc::scalar> charges;
+    auto preader = traccc::io::csv::make_particle_reader(
+        event_file("-particles.csv"));
+    traccc::io::csv::particle particle;
+    while (preader.read(particle)) {
+        charges[particle.particle_id] = particle.q;
+    }
+    std::map<std::uint64_t, traccc::io::csv::hit> first_hits;
+    auto hreader = traccc::io::csv::make_hit_reader(event_file("-hits.csv"));
+    traccc::io::csv::hit hit;
+    while (hreader.read(hit)) {
+        first_hits.emplace(hit.particle_id, hit);
+    }
+
+    traccc::seed_generator<host_detector_type> sg(tel.detector, stddevs);
+    for (const auto& [particle_id, first_hit] : first_hits) {
+        const traccc::free_track_parameters free_param(
+            {first_hit.tx, first_hit.ty, first_hit.tz}, 0.f,
+            {first_hit.tpx, first_hit.tpy, first_hit.tpz},
+            charges.at(particle_id));
+        event.seeds.push_back(
+            sg(detray::geometry::barcode{first_hit.geometry_id}, free_param));
+    }
+
+    return events.emplace(n_tracks, std::move(event)).first->second;
+}
+
+/// Configuration of the track finding
+finding_type::config_type finding_config() {
+    finding_type::config_type cfg;
+    cfg.chi2_max = 30.f;
+    return cfg;
+}
+
+}  // namespace
+
+/// Combinatorial Kalman filter track finding from the truth seeds
+static void BM_finding_algorithm(benchmark::State& state) {
+
+    telescope& tel = get_telescope();
+    const telescope_event& event =
+        get_event(static_cast<unsigned int>(state.range(0)));
+    finding_type algorithm(finding_config());
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(algorithm(tel.detector, tel.field,
+                                           event.measurements, event.seeds));
+    }
+    state.counters["measurements"] =
+        static_cast<double>(event.measurements.size());
+    state.SetItemsProcessed(
+        static_cast<std::int64_t>(state.iterations() * event.seeds.size()));
+}
+
+/// Kalman fitting of the found track candidates
+static void BM_fitting_algorithm(benchmark::State& state) {
+
+    telescope& tel = get_telescope();
+    const telescope_event& event =
+        get_event(static_cast<unsigned int>(state.range(0)));
+    const auto track_candidates = finding_type(finding_config())(
+        tel.detector, tel.field, event.measurements, event.seeds);
+    fitting_type algorithm(fitting_type::config_type{});
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            algorithm(tel.detector, tel.field, track_candidates));
+    }
+    state.counters["tracks"] = static_cast<double>(track_candidates.size());
+    state.SetItemsProcessed(static_cast<std::int64_t>(
+        state.iterations() * track_candidates.size()));
+}
+
+// The number of tracks per event
+BENCHMARK(BM_finding_algorithm)
+    ->ArgName("tracks")
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_fitting_algorithm)
+    ->ArgName("tracks")
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::kMillisecond);
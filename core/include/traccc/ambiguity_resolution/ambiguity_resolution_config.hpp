@@ -0,0 +1,29 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+namespace traccc {
+
+/// Configuration struct for the greedy ambiguity resolution
+struct ambiguity_resolution_config {
+    /// Tracks are removed as long as the most shared track has at least this
+    /// many measurements shared with other (surviving) tracks
+    unsigned int maximum_shared_hits = 1;
+
+    /// Maximum number of tracks to remove
+    unsigned int maximum_iterations = 1000000;
+
+    /// Minimum number of measurements of a track
+    ///
+    /// This is a separate selection, applied before the resolution: shorter
+    /// tracks are removed from the output, whether they share measurements
+    /// or not. No tracks are removed by it if zero.
+    unsigned int n_measurements_min = 0;
+};
+
+}  // namespace traccc
@@ -0,0 +1,89 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Library include(s).
+#include "traccc/ambiguity_resolution/ambiguity_resolution_config.hpp"
+#include "traccc/edm/track_candidate.hpp"
+#include "traccc/utils/algorithm.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/memory_resource.hpp>
+
+// System include(s).
+#include <functional>
+#include <vector>
+
+namespace traccc {
+
+/// Greedy ambiguity resolution for the found track candidates
+///
+/// Modelled after Acts/AmbiguityResolution/GreedyAmbiguityResolution.hpp.
+///
+/// The measurements of all candidates are given a common index first, and
+/// the measurement <-> track incidence is stored in two flat (CSR) tables.
+/// Every track keeps the number of its measurements that are shared with
+/// other surviving tracks. The tracks with the largest relative number of
+/// shared measurements are removed, which only updates the counters of the
+/// measurements of the removed tracks, until no track has
+/// @c maximum_shared_hits shared measurements any more.
+///
+/// The most ambiguous tracks that have no measurement in common are removed
+/// together, and the tracks affected by them are re-ranked once per batch.
+/// This gives the same result as removing the tracks one by one.
+///
+/// Optionally, tracks with fewer than @c n_measurements_min measurements are
+/// removed before the resolution, and do not take part in it. This cut is
+/// off by default.
+///
+class greedy_ambiguity_resolution_algorithm
+    : public algorithm<track_candidate_container_types::host(
+          const track_candidate_container_types::host&)> {
+
+    public:
+    /// Configuration type
+    using config_type = ambiguity_resolution_config;
+
+    /// Constructor for the greedy ambiguity resolution
+    ///
+    /// @param cfg  Configuration object
+    /// @param mr   The memory resource to create the output with
+    ///
+    greedy_ambiguity_resolution_algorithm(const config_type& cfg,
+                                          vecmem::memory_resource& mr);
+
+    /// Run the algorithm
+    ///
+    /// @param track_candidates the candidate measurements from track finding
+    /// @return the surviving track candidates, in their original order
+    ///
+    output_type operator()(const track_candidate_container_types::host&
+                               track_candidates) const override;
+
+    /// Run the algorithm, without copying the surviving track candidates
+    ///
+    /// Lets the caller select the surviving tracks from its own containers
+    /// that are parallel to the track candidates (like the track states of
+    /// the track finding).
+    ///
+    /// @param track_candidates the candidate measurements from track finding
+    /// @return the indices of the surviving track candidates, in increasing
+    ///         order
+    ///
+    std::vector<unsigned int> surviving_tracks(
+        const track_candidate_container_types::host& track_candidates) const;
+
+    private:
+    /// Config object
+    config_type m_cfg;
+    /// The memory resource to use in the algorithm
+    std::reference_wrapper<vecmem::memory_resource> m_mr;
+
+};  // class greedy_ambiguity_resolution_algorithm
+
+}  // namespace traccc
@@ -0,0 +1,71 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Project include(s).
+#include "traccc/definitions/qualifiers.hpp"
+#include "traccc/edm/container.hpp"
+#include "traccc/edm/track_state.hpp"
+
+// detray include(s).
+#include "detray/tracks/bound_track_parameters.hpp"
+
+namespace traccc {
+
+/// Compact fit result of a track on one of its measurements
+///
+/// Unlike @c traccc::track_state, which holds everything that the Kalman
+/// filter and smoother work with, this only holds the smoothed result of the
+/// fit. The measurement is not copied, but referred to by its index in the
+/// track candidates of the track.
+template <typename algebra_t>
+struct fitted_track_state {
+
+    using bound_track_parameters_type =
+        detray::bound_track_parameters<algebra_t>;
+    using scalar_type = typename algebra_t::scalar_type;
+
+    fitted_track_state() = default;
+
+    /// Construction from the track state of a fitted track
+    ///
+    /// @param trk_state the fitted track state
+    /// @param meas_idx index of the measurement in the track candidates
+    TRACCC_HOST_DEVICE
+    fitted_track_state(const track_state<algebra_t>& trk_state,
+                       unsigned int meas_idx)
+        : measurement_index(meas_idx),
+          is_hole(trk_state.is_hole),
+          smoothed_chi2(trk_state.smoothed_chi2()),
+          smoothed(trk_state.smoothed()) {}
+
+    /// @return the surface link
+    TRACCC_HOST_DEVICE
+    inline detray::geometry::barcode surface_link() const {
+        return smoothed.surface_link();
+    }
+
+    /// Index of the measurement in the track candidates of the track
+    unsigned int measurement_index{0u};
+    /// Whether the track did not pick up the measurement
+    bool is_hole{true};
+    /// Chi square of the smoothed parameter
+    scalar_type smoothed_chi2{0};
+    /// Smoothed parameter
+    bound_track_parameters_type smoothed;
+};
+
+/// Declare all fitted_track_state collection types
+using fitted_track_state_collection_types =
+    collection_types<fitted_track_state<transform3>>;
+
+/// Declare all fitted_track_state container types
+using fitted_track_state_container_types =
+    container_types<fitter_info<transform3>, fitted_track_state<transform3>>;
+
+}  // namespace traccc
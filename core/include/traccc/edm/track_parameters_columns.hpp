@@ -0,0 +1,122 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Project include(s).
+#include "traccc/definitions/qualifiers.hpp"
+#include "traccc/edm/track_parameters.hpp"
+
+// Detray include(s).
+#include "detray/geometry/barcode.hpp"
+
+// VecMem include(s).
+#include <vecmem/containers/vector.hpp>
+#include <vecmem/memory/memory_resource.hpp>
+
+// System include(s).
+#include <cstddef>
+
+namespace traccc {
+
+/// Column-wise storage of bound track parameters
+///
+/// The surface links, the parameter vectors and the covariance matrices of the
+/// parameters are kept in separate, contiguous arrays. The host track finding
+/// keeps its live branches in this layout, so that the passes which only need
+/// the surface links of the branches do not need to read their vectors and
+/// covariances.
+///
+/// Note that the parameters are still accessed one at a time, through
+/// (copying) @c get and @c set calls. No computation is vectorised over the
+/// arrays.
+///
+struct bound_track_parameters_columns {
+
+    /// Size type of the arrays
+    using size_type = std::size_t;
+
+    /// Default constructor
+    bound_track_parameters_columns() = default;
+
+    /// Constructor with a memory resource
+    ///
+    /// @param mr The memory resource to allocate the arrays with
+    ///
+    explicit bound_track_parameters_columns(vecmem::memory_resource& mr)
+        : surface_links(&mr), vectors(&mr), covariances(&mr) {}
+
+    /// @return the number of parameters held
+    TRACCC_HOST
+    size_type size() const { return surface_links.size(); }
+
+    /// Resize all arrays
+    TRACCC_HOST
+    void resize(size_type n) {
+        surface_links.resize(n);
+        vectors.resize(n);
+        covariances.resize(n);
+    }
+
+    /// Reserve memory in all arrays
+    TRACCC_HOST
+    void reserve(size_type n) {
+        surface_links.reserve(n);
+        vectors.reserve(n);
+        covariances.reserve(n);
+    }
+
+    /// Clear all arrays
+    TRACCC_HOST
+    void clear() {
+        surface_links.clear();
+        vectors.clear();
+        covariances.clear();
+    }
+
+    /// Append a parameter to the end of the arrays
+    TRACCC_HOST
+    void push_back(const bound_track_parameters& param) {
+        surface_links.push_back(param.surface_link());
+        vectors.push_back(param.vector());
+        covariances.push_back(param.covariance());
+    }
+
+    /// @return the (AoS) bound track parameter at a given index
+    TRACCC_HOST
+    bound_track_parameters get(size_type i) const {
+        return bound_track_parameters(surface_links[i], vectors[i],
+                                      covariances[i]);
+    }
+
+    /// Set the parameter at a given index
+    TRACCC_HOST
+    void set(size_type i, const bound_track_parameters& param) {
+        surface_links[i] = param.surface_link();
+        vectors[i] = param.vector();
+        covariances[i] = param.covariance();
+    }
+
+    /// Copy the parameter at index @c j of @c other to index @c i
+    TRACCC_HOST
+    void set(size_type i, const bound_track_parameters_columns& other,
+             size_type j) {
+        surface_links[i] = other.surface_links[j];
+        vectors[i] = other.vectors[j];
+        covariances[i] = other.covariances[j];
+    }
+
+    /// Surface links of the parameters
+    vecmem::vector<detray::geometry::barcode> surface_links;
+    /// Bound parameter vectors
+    vecmem::vector<bound_vector> vectors;
+    /// Bound covariance matrices
+    vecmem::vector<bound_covariance> covariances;
+
+};  // struct bound_track_parameters_columns
+
+}  // namespace traccc
@@ -11,12 +11,14 @@
 #include "traccc/definitions/qualifiers.hpp"
 #include "traccc/edm/measurement.hpp"
 #include "traccc/edm/track_candidate.hpp"
+#include "traccc/edm/track_parameters_columns.hpp"
 #include "traccc/edm/track_state.hpp"
 #include "traccc/finding/finding_config.hpp"
 #include "traccc/finding/interaction_register.hpp"
 #include "traccc/fitting/kalman_filter/gain_matrix_updater.hpp"
 #include "traccc/utils/algorithm.hpp"
 #include "traccc/utils/memory_resource.hpp"
+#include "traccc/utils/monotonic_memory_resource_pool.hpp"
 
 // detray include(s).
 #include "detray/propagator/actor_chain.hpp"
@@ -27,15 +29,45 @@
 #include "detray/propagator/propagator.hpp"
 
 // VecMem include(s).
+#include <vecmem/containers/jagged_vector.hpp>
+#include <vecmem/containers/vector.hpp>
+#include <vecmem/memory/host_memory_resource.hpp>
 #include <vecmem/utils/copy.hpp>
 
 // Thrust Library
 #include <thrust/pair.h>
 
+// System include(s).
+#include <functional>
+#include <memory>
+#include <vector>
+
 namespace traccc {
 
 /// Track Finding algorithm for a set of tracks
-template <typename stepper_t, typename navigator_t>
+///
+/// The algorithm follows the same breadth-first structure as the device
+/// implementation. All live branches are kept in column-wise buffers, and
+/// every step of the finding runs the following phases as (multi-threaded)
+/// parallel loops over the branches: material interaction, Kalman update and
+/// branch selection, propagation to the next surface. The tracks are built
+/// from the resulting links at the end, also in parallel.
+///
+/// Optionally the algorithm also returns the (forward) filtered track states
+/// of the found tracks, together with the transport jacobians between their
+/// surfaces. This allows the track fit to only run the smoothing of the
+/// tracks, instead of repeating the full Kalman filter.
+///
+/// All internal buffers of the algorithm are allocated from a monotonic
+/// arena that is reset at the start of every event, so after the first few
+/// events the algorithm no longer allocates scratch memory upstream. Every
+/// call takes its own arena from a pool, so one algorithm object may be
+/// called concurrently from multiple threads.
+///
+/// @tparam update_scalar_t the scalar type of the Kalman update
+///
+template <typename stepper_t, typename navigator_t,
+          typename update_scalar_t = typename stepper_t::scalar_type>
 class finding_algorithm
     : public algorithm<track_candidate_container_types::host(
           const typename navigator_t::detector_type&,
@@ -57,6 +89,9 @@ class finding_algorithm
     /// scalar type
     using scalar_type = typename transform3_type::scalar_type;
 
+    /// Matrix actor
+    using matrix_operator = typename transform3_type::matrix_actor;
+
     /// Actor chain for propagate to the next surface and its propagator type
     using actor_type =
         detray::actor_chain<std::tuple, detray::pathlimit_aborter, transporter,
@@ -75,15 +110,133 @@ class finding_algorithm
 
     using bfield_type = typename stepper_t::magnetic_field_type;
 
+    /// Navigation candidate buffer type
+    using nav_candidates_type = typename navigator_t::template vector_type<
+        typename navigator_t::intersection_type>;
+
+    /// Buffers of one step of the track finding
+    ///
+    /// Every phase of a step only reads and writes these arrays at the indices
+    /// of the branch that it processes, which allows running each phase as a
+    /// parallel batch over all live branches.
+    struct step_data {
+        /// Constructor with the memory resource of the buffers
+        explicit step_data(vecmem::memory_resource& mr)
+            : in_params(mr),
+              updated_params(mr),
+              updated_meas(&mr),
+              updated_chi2(&mr),
+              n_updated(&mr),
+              selected(&mr),
+              propagated_params(mr),
+              found_surface(&mr),
+              in_jacobians(&mr),
+              propagated_jacobians(&mr) {}
+
+        /// Parameters of the live branches at the start of the step
+        bound_track_parameters_columns in_params;
+        /// Kalman-updated parameters. Every input parameter owns
+        /// @c max_num_branches_per_surface consecutive slots, ordered by
+        /// chi-square.
+        bound_track_parameters_columns updated_params;
+        /// Measurement index of every Kalman-updated slot
+        vecmem::vector<unsigned int> updated_meas;
+        /// Chi-square of every Kalman-updated slot
+        vecmem::vector<scalar_type> updated_chi2;
+        /// Number of filled slots per input parameter
+        vecmem::vector<unsigned int> n_updated;
+        /// Slots of the branches selected for propagation
+        vecmem::vector<unsigned int> selected;
+        /// Parameters of the selected branches on the next surface
+        bound_track_parameters_columns propagated_params;
+        /// Whether the selected branches reached a next surface
+        vecmem::vector<char> found_surface;
+
+        /// Whether the transport jacobians of the branches are recorded
+        bool with_jacobians = false;
+        /// Transport jacobians of the input parameters, from the surface of
+        /// their parent branch
+        vecmem::vector<bound_covariance> in_jacobians;
+        /// Transport jacobians of the selected branches to the next surface
+        vecmem::vector<bound_covariance> propagated_jacobians;
+    };
+
+    /// Apply the material interaction on the surface of a live branch
+    ///
+    /// @param det          Detector
+    /// @param in_param_id  Index of the live branch
+    /// @param data         Buffers of the current step
+    void apply_interaction(const detector_type& det, unsigned int in_param_id,
+                           step_data& data) const;
+
+    /// Run the Kalman update of a live branch with all measurements of its
+    /// surface, keeping the best ones by chi-square
+    ///
+    /// @param det           Detector
+    /// @param measurements  Input measurements
+    /// @param barcodes      Barcodes of the surfaces with measurements
+    /// @param upper_bounds  Upper bound of the measurements of each surface
+    /// @param in_param_id   Index of the live branch
+    /// @param data          Buffers of the current step
+    void find_tracks(const detector_type& det,
+                     const measurement_collection_types::host& measurements,
+                     const vecmem::vector<detray::geometry::barcode>& barcodes,
+                     const vecmem::vector<unsigned int>& upper_bounds,
+                     unsigned int in_param_id, step_data& data) const;
+
+    /// Propagate a selected branch to the next sensitive surface
+    ///
+    /// @param det             Detector
+    /// @param field           Magnetic field
+    /// @param nav_candidates  (Re-used) navigation candidate buffer
+    /// @param branch_id       Index of the selected branch
+    /// @param data            Buffers of the current step
+    void propagate_to_next_surface(const detector_type& det,
+                                   const bfield_type& field,
+                                   nav_candidates_type& nav_candidates,
+                                   unsigned int branch_id,
+                                   step_data& data) const;
+
+    /// Run the track finding
+    ///
+    /// @param det           Detector
+    /// @param field         Magnetic field
+    /// @param measurements  Input measurements
+    /// @param seeds         Input seeds
+    /// @param track_states  Filtered track states of the found tracks, only
+    ///                      filled if not @c nullptr
+    track_candidate_container_types::host find(
+        const detector_type& det, const bfield_type& field,
+        const measurement_collection_types::host& measurements,
+        const bound_track_parameters_collection_types::host& seeds,
+        track_state_container_types::host* track_states) const;
+
     public:
     /// Configuration type
     using config_type = finding_config<scalar_type>;
 
+    /// Constructor for the finding algorithm
+    ///
+    /// The internal buffers are taken from a host memory resource owned by
+    /// the algorithm, and the output uses the default memory resource.
+    ///
+    /// @param cfg  Configuration object
+    finding_algorithm(const config_type& cfg)
+        : m_cfg(cfg),
+          m_host_mr(std::make_unique<vecmem::host_memory_resource>()),
+          m_scratch_pool(std::make_unique<monotonic_memory_resource_pool>(
+              *m_host_mr)) {}
+
     /// Constructor for the finding algorithm
     ///
     /// @param cfg  Configuration object
-    /// @param mr   The memory resource to use
-    finding_algorithm(const config_type& cfg) : m_cfg(cfg) {}
+    /// @param mr   The memory resource to use for the output, and upstream
+    ///             of the arenas of the internal buffers
+    finding_algorithm(const config_type& cfg, vecmem::memory_resource& mr)
+        : m_cfg(cfg),
+          m_mr(&mr),
+          m_scratch_pool(
+              std::make_unique<monotonic_memory_resource_pool>(mr)) {}
 
     /// Get config object (const access)
     const finding_config<scalar_type>& get_config() const { return m_cfg; }
@@ -98,9 +251,33 @@ class finding_algorithm
         const measurement_collection_types::host& measurements,
         const bound_track_parameters_collection_types::host& seeds) const;
 
+    /// Run the algorithm, also keeping the filtered track states
+    ///
+    /// The track states hold the predicted and filtered parameters, and the
+    /// transport jacobian from the previous surface, of every measurement of
+    /// the found tracks. Their smoothed parameters are not set.
+    ///
+    /// @param det    Detector
+    /// @param measurements  Input measurements
+    /// @param seeds  Input seeds
+    /// @param[out] track_states  Filtered track states, in the same order as
+    ///                           the returned track candidates (using the
+    ///                           memory resource of the container)
+    track_candidate_container_types::host operator()(
+        const detector_type& det, const bfield_type& field,
+        const measurement_collection_types::host& measurements,
+        const bound_track_parameters_collection_types::host& seeds,
+        track_state_container_types::host& track_states) const;
+
     private:
     /// Config object
     config_type m_cfg;
+    /// Upstream memory resource of the arenas, if none was provided
+    std::unique_ptr<vecmem::host_memory_resource> m_host_mr;
+    /// Memory resource of the output (the default one if not set)
+    vecmem::memory_resource* m_mr = nullptr;
+    /// Per-call arenas of the internal buffers
+    std::unique_ptr<monotonic_memory_resource_pool> m_scratch_pool;
 };
 
 }  // namespace traccc
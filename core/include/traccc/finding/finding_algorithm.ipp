@@ -9,28 +9,223 @@
 #include "traccc/finding/candidate_link.hpp"
 #include "traccc/utils/compare.hpp"
 
+// TBB include(s).
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
 // System include
 #include <algorithm>
 #include <iostream>
 #include <limits>
+#include <utility>
+#include <vector>
 
 namespace traccc {
 
-template <typename stepper_t, typename navigator_t>
+template <typename stepper_t, typename navigator_t, typename update_scalar_t>
+void finding_algorithm<stepper_t, navigator_t,
+                       update_scalar_t>::apply_interaction(
+    const detector_type& det, unsigned int in_param_id,
+    step_data& data) const {
+
+    bound_track_parameters in_param = data.in_params.get(in_param_id);
+
+    // Get intersection at surface
+    const detray::surface<detector_type> sf{det, in_param.surface_link()};
+
+    const cxt_t ctx{};
+    const auto free_vec = sf.bound_to_free_vector(ctx, in_param.vector());
+    intersection_type sfi;
+
+    const auto sf_desc = det.surface(in_param.surface_link());
+    sfi.sf_desc = sf_desc;
+    sf.template visit_mask<detray::intersection_update>(
+        detray::detail::ray<transform3_type>(free_vec), sfi,
+        det.transform_store());
+
+    // Apply interactor
+    typename interactor_type::state interactor_state;
+    interactor_type{}.update(
+        in_param, interactor_state,
+        static_cast<int>(detray::navigation::direction::e_forward), sf,
+        sfi.cos_incidence_angle);
+
+    data.in_params.set(in_param_id, in_param);
+}
+
+template <typename stepper_t, typename navigator_t, typename update_scalar_t>
+void finding_algorithm<stepper_t, navigator_t, update_scalar_t>::find_tracks(
+    const detector_type& det,
+    const measurement_collection_types::host& measurements,
+    const vecmem::vector<detray::geometry::barcode>& barcodes,
+    const vecmem::vector<unsigned int>& upper_bounds, unsigned int in_param_id,
+    step_data& data) const {
+
+    const unsigned int n_slots = m_cfg.max_num_branches_per_surface;
+    const unsigned int first_slot = in_param_id * n_slots;
+    unsigned int& n_filled = data.n_updated[in_param_id];
+    n_filled = 0u;
+
+    // Get barcode and measurements range on surface
+    const auto bcd = data.in_params.surface_links[in_param_id];
+    std::pair<unsigned int, unsigned int> range;
+
+    // Find the corresponding index of bcd in barcode vector
+    if (!std::binary_search(barcodes.begin(), barcodes.end(), bcd)) {
+        return;
+    }
+    const auto lo2 = std::lower_bound(barcodes.begin(), barcodes.end(), bcd);
+    const unsigned int bcd_id = std::distance(barcodes.begin(), lo2);
+
+    if (lo2 == barcodes.begin()) {
+        range.first = 0u;
+        range.second = upper_bounds[bcd_id];
+    } else {
+        range.first = upper_bounds[bcd_id - 1];
+        range.second = upper_bounds[bcd_id];
+    }
+
+    const detray::surface<detector_type> sf{det, bcd};
+
+    // Iterate over the measurements
+    for (unsigned int item_id = range.first; item_id < range.second;
+         item_id++) {
+
+        bound_track_parameters bound_param = data.in_params.get(in_param_id);
+        const auto& meas = measurements[item_id];
+
+        track_state<transform3_type> trk_state(meas);
+
+        // Run the Kalman update
+        sf.template visit_mask<
+            gain_matrix_updater<transform3_type, update_scalar_t>>(
+            trk_state, bound_param);
+
+        // Get the chi-square
+        const scalar_type chi2 = trk_state.filtered_chi2();
+
+        // Skip bad measurements, and the ones that would not make it into the
+        // (full) list of the best branches
+        if (!(chi2 < m_cfg.chi2_max) ||
+            (n_filled == n_slots &&
+             !(chi2 < data.updated_chi2[first_slot + n_slots - 1]))) {
+            continue;
+        }
+
+        // Insert the branch into the slots, keeping them ordered by chi-square
+        unsigned int pos = (n_filled < n_slots) ? n_filled++ : n_slots - 1;
+        while (pos > 0 && chi2 < data.updated_chi2[first_slot + pos - 1]) {
+            data.updated_params.set(first_slot + pos, data.updated_params,
+                                    first_slot + pos - 1);
+            data.updated_meas[first_slot + pos] =
+                data.updated_meas[first_slot + pos - 1];
+            data.updated_chi2[first_slot + pos] =
+                data.updated_chi2[first_slot + pos - 1];
+            pos--;
+        }
+        data.updated_params.set(first_slot + pos, trk_state.filtered());
+        data.updated_meas[first_slot + pos] = item_id;
+        data.updated_chi2[first_slot + pos] = chi2;
+    }
+}
+
+template <typename stepper_t, typename navigator_t, typename update_scalar_t>
+void finding_algorithm<stepper_t, navigator_t,
+                       update_scalar_t>::propagate_to_next_surface(
+    const detector_type& det, const bfield_type& field,
+    nav_candidates_type& nav_candidates, unsigned int branch_id,
+    step_data& data) const {
+
+    const bound_track_parameters in_param =
+        data.updated_params.get(data.selected[branch_id]);
+
+    // Create propagator
+    propagator_type propagator({}, {});
+
+    // Create propagator state, re-using the navigation candidate buffer of
+    // the previous propagation
+    nav_candidates.clear();
+    typename propagator_type::state propagation(in_param, field, det,
+                                                std::move(nav_candidates));
+    propagation._stepping
+        .template set_constraint<detray::step::constraint::e_accuracy>(
+            m_cfg.constrained_step_size);
+
+    typename detray::pathlimit_aborter::state s0;
+    typename detray::parameter_transporter<transform3_type>::state s1;
+    typename interactor::state s3;
+    typename interaction_register<interactor>::state s2{s3};
+    typename detray::next_surface_aborter::state s4{
+        m_cfg.min_step_length_for_surface_aborter};
+
+    // @TODO: Should be removed once detray is fixed to set the volume in the
+    // constructor
+    propagation._navigation.set_volume(in_param.surface_link().volume());
+
+    // Propagate to the next surface
+    propagator.propagate_sync(propagation, std::tie(s0, s1, s2, s3, s4));
+
+    // If a surface found, add the parameter for the next step
+    data.found_surface[branch_id] = s4.success;
+    if (s4.success) {
+        data.propagated_params.set(branch_id,
+                                   propagation._stepping._bound_params);
+        if (data.with_jacobians) {
+            data.propagated_jacobians[branch_id] =
+                propagation._stepping._full_jacobian;
+        }
+    }
+
+    // Take back the navigation candidate buffer for the next branch
+    nav_candidates = std::move(propagation._navigation.candidates());
+}
+
+template <typename stepper_t, typename navigator_t, typename update_scalar_t>
 track_candidate_container_types::host
-finding_algorithm<stepper_t, navigator_t>::operator()(
+finding_algorithm<stepper_t, navigator_t, update_scalar_t>::operator()(
     const detector_type& det, const bfield_type& field,
     const measurement_collection_types::host& measurements,
     const bound_track_parameters_collection_types::host& seeds) const {
 
-    track_candidate_container_types::host output_candidates;
+    return find(det, field, measurements, seeds, nullptr);
+}
+
+template <typename stepper_t, typename navigator_t, typename update_scalar_t>
+track_candidate_container_types::host
+finding_algorithm<stepper_t, navigator_t, update_scalar_t>::operator()(
+    const detector_type& det, const bfield_type& field,
+    const measurement_collection_types::host& measurements,
+    const bound_track_parameters_collection_types::host& seeds,
+    track_state_container_types::host& track_states) const {
+
+    return find(det, field, measurements, seeds, &track_states);
+}
+
+template <typename stepper_t, typename navigator_t, typename update_scalar_t>
+track_candidate_container_types::host
+finding_algorithm<stepper_t, navigator_t, update_scalar_t>::find(
+    const detector_type& det, const bfield_type& field,
+    const measurement_collection_types::host& measurements,
+    const bound_track_parameters_collection_types::host& seeds,
+    track_state_container_types::host* track_states) const {
+
+    track_candidate_container_types::host output_candidates =
+        (m_mr != nullptr) ? track_candidate_container_types::host(m_mr)
+                          : track_candidate_container_types::host();
+
+    // Take an arena for all internal buffers of this call, re-using the
+    // memory of earlier events
+    const monotonic_memory_resource_pool::lease scratch =
+        m_scratch_pool->acquire();
+    vecmem::memory_resource& scratch_mr = *scratch;
 
     /*****************************************************************
      * Measurement Operations
      *****************************************************************/
 
     // Get copy of barcode uniques
-    std::vector<measurement> uniques;
+    vecmem::vector<measurement> uniques(&scratch_mr);
     uniques.resize(measurements.size());
 
     auto end = std::unique_copy(measurements.begin(), measurements.end(),
@@ -38,7 +233,7 @@ finding_algorithm<stepper_t, navigator_t>::operator()(
     unsigned int n_modules = end - uniques.begin();
 
     // Get upper bounds of unique elements
-    std::vector<unsigned int> upper_bounds;
+    vecmem::vector<unsigned int> upper_bounds(&scratch_mr);
     upper_bounds.reserve(n_modules);
     for (unsigned int i = 0; i < n_modules; i++) {
         auto up = std::upper_bound(measurements.begin(), measurements.end(),
@@ -46,13 +241,8 @@ finding_algorithm<stepper_t, navigator_t>::operator()(
         upper_bounds.push_back(std::distance(measurements.begin(), up));
     }
 
-    // Get the number of measurements of each module
-    std::vector<unsigned int> sizes(n_modules);
-    std::adjacent_difference(upper_bounds.begin(), upper_bounds.end(),
-                             sizes.begin());
-
     // Create barcode sequence
-    std::vector<detray::geometry::barcode> barcodes;
+    vecmem::vector<detray::geometry::barcode> barcodes(&scratch_mr);
     barcodes.reserve(n_modules);
     for (unsigned int i = 0; i < n_modules; i++) {
         barcodes.push_back(uniques[i].surface_link);
@@ -62,188 +252,208 @@ finding_algorithm<stepper_t, navigator_t>::operator()(
      * Find tracks
      **********************/
 
-    std::vector<std::vector<candidate_link>> links;
+    vecmem::jagged_vector<candidate_link> links(&scratch_mr);
     links.resize(m_cfg.max_track_candidates_per_track);
 
-    std::vector<std::vector<std::size_t>> param_to_link;
+    vecmem::jagged_vector<std::size_t> param_to_link(&scratch_mr);
     param_to_link.resize(m_cfg.max_track_candidates_per_track);
 
-    std::vector<typename candidate_link::link_index_type> tips;
+    vecmem::vector<typename candidate_link::link_index_type> tips(&scratch_mr);
 
-    // Create propagator
-    propagator_type propagator({}, {});
+    // Buffers of the step loop
+    step_data data(scratch_mr);
+    data.with_jacobians = (track_states != nullptr);
+
+    // Filtered track states of the links, if they are kept
+    vecmem::jagged_vector<track_state<transform3_type>> link_states(
+        &scratch_mr);
+    if (data.with_jacobians) {
+        link_states.resize(m_cfg.max_track_candidates_per_track);
+    }
+
+    // Keys used to find the duplicate branches of a step
+    vecmem::vector<
+        std::pair<std::pair<unsigned int, unsigned int>, unsigned int>>
+        branch_keys(&scratch_mr);
+    vecmem::vector<char> is_duplicate(&scratch_mr);
+
+    // Identifiers of the measurement histories of the links of the previous
+    // and of the current step, and of the Kalman-updated slots. Links with
+    // the same identifier picked up the same measurements in all steps.
+    vecmem::vector<unsigned int> link_history(&scratch_mr);
+    vecmem::vector<unsigned int> next_link_history(&scratch_mr);
+    vecmem::vector<unsigned int> slot_history(&scratch_mr);
+
+    // Navigation candidate buffers, one per thread, shared by all
+    // propagations of the event
+    tbb::enumerable_thread_specific<nav_candidates_type> nav_candidates;
 
     // Copy seed to input parameters
-    std::vector<bound_track_parameters> in_params;
-    in_params.reserve(seeds.size());
+    data.in_params.reserve(seeds.size());
     for (const auto& seed : seeds) {
-        in_params.push_back(seed);
+        data.in_params.push_back(seed);
     }
 
-    std::vector<bound_track_parameters> out_params;
+    // The seeds are not transported from anywhere
+    if (data.with_jacobians) {
+        data.in_jacobians.assign(
+            seeds.size(),
+            matrix_operator().template identity<e_bound_size, e_bound_size>());
+    }
+
+    const unsigned int n_slots = m_cfg.max_num_branches_per_surface;
 
     for (unsigned int step = 0; step < m_cfg.max_track_candidates_per_track;
          step++) {
 
         // Iterate over input parameters
-        const std::size_t n_in_params = in_params.size();
+        const unsigned int n_in_params = data.in_params.size();
 
         // Terminate if there is no parameter to proceed
         if (n_in_params == 0) {
             break;
         }
 
-        // Rough estimation on out parameters size
-        out_params.reserve(n_in_params);
-
         // Previous step ID
         const unsigned int previous_step =
             (step == 0) ? std::numeric_limits<unsigned int>::max() : step - 1;
 
-        for (unsigned int in_param_id = 0; in_param_id < n_in_params;
-             in_param_id++) {
-
-            bound_track_parameters& in_param = in_params[in_param_id];
-
-            /*************************
-             * Material interaction
-             *************************/
-
-            // Get intersection at surface
-            const detray::surface<detector_type> sf{det,
-                                                    in_param.surface_link()};
-
-            const cxt_t ctx{};
-            const auto free_vec =
-                sf.bound_to_free_vector(ctx, in_param.vector());
-            intersection_type sfi;
-
-            const auto sf_desc = det.surface(in_param.surface_link());
-            sfi.sf_desc = sf_desc;
-            sf.template visit_mask<detray::intersection_update>(
-                detray::detail::ray<transform3_type>(free_vec), sfi,
-                det.transform_store());
-
-            // Apply interactor
-            typename interactor_type::state interactor_state;
-            interactor_type{}.update(
-                in_param, interactor_state,
-                static_cast<int>(detray::navigation::direction::e_forward), sf,
-                sfi.cos_incidence_angle);
-
-            /*************************
-             * CKF
-             *************************/
-
-            // Get barcode and measurements range on surface
-            const auto bcd = in_param.surface_link();
-            std::pair<unsigned int, unsigned int> range;
-
-            // Find the corresponding index of bcd in barcode vector
-            unsigned int bcd_id;
-            if (std::binary_search(barcodes.begin(), barcodes.end(), bcd)) {
-                const auto lo2 =
-                    std::lower_bound(barcodes.begin(), barcodes.end(), bcd);
-                bcd_id = std::distance(barcodes.begin(), lo2);
-
-                if (lo2 == barcodes.begin()) {
-                    range.first = 0u;
-                    range.second = upper_bounds[bcd_id];
-                } else {
-                    range.first = upper_bounds[bcd_id - 1];
-                    range.second = upper_bounds[bcd_id];
-                }
+        /*****************************************************************
+         * Phase 1: Apply material interaction
+         *****************************************************************/
+
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0u, n_in_params),
+                          [&](const tbb::blocked_range<unsigned int>& r) {
+                              for (unsigned int i = r.begin(); i != r.end();
+                                   ++i) {
+                                  apply_interaction(det, i, data);
+                              }
+                          });
+
+        /*****************************************************************
+         * Phase 2: Kalman update and branch selection
+         *****************************************************************/
+
+        data.updated_params.resize(n_in_params * n_slots);
+        data.updated_meas.resize(n_in_params * n_slots);
+        data.updated_chi2.resize(n_in_params * n_slots);
+        data.n_updated.resize(n_in_params);
+
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0u, n_in_params),
+                          [&](const tbb::blocked_range<unsigned int>& r) {
+                              for (unsigned int i = r.begin(); i != r.end();
+                                   ++i) {
+                                  find_tracks(det, measurements, barcodes,
+                                              upper_bounds, i, data);
+                              }
+                          });
+
+        // Branches with the same measurement history, i.e. that picked up
+        // the same measurement in this step and come from branches with the
+        // same history, are treated as duplicates. Only the one with the
+        // smallest chi-square survives. The histories start from the seeds,
+        // so branches of different seeds are never merged, even if they
+        // pick up the same measurements. Overlapping seeds are removed by
+        // the seed deduplication before the track finding instead.
+        branch_keys.clear();
+        for (unsigned int i = 0; i < n_in_params; i++) {
+            const unsigned int parent_history =
+                (step == 0) ? i : link_history[param_to_link[step - 1][i]];
+            for (unsigned int j = 0; j < data.n_updated[i]; j++) {
+                branch_keys.push_back(
+                    {{parent_history, data.updated_meas[i * n_slots + j]},
+                     i * n_slots + j});
+            }
+        }
+        std::sort(branch_keys.begin(), branch_keys.end(),
+                  [&data](const auto& lhs, const auto& rhs) {
+                      if (lhs.first != rhs.first) {
+                          return lhs.first < rhs.first;
+                      }
+                      return data.updated_chi2[lhs.second] <
+                             data.updated_chi2[rhs.second];
+                  });
+        // Number the distinct histories of the step, in the order of their
+        // (sorted) keys
+        is_duplicate.assign(n_in_params * n_slots, 0);
+        slot_history.resize(n_in_params * n_slots);
+        unsigned int n_histories = 0u;
+        for (std::size_t i = 0; i < branch_keys.size(); i++) {
+            if ((i > 0) && (branch_keys[i].first == branch_keys[i - 1].first)) {
+                is_duplicate[branch_keys[i].second] = 1;
             } else {
-                continue;
+                ++n_histories;
             }
+            slot_history[branch_keys[i].second] = n_histories - 1u;
+        }
 
-            unsigned int n_branches = 0;
-
-            // Iterate over the measurements
-            for (unsigned int item_id = range.first; item_id < range.second;
-                 item_id++) {
-                if (n_branches > m_cfg.max_num_branches_per_surface) {
-                    break;
+        // Compact the surviving branches and create their links
+        data.selected.clear();
+        next_link_history.clear();
+        for (unsigned int i = 0; i < n_in_params; i++) {
+            for (unsigned int j = 0; j < data.n_updated[i]; j++) {
+                const unsigned int slot = i * n_slots + j;
+                if (is_duplicate[slot]) {
+                    continue;
                 }
-
-                bound_track_parameters bound_param(in_param.surface_link(),
-                                                   in_param.vector(),
-                                                   in_param.covariance());
-                const auto& meas = measurements[item_id];
-
-                track_state<transform3_type> trk_state(meas);
-
-                // Run the Kalman update
-                sf.template visit_mask<gain_matrix_updater<transform3_type>>(
-                    trk_state, bound_param);
-
-                // Get the chi-square
-                const auto chi2 = trk_state.filtered_chi2();
-
-                // Found a good measurement
-                if (chi2 < m_cfg.chi2_max) {
-
-                    // Current link ID
-                    unsigned int cur_link_id =
-                        static_cast<unsigned int>(links[step].size());
-
-                    n_branches++;
-
-                    links[step].push_back(
-                        {{previous_step, in_param_id}, item_id});
-
-                    /*********************************
-                     * Propagate to the next surface
-                     *********************************/
-
-                    // Create propagator state
-                    typename propagator_type::state propagation(
-                        trk_state.filtered(), field, det);
-                    propagation._stepping.template set_constraint<
-                        detray::step::constraint::e_accuracy>(
-                        m_cfg.constrained_step_size);
-
-                    typename detray::pathlimit_aborter::state s0;
-                    typename detray::parameter_transporter<
-                        transform3_type>::state s1;
-                    typename interactor::state s3;
-                    typename interaction_register<interactor>::state s2{s3};
-                    typename detray::next_surface_aborter::state s4{
-                        m_cfg.min_step_length_for_surface_aborter};
-                    // typename propagation::print_inspector::state s5{};
-
-                    // @TODO: Should be removed once detray is fixed to set the
-                    // volume in the constructor
-                    propagation._navigation.set_volume(
-                        trk_state.filtered().surface_link().volume());
-
-                    // Propagate to the next surface
-                    propagator.propagate_sync(propagation,
-                                              std::tie(s0, s1, s2, s3, s4));
-
-                    /*
-                    propagator.propagate_sync(propagation,
-                                              std::tie(s0, s1, s2, s3, s4, s5));
-                    */
-                    // If a surface found, add the parameter for the next
-                    // step
-                    if (s4.success) {
-                        out_params.push_back(
-                            propagation._stepping._bound_params);
-                        param_to_link[step].push_back(cur_link_id);
-                    }
-                    // Unless the track found a surface, it is considered a
-                    // tip
-                    else if (!s4.success &&
-                             step >= m_cfg.min_track_candidates_per_track - 1) {
-                        tips.push_back({step, cur_link_id});
-                    }
+                data.selected.push_back(slot);
+                links[step].push_back(
+                    {{previous_step, i}, data.updated_meas[slot]});
+                next_link_history.push_back(slot_history[slot]);
+
+                if (data.with_jacobians) {
+                    track_state<transform3_type> trk_state(
+                        measurements[data.updated_meas[slot]]);
+                    trk_state.is_hole = false;
+                    trk_state.jacobian() = data.in_jacobians[i];
+                    trk_state.predicted() = data.in_params.get(i);
+                    trk_state.filtered() = data.updated_params.get(slot);
+                    trk_state.filtered_chi2() = data.updated_chi2[slot];
+                    link_states[step].push_back(std::move(trk_state));
                 }
             }
         }
+        link_history.swap(next_link_history);
+
+        /*****************************************************************
+         * Phase 3: Propagate to the next surface
+         *****************************************************************/
+
+        const unsigned int n_branches = data.selected.size();
+        data.propagated_params.resize(n_branches);
+        data.found_surface.resize(n_branches);
+        if (data.with_jacobians) {
+            data.propagated_jacobians.resize(n_branches);
+        }
 
-        in_params = std::move(out_params);
-        out_params.clear();
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0u, n_branches),
+                          [&](const tbb::blocked_range<unsigned int>& r) {
+                              nav_candidates_type& buffer =
+                                  nav_candidates.local();
+                              for (unsigned int i = r.begin(); i != r.end();
+                                   ++i) {
+                                  propagate_to_next_surface(det, field, buffer,
+                                                            i, data);
+                              }
+                          });
+
+        // Collect the parameters for the next step, and the tips
+        data.in_params.clear();
+        data.in_jacobians.clear();
+        for (unsigned int i = 0; i < n_branches; i++) {
+
+            if (data.found_surface[i]) {
+                data.in_params.push_back(data.propagated_params.get(i));
+                if (data.with_jacobians) {
+                    data.in_jacobians.push_back(data.propagated_jacobians[i]);
+                }
+                param_to_link[step].push_back(i);
+            }
+            // Unless the track found a surface, it is considered a tip
+            else if (step >= m_cfg.min_track_candidates_per_track - 1) {
+                tips.push_back({step, i});
+            }
+        }
     }
 
     /**********************
@@ -251,46 +461,62 @@ finding_algorithm<stepper_t, navigator_t>::operator()(
      **********************/
 
     // Number of found tracks = number of tips
-    output_candidates.reserve(tips.size());
-
-    for (const auto& tip : tips) {
+    output_candidates.resize(tips.size());
+    if (track_states != nullptr) {
+        track_states->resize(0u);
+        track_states->resize(tips.size());
+    }
 
-        // Skip if the number of tracks candidates is too small
-        if (tip.first + 1 < m_cfg.min_track_candidates_per_track) {
-            continue;
+    // Allocate the items of all tracks up front. The output memory resource
+    // is not necessarily thread-safe, so the parallel loop below must only
+    // fill them.
+    for (std::size_t i = 0; i < tips.size(); i++) {
+        output_candidates[i].items.resize(tips[i].first + 1);
+        if (track_states != nullptr) {
+            (*track_states)[i].items.resize(tips[i].first + 1);
         }
+    }
 
-        vecmem::vector<track_candidate> cands_per_track;
-        cands_per_track.resize(tip.first + 1);
+    tbb::parallel_for(
+        tbb::blocked_range<std::size_t>(0u, tips.size()),
+        [&](const tbb::blocked_range<std::size_t>& r) {
+            for (std::size_t i = r.begin(); i != r.end(); ++i) {
 
-        // Get the link corresponding to tip
-        auto L = links[tip.first][tip.second];
+                const auto& tip = tips[i];
+                auto& cands_per_track = output_candidates[i].items;
 
-        // Reversely iterate to fill the track candidates
-        for (auto it = cands_per_track.rbegin(); it != cands_per_track.rend();
-             it++) {
+                // Get the link corresponding to tip
+                typename candidate_link::link_index_type pos = tip;
+                auto L = links[pos.first][pos.second];
 
-            auto& cand = *it;
+                // Reversely iterate to fill the track candidates
+                for (auto it = cands_per_track.rbegin();
+                     it != cands_per_track.rend(); it++) {
 
-            cand = measurements.at(L.meas_idx);
+                    *it = measurements.at(L.meas_idx);
 
-            // Break the loop if the iterator is at the first candidate and
-            // fill the seed
-            if (it == cands_per_track.rend() - 1) {
+                    // The link of step N holds the N-th track state
+                    if (track_states != nullptr) {
+                        (*track_states)[i].items[pos.first] =
+                            link_states[pos.first][pos.second];
+                    }
 
-                auto cand_seed = seeds.at(L.previous.second);
+                    // Break the loop if the iterator is at the first candidate
+                    // and fill the seed
+                    if (it == cands_per_track.rend() - 1) {
+                        output_candidates[i].header =
+                            seeds.at(L.previous.second);
+                        break;
+                    }
 
-                // Add seed and track candidates to the output container
-                output_candidates.push_back(cand_seed, cands_per_track);
-                break;
+                    pos = {L.previous.first,
+                           static_cast<unsigned int>(
+                               param_to_link[L.previous.first]
+                                            [L.previous.second])};
+                    L = links[pos.first][pos.second];
+                }
             }
-
-            const auto l_pos =
-                param_to_link[L.previous.first][L.previous.second];
-
-            L = links[L.previous.first][l_pos];
-        }
-    }
+        });
 
     return output_candidates;
 }
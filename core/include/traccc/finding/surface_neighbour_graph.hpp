@@ -0,0 +1,403 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Project include(s).
+#include "traccc/definitions/common.hpp"
+#include "traccc/definitions/primitives.hpp"
+#include "traccc/definitions/track_parametrization.hpp"
+#include "traccc/edm/track_parameters.hpp"
+
+// detray include(s).
+#include "detray/definitions/units.hpp"
+#include "detray/geometry/barcode.hpp"
+#include "detray/propagator/actor_chain.hpp"
+#include "detray/propagator/actors/aborters.hpp"
+#include "detray/propagator/actors/parameter_transporter.hpp"
+#include "detray/propagator/propagator.hpp"
+
+// TBB include(s).
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+// System include(s).
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace traccc {
+
+/// Configuration of the surface neighbour graph
+struct surface_neighbour_graph_config {
+    /// Number of azimuthal direction bins
+    unsigned int n_phi_bins = 16;
+    /// Number of polar direction bins
+    unsigned int n_theta_bins = 8;
+    /// Number of (logarithmic) momentum bins
+    unsigned int n_momentum_bins = 2;
+    /// Momentum range of the momentum bins
+    scalar min_momentum = 0.5f * detray::unit<scalar>::GeV;
+    scalar max_momentum = 100.f * detray::unit<scalar>::GeV;
+
+    /// Local positions on every surface to start the probe tracks from
+    ///
+    /// Positions outside of the boundaries of a surface are probed as if the
+    /// surface extended to them.
+    ///
+    std::vector<std::array<scalar, 2u>> local_positions{
+        {0.f, 0.f},
+        {-5.f * detray::unit<scalar>::mm, -5.f * detray::unit<scalar>::mm},
+        {-5.f * detray::unit<scalar>::mm, 5.f * detray::unit<scalar>::mm},
+        {5.f * detray::unit<scalar>::mm, -5.f * detray::unit<scalar>::mm},
+        {5.f * detray::unit<scalar>::mm, 5.f * detray::unit<scalar>::mm}};
+
+    /// Minimum step length of the probe tracks to reach the next surface
+    scalar min_step_length_for_surface_aborter =
+        0.1f * detray::unit<scalar>::mm;
+    /// Constrained step size of the probe propagation
+    scalar constrained_step_size = std::numeric_limits<scalar>::max();
+};
+
+/// Table of the next sensitive surfaces of every sensitive surface
+///
+/// For every sensitive surface of a detector, and for every coarse bin of the
+/// (global) track direction and momentum, the graph records whether a track
+/// starting on the surface reaches another sensitive surface. It also holds
+/// the sensitive surfaces reached from every surface in any of its bins. It
+/// is built once per detector by propagating one probe track of either
+/// charge from every configured local position of every surface, through the
+/// centre of every bin. This is n_surfaces x n_bins x n_positions x 2 short
+/// propagations, run in parallel over the surfaces.
+///
+/// Since the probes only sample the bins, the graph is only a prediction. A
+/// bin is predicted to be terminal if none of the probes of the bin, nor of
+/// its neighbouring direction bins, reached another sensitive surface.
+///
+/// The track finding does not use the graph (yet). The navigator of the
+/// detray version in use always searches the candidates of the whole
+/// volume, it can not be restricted to the next surfaces of the graph.
+/// Skipping the propagation of the predicted terminal tracks instead would
+/// lose the tracks that the probes did not sample.
+///
+/// The graph is read-only after its construction, so it can be shared by any
+/// number of threads.
+///
+class surface_neighbour_graph {
+
+    public:
+    /// Configuration type
+    using config_type = surface_neighbour_graph_config;
+    /// Iterator over the next surfaces of a surface
+    using const_iterator =
+        std::vector<detray::geometry::barcode>::const_iterator;
+
+    /// Build the graph of a detector
+    ///
+    /// @param det    Detector
+    /// @param field  Magnetic field
+    /// @param cfg    Configuration of the graph
+    ///
+    template <typename stepper_t, typename navigator_t>
+    static surface_neighbour_graph build(
+        const typename navigator_t::detector_type& det,
+        const typename stepper_t::magnetic_field_type& field,
+        const config_type& cfg = {});
+
+    /// Sensitive surfaces reached by any of the probes of a surface
+    ///
+    /// @param surface  Barcode of a sensitive surface
+    /// @return the range of the next surfaces, which is empty for surfaces
+    ///         that are not in the graph
+    ///
+    std::pair<const_iterator, const_iterator> next_surfaces(
+        detray::geometry::barcode surface) const {
+
+        const auto row = m_surface_rows.find(surface.value());
+        if (row == m_surface_rows.end()) {
+            return {m_next_surfaces.end(), m_next_surfaces.end()};
+        }
+        return {m_next_surfaces.begin() + m_offsets[row->second],
+                m_next_surfaces.begin() + m_offsets[row->second + 1]};
+    }
+
+    /// Whether the bin of a track is predicted to be terminal
+    ///
+    /// @param param  Track parameters on a sensitive surface
+    /// @return @c true only if the bin of the track is terminal
+    ///
+    bool is_terminal(const bound_track_parameters& param) const {
+
+        const std::size_t b = bin(param);
+        return (b != invalid_bin) && m_terminal[b];
+    }
+
+    /// Number of sensitive surfaces in the graph
+    std::size_t n_surfaces() const { return m_surface_rows.size(); }
+
+    /// Configuration of the graph
+    const config_type& get_config() const { return m_cfg; }
+
+    private:
+    /// Marker of a track outside of the graph
+    static constexpr std::size_t invalid_bin =
+        std::numeric_limits<std::size_t>::max();
+    /// The value of pi
+    static constexpr scalar pi = static_cast<scalar>(M_PI);
+
+    /// Constructor with the configuration
+    explicit surface_neighbour_graph(const config_type& cfg) : m_cfg(cfg) {}
+
+    /// Number of bins per surface
+    std::size_t n_bins_per_surface() const {
+        return std::size_t{m_cfg.n_phi_bins} * m_cfg.n_theta_bins *
+               m_cfg.n_momentum_bins;
+    }
+
+    /// Index of a bin of a surface
+    std::size_t bin_index(std::size_t row, unsigned int i_phi,
+                          unsigned int i_theta, unsigned int i_mom) const {
+        return ((row * m_cfg.n_phi_bins + i_phi) * m_cfg.n_theta_bins +
+                i_theta) *
+                   m_cfg.n_momentum_bins +
+               i_mom;
+    }
+
+    /// Azimuthal angle at the centre of a direction bin
+    scalar bin_phi(unsigned int i_phi) const {
+        return -pi + (static_cast<scalar>(i_phi) + 0.5f) * 2.f * pi /
+                         static_cast<scalar>(m_cfg.n_phi_bins);
+    }
+
+    /// Polar angle at the centre of a direction bin
+    scalar bin_theta(unsigned int i_theta) const {
+        return (static_cast<scalar>(i_theta) + 0.5f) * pi /
+               static_cast<scalar>(m_cfg.n_theta_bins);
+    }
+
+    /// Momentum at the (logarithmic) centre of a momentum bin
+    scalar bin_momentum(unsigned int i_mom) const {
+        const scalar log_step =
+            std::log(m_cfg.max_momentum / m_cfg.min_momentum) /
+            static_cast<scalar>(m_cfg.n_momentum_bins);
+        return m_cfg.min_momentum *
+               std::exp((static_cast<scalar>(i_mom) + 0.5f) * log_step);
+    }
+
+    /// Bin of a track
+    std::size_t bin(const bound_track_parameters& param) const {
+
+        const auto row = m_surface_rows.find(param.surface_link().value());
+        if (row == m_surface_rows.end()) {
+            return invalid_bin;
+        }
+
+        const scalar phi = param.phi();
+        const scalar theta = param.theta();
+        const scalar p = std::abs(1.f / param.qop());
+
+        const auto to_bin = [](scalar x, unsigned int n) {
+            const scalar clamped =
+                std::clamp(x, scalar(0.f), static_cast<scalar>(n) - 0.5f);
+            return static_cast<unsigned int>(clamped);
+        };
+        const unsigned int i_phi = to_bin(
+            (phi + pi) / (2.f * pi) * static_cast<scalar>(m_cfg.n_phi_bins),
+            m_cfg.n_phi_bins);
+        const unsigned int i_theta = to_bin(
+            theta / pi * static_cast<scalar>(m_cfg.n_theta_bins),
+            m_cfg.n_theta_bins);
+        const unsigned int i_mom = to_bin(
+            std::log(p / m_cfg.min_momentum) /
+                std::log(m_cfg.max_momentum / m_cfg.min_momentum) *
+                static_cast<scalar>(m_cfg.n_momentum_bins),
+            m_cfg.n_momentum_bins);
+
+        return bin_index(row->second, i_phi, i_theta, i_mom);
+    }
+
+    /// Configuration of the graph
+    config_type m_cfg;
+    /// Row of every sensitive surface, keyed by its barcode
+    std::unordered_map<geometry_id, std::size_t> m_surface_rows;
+    /// Offsets of the next surfaces of every surface
+    std::vector<std::size_t> m_offsets;
+    /// Next surfaces of all surfaces
+    std::vector<detray::geometry::barcode> m_next_surfaces;
+    /// Whether the bins are terminal
+    std::vector<char> m_terminal;
+};
+
+template <typename stepper_t, typename navigator_t>
+surface_neighbour_graph surface_neighbour_graph::build(
+    const typename navigator_t::detector_type& det,
+    const typename stepper_t::magnetic_field_type& field,
+    const config_type& cfg) {
+
+    using transform3_type = typename stepper_t::transform3_type;
+    using actor_type =
+        detray::actor_chain<std::tuple, detray::pathlimit_aborter,
+                            detray::parameter_transporter<transform3_type>,
+                            detray::next_surface_aborter>;
+    using propagator_type =
+        detray::propagator<stepper_t, navigator_t, actor_type>;
+    using matrix_operator = typename transform3_type::matrix_actor;
+
+    surface_neighbour_graph graph(cfg);
+
+    // Collect the sensitive surfaces
+    std::vector<detray::geometry::barcode> surfaces;
+    for (const auto& sf_desc : det.surface_lookup()) {
+        if (sf_desc.is_sensitive()) {
+            graph.m_surface_rows.emplace(sf_desc.barcode().value(),
+                                         surfaces.size());
+            surfaces.push_back(sf_desc.barcode());
+        }
+    }
+
+    // Propagate the probe tracks of one bin of a surface to the next
+    // sensitive surface. Recording whether any of them reached a surface, and
+    // which surfaces they reached.
+    const auto probe_bin = [&](propagator_type& propagator, std::size_t row,
+                               unsigned int i_phi, unsigned int i_theta,
+                               unsigned int i_mom, char& bin_reached,
+                               std::vector<detray::geometry::barcode>& nexts) {
+        bound_vector vec = matrix_operator().template zero<e_bound_size, 1>();
+        getter::element(vec, e_bound_phi, 0u) = graph.bin_phi(i_phi);
+        getter::element(vec, e_bound_theta, 0u) = graph.bin_theta(i_theta);
+        const scalar p = graph.bin_momentum(i_mom);
+
+        for (const auto& loc : cfg.local_positions) {
+            for (const scalar charge : {-1.f, 1.f}) {
+
+                getter::element(vec, e_bound_loc0, 0u) = loc[0];
+                getter::element(vec, e_bound_loc1, 0u) = loc[1];
+                getter::element(vec, e_bound_qoverp, 0u) = charge / p;
+                const bound_track_parameters param{
+                    surfaces[row], vec,
+                    matrix_operator()
+                        .template zero<e_bound_size, e_bound_size>()};
+
+                typename propagator_type::state propagation(param, field, det);
+                propagation._stepping.template set_constraint<
+                    detray::step::constraint::e_accuracy>(
+                    cfg.constrained_step_size);
+
+                typename detray::pathlimit_aborter::state s0;
+                typename detray::parameter_transporter<transform3_type>::state
+                    s1;
+                typename detray::next_surface_aborter::state s2{
+                    cfg.min_step_length_for_surface_aborter};
+
+                propagation._navigation.set_volume(
+                    param.surface_link().volume());
+                propagator.propagate_sync(propagation, std::tie(s0, s1, s2));
+
+                if (!s2.success) {
+                    continue;
+                }
+                bin_reached = 1;
+                const detray::geometry::barcode next =
+                    propagation._stepping._bound_params.surface_link();
+                if (std::find(nexts.begin(), nexts.end(), next) ==
+                    nexts.end()) {
+                    nexts.push_back(next);
+                }
+            }
+        }
+    };
+
+    // Probe all bins of all surfaces. Every surface only writes its own
+    // bins and next surfaces, so the surfaces are probed in parallel.
+    const std::size_t n_bins = surfaces.size() * graph.n_bins_per_surface();
+    std::vector<char> reached(n_bins, 0);
+    std::vector<std::vector<detray::geometry::barcode>> next_surfaces(
+        surfaces.size());
+
+    tbb::parallel_for(
+        tbb::blocked_range<std::size_t>(0u, surfaces.size()),
+        [&](const tbb::blocked_range<std::size_t>& r) {
+            propagator_type propagator({}, {});
+            for (std::size_t row = r.begin(); row != r.end(); ++row) {
+                for (unsigned int i_phi = 0; i_phi < cfg.n_phi_bins;
+                     ++i_phi) {
+                    for (unsigned int i_theta = 0; i_theta < cfg.n_theta_bins;
+                         ++i_theta) {
+                        for (unsigned int i_mom = 0;
+                             i_mom < cfg.n_momentum_bins; ++i_mom) {
+                            probe_bin(propagator, row, i_phi, i_theta, i_mom,
+                                      reached[graph.bin_index(
+                                          row, i_phi, i_theta, i_mom)],
+                                      next_surfaces[row]);
+                        }
+                    }
+                }
+            }
+        });
+
+    // Flatten the next surfaces
+    graph.m_offsets.resize(surfaces.size() + 1, 0u);
+    for (std::size_t row = 0; row < surfaces.size(); ++row) {
+        graph.m_offsets[row + 1] =
+            graph.m_offsets[row] + next_surfaces[row].size();
+    }
+    graph.m_next_surfaces.reserve(graph.m_offsets.back());
+    for (const auto& nexts : next_surfaces) {
+        graph.m_next_surfaces.insert(graph.m_next_surfaces.end(),
+                                     nexts.begin(), nexts.end());
+    }
+
+    // A bin is terminal only if none of its neighbouring direction bins
+    // (wrapping around in phi) reached a surface either
+    graph.m_terminal.resize(n_bins, 0);
+    for (std::size_t row = 0; row < surfaces.size(); ++row) {
+        for (unsigned int i_phi = 0; i_phi < cfg.n_phi_bins; ++i_phi) {
+            for (unsigned int i_theta = 0; i_theta < cfg.n_theta_bins;
+                 ++i_theta) {
+                for (unsigned int i_mom = 0; i_mom < cfg.n_momentum_bins;
+                     ++i_mom) {
+
+                    bool terminal = true;
+                    for (int d_phi = -1; d_phi <= 1 && terminal; ++d_phi) {
+                        for (int d_theta = -1; d_theta <= 1; ++d_theta) {
+                            const int j_theta =
+                                static_cast<int>(i_theta) + d_theta;
+                            if (j_theta < 0 ||
+                                j_theta >= static_cast<int>(cfg.n_theta_bins)) {
+                                continue;
+                            }
+                            const unsigned int j_phi =
+                                static_cast<unsigned int>(
+                                    static_cast<int>(i_phi + cfg.n_phi_bins) +
+                                    d_phi) %
+                                cfg.n_phi_bins;
+                            if (reached[graph.bin_index(
+                                    row, j_phi,
+                                    static_cast<unsigned int>(j_theta),
+                                    i_mom)]) {
+                                terminal = false;
+                                break;
+                            }
+                        }
+                    }
+                    graph.m_terminal[graph.bin_index(row, i_phi, i_theta,
+                                                     i_mom)] = terminal;
+                }
+            }
+        }
+    }
+
+    return graph;
+}
+
+}  // namespace traccc
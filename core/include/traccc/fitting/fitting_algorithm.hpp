@@ -15,9 +15,27 @@
 #include "traccc/fitting/kalman_filter/kalman_fitter.hpp"
 #include "traccc/utils/algorithm.hpp"
 
+// TBB include(s).
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+// System include(s).
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
 namespace traccc {
 
 /// Fitting algorithm for a set of tracks
+///
+/// The tracks are fitted independently of each other, in parallel batches.
+/// Every batch uses its own fitter instance, and writes its results into the
+/// (pre-sized) output container at the index of the track candidates, so the
+/// order of the tracks is preserved. Within a batch the tracks are smoothed
+/// in lock-step, @c simd_width tracks at a time.
+///
 template <typename fitter_t>
 class fitting_algorithm
     : public algorithm<track_state_container_types::host(
@@ -31,6 +49,9 @@ class fitting_algorithm
     /// Configuration type
     using config_type = typename fitter_t::config_type;
 
+    /// Number of tracks smoothed in lock-step
+    static constexpr std::size_t simd_width = 8u;
+
     /// Constructor for the fitting algorithm
     ///
     /// @param cfg  Configuration object
@@ -46,39 +67,124 @@ class fitting_algorithm
         const typename track_candidate_container_types::host& track_candidates)
         const override {
 
-        fitter_t fitter(det, field, m_cfg);
+        // The number of tracks
+        const std::size_t n_tracks = track_candidates.size();
 
         track_state_container_types::host output_states;
-
-        // The number of tracks
-        std::size_t n_tracks = track_candidates.size();
+        output_states.resize(n_tracks);
 
         // Iterate over tracks
-        for (std::size_t i = 0; i < n_tracks; i++) {
-
-            // Seed parameter
-            const auto& seed_param = track_candidates[i].header;
-
-            // Make a vector of track state
-            auto& cands = track_candidates[i].items;
-            vecmem::vector<track_state<transform3_type>> input_states;
-            input_states.reserve(cands.size());
-            for (auto& cand : cands) {
-                input_states.emplace_back(cand);
-            }
+        tbb::parallel_for(
+            tbb::blocked_range<std::size_t>(0u, n_tracks),
+            [&](const tbb::blocked_range<std::size_t>& r) {
+                fitter_t fitter(det, field, m_cfg);
+
+                std::vector<typename fitter_t::state> fitter_states;
+                fitter_states.reserve(simd_width);
+
+                for (std::size_t first = r.begin(); first < r.end();
+                     first += simd_width) {
+
+                    const std::size_t n_lanes =
+                        std::min(simd_width, r.end() - first);
+
+                    std::array<const bound_track_parameters*, simd_width>
+                        seed_params{};
+                    std::array<typename fitter_t::state*, simd_width> states{};
+
+                    fitter_states.clear();
+                    for (std::size_t l = 0; l < n_lanes; ++l) {
+
+                        // Seed parameter
+                        seed_params[l] = &(track_candidates[first + l].header);
+
+                        // Make a vector of track state
+                        auto& cands = track_candidates[first + l].items;
+                        vecmem::vector<track_state<transform3_type>>
+                            input_states;
+                        input_states.reserve(cands.size());
+                        for (auto& cand : cands) {
+                            input_states.emplace_back(cand);
+                        }
+
+                        // Make a fitter state
+                        fitter_states.emplace_back(std::move(input_states));
+                    }
+                    for (std::size_t l = 0; l < n_lanes; ++l) {
+                        states[l] = &(fitter_states[l]);
+                    }
+
+                    // Run fitter
+                    fitter.fit(seed_params, states);
+
+                    for (std::size_t l = 0; l < n_lanes; ++l) {
+                        output_states[first + l].header =
+                            fitter_states[l].m_fit_info;
+                        output_states[first + l].items = std::move(
+                            fitter_states[l].m_fit_actor_state.m_track_states);
+                    }
+                }
+            });
 
-            // Make a fitter state
-            typename fitter_t::state fitter_state(std::move(input_states));
+        return output_states;
+    }
 
-            // Run fitter
-            fitter.fit(seed_param, fitter_state);
+    /// Run only the smoothing of tracks
+    ///
+    /// The track states must have been filtered already, with their
+    /// transport jacobians set, as done by the track finding. The smoothing
+    /// runs once, regardless of the configured number of iterations.
+    ///
+    /// @param track_states the filtered track states from track finding
+    /// @return the container of the fitted track parameters
+    track_state_container_types::host operator()(
+        const typename fitter_t::detector_type& det,
+        const typename fitter_t::bfield_type& field,
+        track_state_container_types::host&& track_states) const {
 
-            output_states.push_back(
-                std::move(fitter_state.m_fit_info),
-                std::move(fitter_state.m_fit_actor_state.m_track_states));
-        }
+        // The number of tracks
+        const std::size_t n_tracks = track_states.size();
 
-        return output_states;
+        // Iterate over tracks
+        tbb::parallel_for(
+            tbb::blocked_range<std::size_t>(0u, n_tracks),
+            [&](const tbb::blocked_range<std::size_t>& r) {
+                fitter_t fitter(det, field, m_cfg);
+
+                std::vector<typename fitter_t::state> fitter_states;
+                fitter_states.reserve(simd_width);
+
+                for (std::size_t first = r.begin(); first < r.end();
+                     first += simd_width) {
+
+                    const std::size_t n_lanes =
+                        std::min(simd_width, r.end() - first);
+
+                    std::array<typename fitter_t::state*, simd_width> states{};
+
+                    // Make the fitter states from the filtered track states
+                    fitter_states.clear();
+                    for (std::size_t l = 0; l < n_lanes; ++l) {
+                        fitter_states.emplace_back(
+                            std::move(track_states[first + l].items));
+                    }
+                    for (std::size_t l = 0; l < n_lanes; ++l) {
+                        states[l] = &(fitter_states[l]);
+                    }
+
+                    // Run smoother
+                    fitter.smooth(states);
+
+                    for (std::size_t l = 0; l < n_lanes; ++l) {
+                        track_states[first + l].header =
+                            fitter_states[l].m_fit_info;
+                        track_states[first + l].items = std::move(
+                            fitter_states[l].m_fit_actor_state.m_track_states);
+                    }
+                }
+            });
+
+        return std::move(track_states);
     }
 
     /// Config object
@@ -16,7 +16,16 @@ namespace traccc {
 template <typename scalar_t>
 struct fitting_config {
 
+    /// Maximum number of fit iterations
     std::size_t n_iterations = 1;
+    /// Stop iterating once the smoothed parameters at the first surface
+    /// change by less than this many standard deviations between two
+    /// iterations (no check if zero)
+    scalar_t parameter_tolerance = 0.f;
+    /// Stop iterating once the chi-square of the track changes by less than
+    /// this between two iterations (no check if zero)
+    scalar_t chi2_tolerance = 0.f;
+
     scalar_t pathlimit = std::numeric_limits<scalar_t>::max();
     scalar_t overstep_tolerance = -10 * detray::unit<scalar_t>::um;
     scalar_t step_constraint = std::numeric_limits<scalar_t>::max();
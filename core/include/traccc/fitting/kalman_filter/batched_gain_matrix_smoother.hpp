@@ -0,0 +1,375 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Project include(s).
+#include "traccc/definitions/qualifiers.hpp"
+#include "traccc/definitions/track_parametrization.hpp"
+#include "traccc/edm/track_state.hpp"
+#include "traccc/fitting/kalman_filter/gain_matrix_smoother.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace traccc {
+
+/// Gain matrix smoother running on a batch of tracks in lock-step
+///
+/// The smoothing of @c N tracks is done with their parameters packed in a
+/// structure-of-arrays layout, with one "lane" per track. Every arithmetic
+/// operation is a loop over the lanes, which the compiler turns into SIMD
+/// instructions. Tracks with fewer track states than the longest track of
+/// the batch are masked out for the remaining smoothing steps.
+///
+/// The smoothed parameters are the same as the ones of
+/// @c traccc::gain_matrix_smoother. The smoothed chi-square is not calculated
+/// here, as that depends on the surface type of the track state.
+///
+/// @tparam algebra_t the algebra of the track parameters
+/// @tparam N the number of tracks (lanes) in the batch
+/// @tparam update_scalar_t the scalar type that the smoothing is calculated
+///         with
+///
+template <typename algebra_t, std::size_t N,
+          typename update_scalar_t = typename algebra_t::scalar_type>
+struct batched_gain_matrix_smoother {
+
+    // Type declarations
+    using matrix_operator = typename algebra_t::matrix_actor;
+    using size_type = typename matrix_operator::size_ty;
+    template <size_type ROWS, size_type COLS>
+    using matrix_type =
+        typename matrix_operator::template matrix_type<ROWS, COLS>;
+    /// Scalar type that the smoothing is calculated with
+    using scalar_type = update_scalar_t;
+
+    /// Bound vectors of all lanes, indexed as [row][lane]
+    using lane_vector =
+        std::array<std::array<scalar_type, N>, e_bound_size>;
+    /// Bound matrices of all lanes, indexed as [row][column][lane]
+    using lane_matrix = std::array<lane_vector, e_bound_size>;
+
+    /// Smooth the track states of a batch of tracks
+    ///
+    /// The smoothed parameters of the last track state are set to its
+    /// filtered ones, and the smoothed parameters of all other track states
+    /// are calculated backwards from there.
+    ///
+    /// @param lanes the track states of the tracks, @c nullptr for unused
+    ///              lanes
+    template <typename track_states_t>
+    TRACCC_HOST void operator()(
+        const std::array<track_states_t*, N>& lanes) const {
+
+        // Start from the last track state of every track
+        std::size_t n_steps = 0;
+        for (std::size_t l = 0; l < N; ++l) {
+            if (lanes[l] == nullptr || lanes[l]->empty()) {
+                continue;
+            }
+            auto& last = lanes[l]->back();
+            last.smoothed().set_vector(last.filtered().vector());
+            last.smoothed().set_covariance(last.filtered().covariance());
+            n_steps = std::max(n_steps, lanes[l]->size() - 1);
+        }
+
+        lane_matrix cur_filtered_cov, next_jacobian, next_predicted_cov,
+            next_smoothed_cov;
+        lane_vector cur_filtered_vec, next_predicted_vec, next_smoothed_vec;
+        std::array<bool, N> active;
+
+        for (std::size_t step = 0; step < n_steps; ++step) {
+
+            // Gather the parameters of the active lanes. The masked lanes
+            // get (well-defined) unit matrices.
+            for (std::size_t l = 0; l < N; ++l) {
+                active[l] =
+                    (lanes[l] != nullptr) && (step + 1 < lanes[l]->size());
+                if (!active[l]) {
+                    set_identity(cur_filtered_cov, l);
+                    set_identity(next_jacobian, l);
+                    set_identity(next_predicted_cov, l);
+                    set_identity(next_smoothed_cov, l);
+                    for (size_type i = 0; i < e_bound_size; ++i) {
+                        cur_filtered_vec[i][l] = 0.f;
+                        next_predicted_vec[i][l] = 0.f;
+                        next_smoothed_vec[i][l] = 0.f;
+                    }
+                    continue;
+                }
+                const std::size_t cur_idx = lanes[l]->size() - 2 - step;
+                const auto& cur = (*lanes[l])[cur_idx];
+                const auto& next = (*lanes[l])[cur_idx + 1];
+
+                gather(cur.filtered().covariance(), cur_filtered_cov, l);
+                gather(next.jacobian(), next_jacobian, l);
+                gather(next.predicted().covariance(), next_predicted_cov, l);
+                gather(next.smoothed().covariance(), next_smoothed_cov, l);
+                gather(cur.filtered().vector(), cur_filtered_vec, l);
+                gather(next.predicted().vector(), next_predicted_vec, l);
+                gather(next.smoothed().vector(), next_smoothed_vec, l);
+            }
+
+            // Regularization for numerical stability, the same as in
+            // traccc::gain_matrix_smoother::invert_covariance
+            static constexpr scalar_type epsilon =
+                std::numeric_limits<scalar_type>::epsilon();
+            lane_matrix regularized_predicted_cov = next_predicted_cov;
+            for (size_type i = 0; i < e_bound_size; ++i) {
+                for (std::size_t l = 0; l < N; ++l) {
+                    regularized_predicted_cov[i][i][l] *= (1.f + epsilon);
+                }
+            }
+
+            // A = C_cur * J_next^T * (C_pred_next)^-1
+            lane_matrix predicted_cov_inv, tmp, A;
+            const std::array<bool, N> spd =
+                invert_spd(regularized_predicted_cov, predicted_cov_inv);
+            for (std::size_t l = 0; l < N; ++l) {
+                if (!spd[l]) {
+                    invert_general(regularized_predicted_cov,
+                                   predicted_cov_inv, l);
+                }
+            }
+            multiply_abt(cur_filtered_cov, next_jacobian, tmp);
+            multiply(tmp, predicted_cov_inv, A);
+
+            // x_smt = x_cur + A * (x_smt_next - x_pred_next)
+            lane_vector smt_vec;
+            for (size_type i = 0; i < e_bound_size; ++i) {
+                for (std::size_t l = 0; l < N; ++l) {
+                    smt_vec[i][l] = cur_filtered_vec[i][l];
+                }
+                for (size_type k = 0; k < e_bound_size; ++k) {
+                    for (std::size_t l = 0; l < N; ++l) {
+                        smt_vec[i][l] += A[i][k][l] *
+                                         (next_smoothed_vec[k][l] -
+                                          next_predicted_vec[k][l]);
+                    }
+                }
+            }
+
+            // C_smt = C_cur + A * (C_smt_next - C_pred_next) * A^T
+            lane_matrix diff, smt_cov;
+            for (size_type i = 0; i < e_bound_size; ++i) {
+                for (size_type j = 0; j < e_bound_size; ++j) {
+                    for (std::size_t l = 0; l < N; ++l) {
+                        diff[i][j][l] = next_smoothed_cov[i][j][l] -
+                                        next_predicted_cov[i][j][l];
+                    }
+                }
+            }
+            multiply(A, diff, tmp);
+            multiply_abt(tmp, A, smt_cov);
+            for (size_type i = 0; i < e_bound_size; ++i) {
+                for (size_type j = 0; j < e_bound_size; ++j) {
+                    for (std::size_t l = 0; l < N; ++l) {
+                        smt_cov[i][j][l] += cur_filtered_cov[i][j][l];
+                    }
+                }
+            }
+
+            // Scatter the results into the active lanes
+            for (std::size_t l = 0; l < N; ++l) {
+                if (!active[l]) {
+                    continue;
+                }
+                auto& cur = (*lanes[l])[lanes[l]->size() - 2 - step];
+                matrix_type<e_bound_size, 1> vec;
+                matrix_type<e_bound_size, e_bound_size> cov;
+                scatter(smt_vec, vec, l);
+                scatter(smt_cov, cov, l);
+                cur.smoothed().set_vector(vec);
+                cur.smoothed().set_covariance(cov);
+            }
+        }
+    }
+
+    private:
+    /// Copy a bound vector into a lane
+    TRACCC_HOST static void gather(const matrix_type<e_bound_size, 1>& vec,
+                                   lane_vector& out, std::size_t l) {
+        for (size_type i = 0; i < e_bound_size; ++i) {
+            out[i][l] =
+                static_cast<scalar_type>(matrix_operator().element(vec, i, 0));
+        }
+    }
+
+    /// Copy a bound matrix into a lane
+    TRACCC_HOST static void gather(
+        const matrix_type<e_bound_size, e_bound_size>& mat, lane_matrix& out,
+        std::size_t l) {
+        for (size_type i = 0; i < e_bound_size; ++i) {
+            for (size_type j = 0; j < e_bound_size; ++j) {
+                out[i][j][l] = static_cast<scalar_type>(
+                    matrix_operator().element(mat, i, j));
+            }
+        }
+    }
+
+    /// Copy a lane into a bound vector
+    TRACCC_HOST static void scatter(const lane_vector& in,
+                                    matrix_type<e_bound_size, 1>& vec,
+                                    std::size_t l) {
+        for (size_type i = 0; i < e_bound_size; ++i) {
+            matrix_operator().element(vec, i, 0) =
+                static_cast<typename algebra_t::scalar_type>(in[i][l]);
+        }
+    }
+
+    /// Copy a lane into a bound matrix
+    TRACCC_HOST static void scatter(
+        const lane_matrix& in, matrix_type<e_bound_size, e_bound_size>& mat,
+        std::size_t l) {
+        for (size_type i = 0; i < e_bound_size; ++i) {
+            for (size_type j = 0; j < e_bound_size; ++j) {
+                matrix_operator().element(mat, i, j) =
+                    static_cast<typename algebra_t::scalar_type>(in[i][j][l]);
+            }
+        }
+    }
+
+    /// Set a lane to the unit matrix
+    TRACCC_HOST static void set_identity(lane_matrix& mat, std::size_t l) {
+        for (size_type i = 0; i < e_bound_size; ++i) {
+            for (size_type j = 0; j < e_bound_size; ++j) {
+                mat[i][j][l] = (i == j) ? 1.f : 0.f;
+            }
+        }
+    }
+
+    /// c = a * b, in all lanes
+    TRACCC_HOST static void multiply(const lane_matrix& a, const lane_matrix& b,
+                                     lane_matrix& c) {
+        for (size_type i = 0; i < e_bound_size; ++i) {
+            for (size_type j = 0; j < e_bound_size; ++j) {
+                for (std::size_t l = 0; l < N; ++l) {
+                    c[i][j][l] = 0.f;
+                }
+                for (size_type k = 0; k < e_bound_size; ++k) {
+                    for (std::size_t l = 0; l < N; ++l) {
+                        c[i][j][l] += a[i][k][l] * b[k][j][l];
+                    }
+                }
+            }
+        }
+    }
+
+    /// c = a * b^T, in all lanes
+    TRACCC_HOST static void multiply_abt(const lane_matrix& a,
+                                         const lane_matrix& b,
+                                         lane_matrix& c) {
+        for (size_type i = 0; i < e_bound_size; ++i) {
+            for (size_type j = 0; j < e_bound_size; ++j) {
+                for (std::size_t l = 0; l < N; ++l) {
+                    c[i][j][l] = 0.f;
+                }
+                for (size_type k = 0; k < e_bound_size; ++k) {
+                    for (std::size_t l = 0; l < N; ++l) {
+                        c[i][j][l] += a[i][k][l] * b[j][k][l];
+                    }
+                }
+            }
+        }
+    }
+
+    /// Invert a symmetric positive definite matrix in all lanes, using its
+    /// Cholesky decomposition
+    ///
+    /// @return whether the matrix of every lane was positive definite. The
+    ///         inverse of the other lanes is not meaningful.
+    TRACCC_HOST static std::array<bool, N> invert_spd(const lane_matrix& a,
+                                                      lane_matrix& inv) {
+
+        // a = L * L^T. Lanes that turn out not to be positive definite
+        // continue with a unit pivot, to keep their arithmetic well-defined.
+        std::array<bool, N> spd;
+        spd.fill(true);
+        lane_matrix L{};
+        for (size_type j = 0; j < e_bound_size; ++j) {
+            for (std::size_t l = 0; l < N; ++l) {
+                scalar_type d = a[j][j][l];
+                for (size_type k = 0; k < j; ++k) {
+                    d -= L[j][k][l] * L[j][k][l];
+                }
+                if (!(d > 0.f)) {
+                    spd[l] = false;
+                    d = 1.f;
+                }
+                L[j][j][l] = std::sqrt(d);
+            }
+            for (size_type i = j + 1; i < e_bound_size; ++i) {
+                for (std::size_t l = 0; l < N; ++l) {
+                    scalar_type s = a[i][j][l];
+                    for (size_type k = 0; k < j; ++k) {
+                        s -= L[i][k][l] * L[j][k][l];
+                    }
+                    L[i][j][l] = s / L[j][j][l];
+                }
+            }
+        }
+
+        // L^-1, which is also lower triangular
+        lane_matrix L_inv{};
+        for (size_type i = 0; i < e_bound_size; ++i) {
+            for (std::size_t l = 0; l < N; ++l) {
+                L_inv[i][i][l] = 1.f / L[i][i][l];
+            }
+            for (size_type j = 0; j < i; ++j) {
+                for (std::size_t l = 0; l < N; ++l) {
+                    scalar_type s = 0.f;
+                    for (size_type k = j; k < i; ++k) {
+                        s -= L[i][k][l] * L_inv[k][j][l];
+                    }
+                    L_inv[i][j][l] = s * L_inv[i][i][l];
+                }
+            }
+        }
+
+        // a^-1 = L^-T * L^-1
+        for (size_type i = 0; i < e_bound_size; ++i) {
+            for (size_type j = 0; j <= i; ++j) {
+                for (std::size_t l = 0; l < N; ++l) {
+                    scalar_type s = 0.f;
+                    for (size_type k = i; k < e_bound_size; ++k) {
+                        s += L_inv[k][i][l] * L_inv[k][j][l];
+                    }
+                    inv[i][j][l] = s;
+                    inv[j][i][l] = s;
+                }
+            }
+        }
+        return spd;
+    }
+
+    /// Invert the matrix of one lane with the general inverse of
+    /// @c traccc::gain_matrix_smoother
+    TRACCC_HOST static void invert_general(const lane_matrix& a,
+                                           lane_matrix& inv, std::size_t l) {
+
+        using smoother_type = gain_matrix_smoother<algebra_t, scalar_type>;
+        typename smoother_type::matrix_array a_l, inv_l;
+        for (size_type i = 0; i < e_bound_size; ++i) {
+            for (size_type j = 0; j < e_bound_size; ++j) {
+                a_l[i][j] = a[i][j][l];
+            }
+        }
+        smoother_type::invert_general(a_l, inv_l);
+        for (size_type i = 0; i < e_bound_size; ++i) {
+            for (size_type j = 0; j < e_bound_size; ++j) {
+                inv[i][j][l] = inv_l[i][j];
+            }
+        }
+    }
+};
+
+}  // namespace traccc
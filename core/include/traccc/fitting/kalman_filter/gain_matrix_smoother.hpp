@@ -15,11 +15,20 @@
 // detray include(s).
 #include "detray/propagator/navigator.hpp"
 
+// System include(s).
+#include <cmath>
+#include <limits>
+
 namespace traccc {
 
 /// Type unrolling functor to smooth the track parameters after the Kalman
 /// filtering
-template <typename algebra_t>
+///
+/// @tparam algebra_t the algebra of the track parameters
+/// @tparam update_scalar_t the scalar type that the smoothing is calculated
+///         with
+template <typename algebra_t,
+          typename update_scalar_t = typename algebra_t::scalar_type>
 struct gain_matrix_smoother {
 
     // Type declarations
@@ -29,6 +38,11 @@ struct gain_matrix_smoother {
     using matrix_type =
         typename matrix_operator::template matrix_type<ROWS, COLS>;
     using scalar_type = typename algebra_t::scalar_type;
+    using update_scalar_type = update_scalar_t;
+
+    /// Bound vector and matrix in the precision of the smoothing
+    using vector_array = update_scalar_t[e_bound_size];
+    using matrix_array = update_scalar_t[e_bound_size][e_bound_size];
 
     /// Gain matrix smoother operation
     ///
@@ -59,11 +73,35 @@ struct gain_matrix_smoother {
         }
     }
 
+    /// Smoothed chi-square operation
+    ///
+    /// Used for track states whose smoothed parameters were already set, for
+    /// instance by @c traccc::batched_gain_matrix_smoother.
+    ///
+    /// @param mask_group mask group that contains the mask of the current
+    /// surface
+    /// @param index mask index of the current surface
+    /// @param cur_state track state of the current surface
+    template <typename mask_group_t, typename index_t>
+    TRACCC_HOST_DEVICE inline void operator()(
+        const mask_group_t& /*mask_group*/, const index_t& /*index*/,
+        track_state<algebra_t>& cur_state) const {
+
+        using shape_type = typename mask_group_t::value_type::shape;
+
+        const auto D = cur_state.get_measurement().meas_dim;
+        assert(D == 1u || D == 2u);
+        if (D == 1u) {
+            update_chi2<1u, shape_type>(cur_state);
+        } else if (D == 2u) {
+            update_chi2<2u, shape_type>(cur_state);
+        }
+    }
+
     template <size_type D, typename shape_t>
     TRACCC_HOST_DEVICE inline void smoothe(
         track_state<algebra_t>& cur_state,
         const track_state<algebra_t>& next_state) const {
-        const auto meas = cur_state.get_measurement();
 
         static_assert(((D == 1u) || (D == 2u)),
                       "The measurement dimension should be 1 or 2");
@@ -73,71 +111,332 @@ struct gain_matrix_smoother {
         const auto& cur_filtered = cur_state.filtered();
 
         // Next track state parameters
-        const matrix_type<e_bound_size, e_bound_size>& next_jacobian =
-            next_state.jacobian();
-        const matrix_type<e_bound_size, 1>& next_smoothed_vec =
-            next_smoothed.vector();
-        const matrix_type<e_bound_size, e_bound_size>& next_smoothed_cov =
-            next_smoothed.covariance();
-        const matrix_type<e_bound_size, 1>& next_predicted_vec =
-            next_predicted.vector();
-        const matrix_type<e_bound_size, e_bound_size>& next_predicted_cov =
-            next_predicted.covariance();
+        matrix_array next_jacobian, next_smoothed_cov, next_predicted_cov;
+        vector_array next_smoothed_vec, next_predicted_vec;
+        load(next_state.jacobian(), next_jacobian);
+        load(next_smoothed.vector(), next_smoothed_vec);
+        load(next_smoothed.covariance(), next_smoothed_cov);
+        load(next_predicted.vector(), next_predicted_vec);
+        load(next_predicted.covariance(), next_predicted_cov);
 
         // Current track state parameters
-        const matrix_type<e_bound_size, 1>& cur_filtered_vec =
-            cur_filtered.vector();
-        const matrix_type<e_bound_size, e_bound_size>& cur_filtered_cov =
-            cur_filtered.covariance();
-
-        // Regularization matrix for numerical stability
-        static constexpr scalar_type epsilon = 1e-13f;
-        const matrix_type<e_bound_size, e_bound_size> regularization =
-            matrix_operator().template identity<e_bound_size, e_bound_size>() *
-            epsilon;
-        const matrix_type<e_bound_size, e_bound_size>
-            regularized_predicted_cov = next_predicted_cov + regularization;
-
-        // Calculate smoothed parameter for current state
-        const matrix_type<e_bound_size, e_bound_size> A =
-            cur_filtered_cov * matrix_operator().transpose(next_jacobian) *
-            matrix_operator().inverse(regularized_predicted_cov);
-
-        const matrix_type<e_bound_size, 1> smt_vec =
-            cur_filtered_vec + A * (next_smoothed_vec - next_predicted_vec);
-        const matrix_type<e_bound_size, e_bound_size> smt_cov =
-            cur_filtered_cov + A * (next_smoothed_cov - next_predicted_cov) *
-                                   matrix_operator().transpose(A);
+        matrix_array cur_filtered_cov;
+        vector_array cur_filtered_vec;
+        load(cur_filtered.vector(), cur_filtered_vec);
+        load(cur_filtered.covariance(), cur_filtered_cov);
+
+        // A = C_cur * J_next^T * (C_pred_next)^-1
+        matrix_array predicted_cov_inv, tmp, A;
+        invert_covariance(next_predicted_cov, predicted_cov_inv);
+        for (size_type i = 0u; i < e_bound_size; ++i) {
+            for (size_type j = 0u; j < e_bound_size; ++j) {
+                tmp[i][j] = 0.f;
+                for (size_type k = 0u; k < e_bound_size; ++k) {
+                    tmp[i][j] += cur_filtered_cov[i][k] * next_jacobian[j][k];
+                }
+            }
+        }
+        multiply(tmp, predicted_cov_inv, A);
+
+        // x_smt = x_cur + A * (x_smt_next - x_pred_next)
+        matrix_type<e_bound_size, 1> smt_vec;
+        for (size_type i = 0u; i < e_bound_size; ++i) {
+            update_scalar_t value = cur_filtered_vec[i];
+            for (size_type k = 0u; k < e_bound_size; ++k) {
+                value +=
+                    A[i][k] * (next_smoothed_vec[k] - next_predicted_vec[k]);
+            }
+            getter::element(smt_vec, i, 0u) = static_cast<scalar_type>(value);
+        }
+
+        // C_smt = C_cur + A * (C_smt_next - C_pred_next) * A^T
+        matrix_array diff;
+        for (size_type i = 0u; i < e_bound_size; ++i) {
+            for (size_type j = 0u; j < e_bound_size; ++j) {
+                diff[i][j] = next_smoothed_cov[i][j] - next_predicted_cov[i][j];
+            }
+        }
+        multiply(A, diff, tmp);
+        matrix_type<e_bound_size, e_bound_size> smt_cov;
+        for (size_type i = 0u; i < e_bound_size; ++i) {
+            for (size_type j = 0u; j < e_bound_size; ++j) {
+                update_scalar_t value = cur_filtered_cov[i][j];
+                for (size_type k = 0u; k < e_bound_size; ++k) {
+                    value += tmp[i][k] * A[j][k];
+                }
+                getter::element(smt_cov, i, j) =
+                    static_cast<scalar_type>(value);
+            }
+        }
 
         cur_state.smoothed().set_vector(smt_vec);
         cur_state.smoothed().set_covariance(smt_cov);
 
-        matrix_type<D, e_bound_size> H = meas.subs.template projector<D>();
+        update_chi2<D, shape_t>(cur_state);
+    }
+
+    template <size_type D, typename shape_t>
+    TRACCC_HOST_DEVICE inline void update_chi2(
+        track_state<algebra_t>& cur_state) const {
+        const auto meas = cur_state.get_measurement();
+
+        static_assert(((D == 1u) || (D == 2u)),
+                      "The measurement dimension should be 1 or 2");
+
+        const matrix_type<e_bound_size, 1>& smt_vec =
+            cur_state.smoothed().vector();
+        const matrix_type<e_bound_size, e_bound_size>& smt_cov =
+            cur_state.smoothed().covariance();
+
+        // Measured parameters and their sign in the projection matrix
+        const auto& axes = meas.subs.get_indices();
+        update_scalar_t sign[D];
+        for (size_type i = 0u; i < D; ++i) {
+            sign[i] = 1.f;
+        }
 
         // Correct sign for line detector
         if constexpr (std::is_same_v<shape_t, detray::line<true>> ||
                       std::is_same_v<shape_t, detray::line<false>>) {
 
             if (getter::element(smt_vec, e_bound_loc0, 0u) < 0) {
-                getter::element(H, 0u, e_bound_loc0) = -1;
+                sign[0] = -1.f;
             }
         }
 
-        // Calculate smoothed chi square
-        const matrix_type<D, 1>& meas_local =
-            cur_state.template measurement_local<D>();
-        const matrix_type<D, D>& V =
-            cur_state.template measurement_covariance<D>();
-        const matrix_type<D, 1> residual = meas_local - H * smt_vec;
-        const matrix_type<D, D> R =
-            V - H * smt_cov * matrix_operator().transpose(H);
-        const matrix_type<1, 1> chi2 = matrix_operator().transpose(residual) *
-                                       matrix_operator().inverse(R) * residual;
+        // Calculate smoothed chi square, picking the measured parameters
+        // instead of multiplying with the projection matrix. The measurement
+        // covariance is diagonal.
+        update_scalar_t residual[D];
+        update_scalar_t R[D][D];
+        for (size_type i = 0u; i < D; ++i) {
+            residual[i] =
+                static_cast<update_scalar_t>(meas.local[i]) -
+                sign[i] * static_cast<update_scalar_t>(
+                              getter::element(smt_vec, axes[i], 0u));
+            for (size_type j = 0u; j < D; ++j) {
+                R[i][j] = ((i == j) ? static_cast<update_scalar_t>(
+                                          meas.variance[i])
+                                    : 0.f) -
+                          sign[i] * sign[j] *
+                              static_cast<update_scalar_t>(getter::element(
+                                  smt_cov, axes[i], axes[j]));
+            }
+        }
+        update_scalar_t R_inv[D][D];
+        invert(R, R_inv);
+        update_scalar_t chi2 = 0.f;
+        for (size_type i = 0u; i < D; ++i) {
+            for (size_type j = 0u; j < D; ++j) {
+                chi2 += residual[i] * R_inv[i][j] * residual[j];
+            }
+        }
 
-        cur_state.smoothed_chi2() = matrix_operator().element(chi2, 0, 0);
+        cur_state.smoothed_chi2() = static_cast<scalar_type>(chi2);
 
         return;
     }
+
+    /// Invert a (predicted) covariance matrix
+    ///
+    /// The diagonal of the matrix is regularised by scaling it up with the
+    /// machine epsilon of @c update_scalar_t, which keeps the regularisation
+    /// relative to the (very different) scales of the track parameters. The
+    /// matrix is then inverted through its Cholesky decomposition. If that
+    /// fails, because the matrix is not positive definite (numerically), the
+    /// general inverse is used instead.
+    ///
+    /// @param a   The matrix to invert
+    /// @param inv The inverse of the regularised matrix. All zeros if the
+    ///            matrix is singular, which leaves the filtered parameters
+    ///            unchanged by the smoothing.
+    TRACCC_HOST_DEVICE static inline void invert_covariance(
+        const matrix_array& a, matrix_array& inv) {
+
+        // Regularization for numerical stability
+        static constexpr update_scalar_t epsilon =
+            std::numeric_limits<update_scalar_t>::epsilon();
+        matrix_array regularized;
+        for (size_type i = 0u; i < e_bound_size; ++i) {
+            for (size_type j = 0u; j < e_bound_size; ++j) {
+                regularized[i][j] =
+                    (i == j) ? a[i][j] * (1.f + epsilon) : a[i][j];
+            }
+        }
+
+        if (!invert_spd(regularized, inv)) {
+            invert_general(regularized, inv);
+        }
+    }
+
+    /// Invert a general matrix, using Gauss-Jordan elimination with partial
+    /// pivoting
+    ///
+    /// Sets @c inv to all zeros if the matrix is singular.
+    TRACCC_HOST_DEVICE static inline void invert_general(const matrix_array& a,
+                                                         matrix_array& inv) {
+
+        matrix_array m;
+        for (size_type i = 0u; i < e_bound_size; ++i) {
+            for (size_type j = 0u; j < e_bound_size; ++j) {
+                m[i][j] = a[i][j];
+                inv[i][j] = (i == j) ? 1.f : 0.f;
+            }
+        }
+
+        for (size_type c = 0u; c < e_bound_size; ++c) {
+
+            // Pick the largest pivot of the column
+            size_type pivot = c;
+            for (size_type i = c + 1u; i < e_bound_size; ++i) {
+                if (std::abs(m[i][c]) > std::abs(m[pivot][c])) {
+                    pivot = i;
+                }
+            }
+            if ((m[pivot][c] == 0.f) || !std::isfinite(m[pivot][c])) {
+                for (size_type i = 0u; i < e_bound_size; ++i) {
+                    for (size_type j = 0u; j < e_bound_size; ++j) {
+                        inv[i][j] = 0.f;
+                    }
+                }
+                return;
+            }
+            if (pivot != c) {
+                for (size_type j = 0u; j < e_bound_size; ++j) {
+                    const update_scalar_t t1 = m[c][j];
+                    m[c][j] = m[pivot][j];
+                    m[pivot][j] = t1;
+                    const update_scalar_t t2 = inv[c][j];
+                    inv[c][j] = inv[pivot][j];
+                    inv[pivot][j] = t2;
+                }
+            }
+
+            // Normalise the pivot row, and eliminate the column from the
+            // other rows
+            const update_scalar_t pivot_inv = 1.f / m[c][c];
+            for (size_type j = 0u; j < e_bound_size; ++j) {
+                m[c][j] *= pivot_inv;
+                inv[c][j] *= pivot_inv;
+            }
+            for (size_type i = 0u; i < e_bound_size; ++i) {
+                if (i == c) {
+                    continue;
+                }
+                const update_scalar_t f = m[i][c];
+                for (size_type j = 0u; j < e_bound_size; ++j) {
+                    m[i][j] -= f * m[c][j];
+                    inv[i][j] -= f * inv[c][j];
+                }
+            }
+        }
+    }
+
+    private:
+    /// Copy a bound vector into the precision of the smoothing
+    TRACCC_HOST_DEVICE static inline void load(
+        const matrix_type<e_bound_size, 1>& vec, vector_array& out) {
+        for (size_type i = 0u; i < e_bound_size; ++i) {
+            out[i] = static_cast<update_scalar_t>(getter::element(vec, i, 0u));
+        }
+    }
+
+    /// Copy a bound matrix into the precision of the smoothing
+    TRACCC_HOST_DEVICE static inline void load(
+        const matrix_type<e_bound_size, e_bound_size>& mat, matrix_array& out) {
+        for (size_type i = 0u; i < e_bound_size; ++i) {
+            for (size_type j = 0u; j < e_bound_size; ++j) {
+                out[i][j] =
+                    static_cast<update_scalar_t>(getter::element(mat, i, j));
+            }
+        }
+    }
+
+    /// c = a * b
+    TRACCC_HOST_DEVICE static inline void multiply(const matrix_array& a,
+                                                   const matrix_array& b,
+                                                   matrix_array& c) {
+        for (size_type i = 0u; i < e_bound_size; ++i) {
+            for (size_type j = 0u; j < e_bound_size; ++j) {
+                c[i][j] = 0.f;
+                for (size_type k = 0u; k < e_bound_size; ++k) {
+                    c[i][j] += a[i][k] * b[k][j];
+                }
+            }
+        }
+    }
+
+    /// Invert a symmetric positive definite matrix, using its Cholesky
+    /// decomposition
+    ///
+    /// @return false if the matrix is not positive definite, in which case
+    ///         @c inv is not set
+    TRACCC_HOST_DEVICE static inline bool invert_spd(const matrix_array& a,
+                                                     matrix_array& inv) {
+
+        // a = L * L^T
+        matrix_array L;
+        for (size_type j = 0u; j < e_bound_size; ++j) {
+            update_scalar_t d = a[j][j];
+            for (size_type k = 0u; k < j; ++k) {
+                d -= L[j][k] * L[j][k];
+            }
+            // Also catches NaNs
+            if (!(d > 0.f)) {
+                return false;
+            }
+            L[j][j] = std::sqrt(d);
+            for (size_type i = j + 1u; i < e_bound_size; ++i) {
+                update_scalar_t s = a[i][j];
+                for (size_type k = 0u; k < j; ++k) {
+                    s -= L[i][k] * L[j][k];
+                }
+                L[i][j] = s / L[j][j];
+            }
+        }
+
+        // L^-1, which is also lower triangular
+        matrix_array L_inv;
+        for (size_type i = 0u; i < e_bound_size; ++i) {
+            L_inv[i][i] = 1.f / L[i][i];
+            for (size_type j = 0u; j < i; ++j) {
+                update_scalar_t s = 0.f;
+                for (size_type k = j; k < i; ++k) {
+                    s -= L[i][k] * L_inv[k][j];
+                }
+                L_inv[i][j] = s * L_inv[i][i];
+            }
+        }
+
+        // a^-1 = L^-T * L^-1
+        for (size_type i = 0u; i < e_bound_size; ++i) {
+            for (size_type j = 0u; j <= i; ++j) {
+                update_scalar_t s = 0.f;
+                for (size_type k = i; k < e_bound_size; ++k) {
+                    s += L_inv[k][i] * L_inv[k][j];
+                }
+                inv[i][j] = s;
+                inv[j][i] = s;
+            }
+        }
+        return true;
+    }
+
+    /// Invert a 1x1 matrix
+    TRACCC_HOST_DEVICE static inline void invert(
+        const update_scalar_t (&m)[1][1], update_scalar_t (&inv)[1][1]) {
+        inv[0][0] = 1.f / m[0][0];
+    }
+
+    /// Invert a 2x2 matrix
+    TRACCC_HOST_DEVICE static inline void invert(
+        const update_scalar_t (&m)[2][2], update_scalar_t (&inv)[2][2]) {
+        const update_scalar_t det = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+        inv[0][0] = m[1][1] / det;
+        inv[0][1] = -m[0][1] / det;
+        inv[1][0] = -m[1][0] / det;
+        inv[1][1] = m[0][0] / det;
+    }
 };
 
-}  // namespace traccc
\ No newline at end of file
+}  // namespace traccc
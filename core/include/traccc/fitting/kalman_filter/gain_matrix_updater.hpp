@@ -15,7 +15,14 @@
 namespace traccc {
 
 /// Type unrolling functor for Kalman updating
-template <typename algebra_t>
+///
+/// @tparam algebra_t the algebra of the track parameters
+/// @tparam update_scalar_t the scalar type that the update is calculated
+///         with. The track parameters are converted to it before, and back
+///         after the update, such that e.g. float track parameters can be
+///         updated in double precision.
+template <typename algebra_t,
+          typename update_scalar_t = typename algebra_t::scalar_type>
 struct gain_matrix_updater {
 
     // Type declarations
@@ -24,6 +31,8 @@ struct gain_matrix_updater {
     template <size_type ROWS, size_type COLS>
     using matrix_type =
         typename matrix_operator::template matrix_type<ROWS, COLS>;
+    using scalar_type = typename algebra_t::scalar_type;
+    using update_scalar_type = update_scalar_t;
 
     /// Gain matrix updater operation
     ///
@@ -53,6 +62,14 @@ struct gain_matrix_updater {
         }
     }
 
+    /// Kalman update with a @c D dimensional measurement
+    ///
+    /// The projection matrix H only selects (and possibly flips the sign of)
+    /// @c D parameters of the bound track parameters. Instead of building H
+    /// and multiplying with it, all products with H are evaluated by picking
+    /// the rows and columns of the measured parameters, and the filtered
+    /// covariance is only calculated for one triangle of the symmetric
+    /// matrix.
     template <size_type D, typename shape_t>
     TRACCC_HOST_DEVICE inline void update(
         track_state<algebra_t>& trk_state,
@@ -63,19 +80,12 @@ struct gain_matrix_updater {
 
         const auto meas = trk_state.get_measurement();
 
-        // Some identity matrices
-        // @Note: Make constexpr work
-        const matrix_type<e_bound_size, e_bound_size> I66 =
-            matrix_operator().template identity<e_bound_size, e_bound_size>();
-
-        const matrix_type<D, D> I_m =
-            matrix_operator().template identity<D, D>();
-
-        matrix_type<D, e_bound_size> H = meas.subs.template projector<D>();
-
-        // Measurement data on surface
-        const matrix_type<D, 1>& meas_local =
-            trk_state.template measurement_local<D>();
+        // Measured parameters and their sign in the projection matrix
+        const auto& axes = meas.subs.get_indices();
+        update_scalar_t sign[D];
+        for (size_type i = 0u; i < D; ++i) {
+            sign[i] = 1.f;
+        }
 
         // Predicted vector of bound track parameters
         const matrix_type<e_bound_size, 1>& predicted_vec =
@@ -93,34 +103,117 @@ struct gain_matrix_updater {
                       std::is_same_v<shape_t, detray::line<false>>) {
 
             if (getter::element(predicted_vec, e_bound_loc0, 0u) < 0) {
-                getter::element(H, 0u, e_bound_loc0) = -1;
+                sign[0] = -1.f;
             }
         }
 
-        // Spatial resolution (Measurement covariance)
-        const matrix_type<D, D> V =
-            trk_state.template measurement_covariance<D>();
+        // Measurement data and spatial resolution (the measurement covariance
+        // is diagonal), in the precision of the update
+        update_scalar_t meas_local[D];
+        update_scalar_t V[D];
+        for (size_type i = 0u; i < D; ++i) {
+            meas_local[i] = static_cast<update_scalar_t>(meas.local[i]);
+            V[i] = static_cast<update_scalar_t>(meas.variance[i]);
+        }
 
-        const matrix_type<D, D> M =
-            H * predicted_cov * matrix_operator().transpose(H) + V;
+        // Predicted parameters, in the precision of the update
+        update_scalar_t x[e_bound_size];
+        update_scalar_t P[e_bound_size][e_bound_size];
+        for (size_type r = 0u; r < e_bound_size; ++r) {
+            x[r] = static_cast<update_scalar_t>(
+                getter::element(predicted_vec, r, 0u));
+            for (size_type c = 0u; c < e_bound_size; ++c) {
+                P[r][c] = static_cast<update_scalar_t>(
+                    getter::element(predicted_cov, r, c));
+            }
+        }
+
+        // P * H^T: the (signed) columns of the measured parameters
+        update_scalar_t PHt[e_bound_size][D];
+        for (size_type r = 0u; r < e_bound_size; ++r) {
+            for (size_type i = 0u; i < D; ++i) {
+                PHt[r][i] = sign[i] * P[r][axes[i]];
+            }
+        }
+
+        // M = H * P * H^T + V
+        update_scalar_t M[D][D];
+        for (size_type i = 0u; i < D; ++i) {
+            for (size_type j = 0u; j < D; ++j) {
+                M[i][j] = sign[i] * PHt[axes[i]][j] + ((i == j) ? V[i] : 0.f);
+            }
+        }
 
         // Kalman gain matrix
-        const matrix_type<6, D> K = predicted_cov *
-                                    matrix_operator().transpose(H) *
-                                    matrix_operator().inverse(M);
+        update_scalar_t M_inv[D][D];
+        invert(M, M_inv);
+        update_scalar_t K[e_bound_size][D];
+        for (size_type r = 0u; r < e_bound_size; ++r) {
+            for (size_type j = 0u; j < D; ++j) {
+                K[r][j] = 0.f;
+                for (size_type k = 0u; k < D; ++k) {
+                    K[r][j] += PHt[r][k] * M_inv[k][j];
+                }
+            }
+        }
+
+        // Residual between measurement and (projected) predicted vector
+        update_scalar_t predicted_residual[D];
+        for (size_type i = 0u; i < D; ++i) {
+            predicted_residual[i] = meas_local[i] - sign[i] * x[axes[i]];
+        }
 
         // Calculate the filtered track parameters
-        const matrix_type<6, 1> filtered_vec =
-            predicted_vec + K * (meas_local - H * predicted_vec);
-        const matrix_type<6, 6> filtered_cov = (I66 - K * H) * predicted_cov;
+        matrix_type<e_bound_size, 1> filtered_vec;
+        update_scalar_t x_flt[e_bound_size];
+        for (size_type r = 0u; r < e_bound_size; ++r) {
+            x_flt[r] = x[r];
+            for (size_type i = 0u; i < D; ++i) {
+                x_flt[r] += K[r][i] * predicted_residual[i];
+            }
+            getter::element(filtered_vec, r, 0u) =
+                static_cast<scalar_type>(x_flt[r]);
+        }
+
+        // (I - K * H) * P = P - K * (P * H^T)^T, which is symmetric
+        matrix_type<e_bound_size, e_bound_size> filtered_cov;
+        for (size_type r = 0u; r < e_bound_size; ++r) {
+            for (size_type c = 0u; c <= r; ++c) {
+                update_scalar_t value = P[r][c];
+                for (size_type i = 0u; i < D; ++i) {
+                    value -= K[r][i] * PHt[c][i];
+                }
+                getter::element(filtered_cov, r, c) =
+                    static_cast<scalar_type>(value);
+                getter::element(filtered_cov, c, r) =
+                    static_cast<scalar_type>(value);
+            }
+        }
 
         // Residual between measurement and (projected) filtered vector
-        const matrix_type<D, 1> residual = meas_local - H * filtered_vec;
+        update_scalar_t residual[D];
+        for (size_type i = 0u; i < D; ++i) {
+            residual[i] = meas_local[i] - sign[i] * x_flt[axes[i]];
+        }
+
+        // R = (I - H * K) * V
+        update_scalar_t R[D][D];
+        for (size_type i = 0u; i < D; ++i) {
+            for (size_type j = 0u; j < D; ++j) {
+                R[i][j] = ((i == j) ? V[i] : 0.f) -
+                          sign[i] * K[axes[i]][j] * V[j];
+            }
+        }
 
         // Calculate the chi square
-        const matrix_type<D, D> R = (I_m - H * K) * V;
-        const matrix_type<1, 1> chi2 = matrix_operator().transpose(residual) *
-                                       matrix_operator().inverse(R) * residual;
+        update_scalar_t R_inv[D][D];
+        invert(R, R_inv);
+        update_scalar_t chi2 = 0.f;
+        for (size_type i = 0u; i < D; ++i) {
+            for (size_type j = 0u; j < D; ++j) {
+                chi2 += residual[i] * R_inv[i][j] * residual[j];
+            }
+        }
 
         // Set the stepper parameter
         bound_params.set_vector(filtered_vec);
@@ -129,10 +222,27 @@ struct gain_matrix_updater {
         // Set the track state parameters
         trk_state.filtered().set_vector(filtered_vec);
         trk_state.filtered().set_covariance(filtered_cov);
-        trk_state.filtered_chi2() = matrix_operator().element(chi2, 0, 0);
+        trk_state.filtered_chi2() = static_cast<scalar_type>(chi2);
 
         return;
     }
+
+    private:
+    /// Invert a 1x1 matrix
+    TRACCC_HOST_DEVICE static inline void invert(
+        const update_scalar_t (&m)[1][1], update_scalar_t (&inv)[1][1]) {
+        inv[0][0] = 1.f / m[0][0];
+    }
+
+    /// Invert a 2x2 matrix
+    TRACCC_HOST_DEVICE static inline void invert(
+        const update_scalar_t (&m)[2][2], update_scalar_t (&inv)[2][2]) {
+        const update_scalar_t det = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+        inv[0][0] = m[1][1] / det;
+        inv[0][1] = -m[0][1] / det;
+        inv[1][0] = -m[1][0] / det;
+        inv[1][1] = m[0][0] / det;
+    }
 };
 
 }  // namespace traccc
@@ -18,7 +18,10 @@
 namespace traccc {
 
 /// Detray actor for Kalman filtering
-template <typename algebra_t, template <typename...> class vector_t>
+///
+/// @tparam update_scalar_t the scalar type of the Kalman update
+template <typename algebra_t, template <typename...> class vector_t,
+          typename update_scalar_t = typename algebra_t::scalar_type>
 struct kalman_actor : detray::actor {
 
     // Type declarations
@@ -105,7 +108,8 @@ struct kalman_actor : detray::actor {
 
             // Run Kalman Gain Updater
             const auto sf = navigation.get_surface();
-            sf.template visit_mask<gain_matrix_updater<algebra_t>>(
+            sf.template visit_mask<
+                gain_matrix_updater<algebra_t, update_scalar_t>>(
                 trk_state, propagation._stepping._bound_params);
 
             // Update iterator
@@ -13,6 +13,7 @@
 #include "traccc/edm/track_parameters.hpp"
 #include "traccc/edm/track_state.hpp"
 #include "traccc/fitting/fitting_config.hpp"
+#include "traccc/fitting/kalman_filter/batched_gain_matrix_smoother.hpp"
 #include "traccc/fitting/kalman_filter/gain_matrix_smoother.hpp"
 #include "traccc/fitting/kalman_filter/kalman_actor.hpp"
 #include "traccc/fitting/kalman_filter/statistics_updater.hpp"
@@ -26,18 +27,30 @@
 #include "detray/propagator/propagator.hpp"
 
 // System include(s).
+#include <array>
+#include <cstddef>
 #include <limits>
 
 namespace traccc {
 
 /// Kalman fitter algorithm to fit a single track
-template <typename stepper_t, typename navigator_t>
+///
+/// The propagation, and the storage of the track states, use the scalar type
+/// of the stepper. The Kalman update and the smoothing can be done with a
+/// different (more precise) scalar type.
+///
+/// @tparam update_scalar_t the scalar type of the Kalman update and smoothing
+template <typename stepper_t, typename navigator_t,
+          typename update_scalar_t = typename stepper_t::scalar_type>
 class kalman_fitter {
 
     public:
     // scalar type
     using scalar_type = typename stepper_t::scalar_type;
 
+    // scalar type of the Kalman update and smoothing
+    using update_scalar_type = update_scalar_t;
+
     // vector type
     template <typename T>
     using vector_type = typename navigator_t::template vector_type<T>;
@@ -61,7 +74,8 @@ class kalman_fitter {
     using aborter = detray::pathlimit_aborter;
     using transporter = detray::parameter_transporter<transform3_type>;
     using interactor = detray::pointwise_material_interactor<transform3_type>;
-    using fit_actor = traccc::kalman_actor<transform3_type, vector_type>;
+    using fit_actor =
+        traccc::kalman_actor<transform3_type, vector_type, update_scalar_t>;
     using resetter = detray::parameter_resetter<transform3_type>;
 
     using actor_chain_type =
@@ -118,6 +132,9 @@ class kalman_fitter {
 
     /// Run the kalman fitter for a given number of iterations
     ///
+    /// The iterations stop early once the fit has converged, if a convergence
+    /// tolerance is configured.
+    ///
     /// @tparam seed_parameters_t the type of seed track parameter
     ///
     /// @param seed_params seed track parameter
@@ -127,6 +144,9 @@ class kalman_fitter {
         const seed_parameters_t& seed_params, state& fitter_state,
         vector_type<intersection_type>&& nav_candidates = {}) {
 
+        // Fit result of the previous iteration
+        fitter_info<transform3_type> previous_fit_info;
+
         // Run the kalman filtering for a given number of iterations
         for (std::size_t i = 0; i < m_cfg.n_iterations; i++) {
 
@@ -145,6 +165,120 @@ class kalman_fitter {
                 filter(new_seed_params, fitter_state,
                        std::move(nav_candidates));
             }
+
+            // Stop iterating once the fit has converged
+            if (!has_convergence_check()) {
+                continue;
+            }
+            if (i > 0 && is_converged(previous_fit_info,
+                                      fitter_state.m_fit_info)) {
+                break;
+            }
+            previous_fit_info = fitter_state.m_fit_info;
+        }
+    }
+
+    /// Run the kalman fitter on a batch of tracks
+    ///
+    /// The forward filtering is done track-by-track, while the smoothing of
+    /// the tracks runs in lock-step, with one SIMD lane per track. Tracks
+    /// whose fit has converged are removed from the batch for the remaining
+    /// iterations.
+    ///
+    /// @tparam N the number of tracks (lanes) in the batch
+    ///
+    /// @param seed_params seed track parameters, @c nullptr for unused lanes
+    /// @param fitter_states the states of kalman fitter, @c nullptr for
+    ///                      unused lanes
+    template <std::size_t N>
+    TRACCC_HOST void fit(
+        const std::array<const bound_track_parameters*, N>& seed_params,
+        const std::array<state*, N>& fitter_states) {
+
+        // Tracks still being fitted, and their fit results of the previous
+        // iteration
+        std::array<state*, N> active = fitter_states;
+        std::array<fitter_info<transform3_type>, N> previous_fit_info;
+
+        // Run the kalman filtering for a given number of iterations
+        for (std::size_t i = 0; i < m_cfg.n_iterations; i++) {
+
+            for (std::size_t l = 0; l < N; ++l) {
+                if (active[l] == nullptr) {
+                    continue;
+                }
+                auto& fitter_state = *(active[l]);
+
+                // Reset the iterator of kalman actor
+                fitter_state.m_fit_actor_state.reset();
+
+                // From the second iteration, seed parameter is the smoothed
+                // track parameter at the first surface
+                const bound_track_parameters seed =
+                    (i == 0) ? *(seed_params[l])
+                             : fitter_state.m_fit_actor_state.m_track_states[0]
+                                   .smoothed();
+
+                forward_filter(seed, fitter_state);
+            }
+
+            // Run smoothing and update track fitting qualities
+            smooth(active);
+
+            // Remove the tracks whose fit has converged
+            if (!has_convergence_check()) {
+                continue;
+            }
+            bool all_converged = true;
+            for (std::size_t l = 0; l < N; ++l) {
+                if (active[l] == nullptr) {
+                    continue;
+                }
+                if (i > 0 && is_converged(previous_fit_info[l],
+                                          active[l]->m_fit_info)) {
+                    active[l] = nullptr;
+                    continue;
+                }
+                previous_fit_info[l] = active[l]->m_fit_info;
+                all_converged = false;
+            }
+            if (all_converged) {
+                break;
+            }
+        }
+    }
+
+    /// Run the smoothing of a batch of tracks, whose track states were
+    /// already filtered, and update their fitting qualities
+    ///
+    /// This is all that is left to do for tracks whose track states were
+    /// filtered by the track finding.
+    ///
+    /// @tparam N the number of tracks (lanes) in the batch
+    ///
+    /// @param fitter_states the states of kalman fitter, @c nullptr for
+    ///                      unused lanes
+    template <std::size_t N>
+    TRACCC_HOST void smooth(const std::array<state*, N>& fitter_states) {
+
+        std::array<vector_type<track_state<transform3_type>>*, N> lanes{};
+        for (std::size_t l = 0; l < N; ++l) {
+            if (fitter_states[l] != nullptr) {
+                lanes[l] =
+                    &(fitter_states[l]->m_fit_actor_state.m_track_states);
+            }
+        }
+
+        // Run smoothing
+        batched_gain_matrix_smoother<transform3_type, N, update_scalar_t>{}(
+            lanes);
+
+        for (std::size_t l = 0; l < N; ++l) {
+            if (fitter_states[l] == nullptr) {
+                continue;
+            }
+            update_smoothed_chi2(*(fitter_states[l]));
+            update_statistics(*(fitter_states[l]));
         }
     }
 
@@ -159,6 +293,27 @@ class kalman_fitter {
         const seed_parameters_t& seed_params, state& fitter_state,
         vector_type<intersection_type>&& nav_candidates = {}) {
 
+        // Run forward filtering
+        forward_filter(seed_params, fitter_state, std::move(nav_candidates));
+
+        // Run smoothing
+        smooth(fitter_state);
+
+        // Update track fitting qualities
+        update_statistics(fitter_state);
+    }
+
+    /// Run the forward filtering of an iteration
+    ///
+    /// @tparam seed_parameters_t the type of seed track parameter
+    ///
+    /// @param seed_params seed track parameter
+    /// @param fitter_state the state of kalman fitter
+    template <typename seed_parameters_t>
+    TRACCC_HOST_DEVICE void forward_filter(
+        const seed_parameters_t& seed_params, state& fitter_state,
+        vector_type<intersection_type>&& nav_candidates = {}) {
+
         // Create propagator
         propagator_type propagator({}, {});
 
@@ -183,12 +338,6 @@ class kalman_fitter {
 
         // Run forward filtering
         propagator.propagate(propagation, fitter_state());
-
-        // Run smoothing
-        smooth(fitter_state);
-
-        // Update track fitting qualities
-        update_statistics(fitter_state);
     }
 
     /// Run smoothing after kalman filtering
@@ -221,16 +370,45 @@ class kalman_fitter {
             // Run kalman smoother
             const detray::surface<detector_type> sf{m_detector,
                                                     it->surface_link()};
-            sf.template visit_mask<gain_matrix_smoother<transform3_type>>(
+            sf.template visit_mask<
+                gain_matrix_smoother<transform3_type, update_scalar_t>>(
                 *it, *(it - 1));
         }
     }
 
+    /// Calculate the smoothed chi-square of the track states, whose smoothed
+    /// parameters were already set
+    ///
+    /// @param fitter_state the state of kalman fitter
+    TRACCC_HOST_DEVICE
+    void update_smoothed_chi2(state& fitter_state) {
+        auto& track_states = fitter_state.m_fit_actor_state.m_track_states;
+
+        auto& last = track_states.back();
+        last.smoothed_chi2() = last.filtered_chi2();
+
+        for (typename vector_type<
+                 track_state<transform3_type>>::reverse_iterator it =
+                 track_states.rbegin() + 1;
+             it != track_states.rend(); ++it) {
+
+            const detray::surface<detector_type> sf{m_detector,
+                                                    it->surface_link()};
+            sf.template visit_mask<
+                gain_matrix_smoother<transform3_type, update_scalar_t>>(
+                *it);
+        }
+    }
+
     TRACCC_HOST_DEVICE
     void update_statistics(state& fitter_state) {
         auto& fit_info = fitter_state.m_fit_info;
         auto& track_states = fitter_state.m_fit_actor_state.m_track_states;
 
+        // Start from scratch in every iteration
+        fit_info.ndf = 0.f;
+        fit_info.chi2 = 0.f;
+
         // Fit parameter = smoothed track parameter at the first surface
         fit_info.fit_params = track_states[0].smoothed();
 
@@ -246,6 +424,50 @@ class kalman_fitter {
         fit_info.ndf = fit_info.ndf - 5.f;
     }
 
+    /// @return whether any convergence tolerance is configured
+    TRACCC_HOST_DEVICE
+    bool has_convergence_check() const {
+        return (m_cfg.parameter_tolerance > 0.f) ||
+               (m_cfg.chi2_tolerance > 0.f);
+    }
+
+    /// Check whether the fit of a track has converged
+    ///
+    /// @param previous the fit result of the previous iteration
+    /// @param current the fit result of the current iteration
+    /// @return true if the chi-square, or the smoothed parameters at the
+    ///         first surface, changed by less than the configured tolerance
+    TRACCC_HOST_DEVICE
+    bool is_converged(const fitter_info<transform3_type>& previous,
+                      const fitter_info<transform3_type>& current) const {
+
+        // Change of the chi-square
+        const scalar_type d_chi2 = current.chi2 - previous.chi2;
+        if (m_cfg.chi2_tolerance > 0.f &&
+            d_chi2 * d_chi2 < m_cfg.chi2_tolerance * m_cfg.chi2_tolerance) {
+            return true;
+        }
+
+        // Change of the parameters, in units of their uncertainty
+        if (m_cfg.parameter_tolerance > 0.f) {
+            const auto& prev_vec = previous.fit_params.vector();
+            const auto& cur_vec = current.fit_params.vector();
+            const auto& cur_cov = current.fit_params.covariance();
+            const scalar_type tol2 =
+                m_cfg.parameter_tolerance * m_cfg.parameter_tolerance;
+            for (unsigned int i = 0; i < e_bound_size; ++i) {
+                const scalar_type diff = getter::element(cur_vec, i, 0u) -
+                                         getter::element(prev_vec, i, 0u);
+                if (diff * diff > tol2 * getter::element(cur_cov, i, i)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        return false;
+    }
+
     private:
     // Detector object
     const detector_type& m_detector;
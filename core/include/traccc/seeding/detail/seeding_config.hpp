@@ -220,6 +220,10 @@ struct seedfilter_config {
     // seed cut
     scalar seed_min_weight = 200;
     scalar spB_min_radius = 43. * unit<scalar>::mm;
+
+    // remove the seeds sharing two spacepoints with a higher weight seed,
+    // before the track parameter estimation (see seed_deduplication)
+    bool deduplicate_seeds = false;
 };
 
 }  // namespace traccc
@@ -0,0 +1,53 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Library include(s).
+#include "traccc/edm/seed.hpp"
+#include "traccc/utils/algorithm.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/memory_resource.hpp>
+
+// System include(s).
+#include <functional>
+
+namespace traccc {
+
+/// Seed overlap reduction algorithm
+///
+/// Seeds sharing two of their three spacepoints mostly describe the same
+/// particle, and would start duplicate branches in the track finding. The
+/// algorithm visits the seeds in decreasing order of their weight, and drops
+/// every seed that shares two spacepoints with an already accepted seed. The
+/// accepted seeds keep their original relative order.
+///
+class seed_deduplication : public algorithm<seed_collection_types::host(
+                               const seed_collection_types::host&)> {
+
+    public:
+    /// Constructor for seed_deduplication
+    ///
+    /// @param mr is the memory resource
+    seed_deduplication(vecmem::memory_resource& mr);
+
+    /// Callable operator for seed_deduplication
+    ///
+    /// @param seeds The reconstructed track seeds of the event
+    /// @return The seeds that do not overlap with a higher weight seed
+    ///
+    output_type operator()(
+        const seed_collection_types::host& seeds) const override;
+
+    private:
+    /// The memory resource to use in the algorithm
+    std::reference_wrapper<vecmem::memory_resource> m_mr;
+
+};  // class seed_deduplication
+
+}  // namespace traccc
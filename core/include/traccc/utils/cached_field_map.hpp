@@ -0,0 +1,255 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Project include(s).
+#include "traccc/definitions/primitives.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace traccc {
+
+/// Magnetic field map on a regular 3D grid, caching the current grid cell
+///
+/// The field is stored at the nodes of a regular grid, and is evaluated with
+/// a trilinear interpolation between the 8 corners of the cell that a point
+/// is in. Points outside of the grid are clamped onto its boundary.
+///
+/// The map itself only owns the field values. It is used through its
+/// @c view_t type, which is the one to use as the magnetic field type of the
+/// (host) stepper. Every view remembers the corners of the last cell that it
+/// evaluated the field in, so successive steps of a propagation within the
+/// same cell do not read the field values of the map again. Since the
+/// propagation state holds its own copy of the field view, every track gets
+/// its own cache.
+///
+/// The views count the field lookups and the cell loads that they perform,
+/// and add them to the (thread-safe) counters of the map when they are
+/// destroyed.
+///
+class cached_field_map {
+
+    public:
+    /// Scalar type of the field map
+    using scalar_type = traccc::scalar;
+    /// Type of a 3D position / field vector
+    using vector_type = std::array<scalar_type, 3>;
+    /// Type of the grid sizes
+    using size_type = std::size_t;
+
+    /// Field view to use in the stepper
+    class view_t {
+
+        public:
+        /// Output type of a field lookup
+        using output_t = vector_type;
+
+        /// Construct a view of a field map
+        view_t(const cached_field_map& field) : m_field(&field) {}
+
+        /// Copy constructor, starting with an empty cache and no counts
+        view_t(const view_t& parent) : m_field(parent.m_field) {}
+
+        /// Assignment, starting with an empty cache and no counts
+        view_t& operator=(const view_t& rhs) {
+            if (this != &rhs) {
+                flush();
+                m_field = rhs.m_field;
+                m_cell = invalid_cell;
+            }
+            return *this;
+        }
+
+        /// Destructor, adding the counts of the view to the map
+        ~view_t() { flush(); }
+
+        /// Evaluate the field at a given point
+        output_t at(scalar_type x, scalar_type y, scalar_type z) const {
+
+            ++m_n_lookups;
+
+            // Find the cell of the point, and its position inside of it
+            std::array<size_type, 3> bin;
+            std::array<scalar_type, 3> frac;
+            const std::array<scalar_type, 3> pos{x, y, z};
+            for (unsigned int i = 0; i < 3; ++i) {
+                const scalar_type u = std::clamp(
+                    (pos[i] - m_field->m_min[i]) * m_field->m_inv_step[i],
+                    scalar_type(0.f),
+                    static_cast<scalar_type>(m_field->m_n_bins[i] - 1));
+                bin[i] = std::min(static_cast<size_type>(u),
+                                  m_field->m_n_bins[i] - 2);
+                frac[i] = u - static_cast<scalar_type>(bin[i]);
+            }
+
+            // Only read the corners of the cell if it changed
+            const size_type cell = m_field->node_index(bin[0], bin[1], bin[2]);
+            if (cell != m_cell) {
+                load_cell(bin);
+                m_cell = cell;
+            }
+
+            // Trilinear interpolation between the corners
+            output_t result{0.f, 0.f, 0.f};
+            for (unsigned int c = 0; c < 8; ++c) {
+                const scalar_type w = ((c & 1u) ? frac[0] : 1.f - frac[0]) *
+                                      ((c & 2u) ? frac[1] : 1.f - frac[1]) *
+                                      ((c & 4u) ? frac[2] : 1.f - frac[2]);
+                for (unsigned int i = 0; i < 3; ++i) {
+                    result[i] += w * m_corners[c][i];
+                }
+            }
+            return result;
+        }
+
+        /// Number of field lookups done through this view so far
+        std::size_t n_lookups() const { return m_n_lookups; }
+        /// Number of cells loaded from the map by this view so far
+        std::size_t n_cell_loads() const { return m_n_cell_loads; }
+
+        private:
+        /// Marker of an empty cache
+        static constexpr size_type invalid_cell =
+            std::numeric_limits<size_type>::max();
+
+        /// Read the field values on the corners of a cell
+        void load_cell(const std::array<size_type, 3>& bin) const {
+            ++m_n_cell_loads;
+            for (unsigned int c = 0; c < 8; ++c) {
+                m_corners[c] = m_field->m_values[m_field->node_index(
+                    bin[0] + (c & 1u), bin[1] + ((c >> 1) & 1u),
+                    bin[2] + ((c >> 2) & 1u))];
+            }
+        }
+
+        /// Add the counts of the view to the map, and reset them
+        void flush() {
+            if (m_n_lookups > 0) {
+                m_field->m_n_lookups.fetch_add(m_n_lookups,
+                                               std::memory_order_relaxed);
+                m_field->m_n_cell_loads.fetch_add(m_n_cell_loads,
+                                                  std::memory_order_relaxed);
+            }
+            m_n_lookups = 0;
+            m_n_cell_loads = 0;
+        }
+
+        /// The field map being viewed
+        const cached_field_map* m_field;
+        /// Index of the cached cell
+        mutable size_type m_cell = invalid_cell;
+        /// Field values on the corners of the cached cell
+        mutable std::array<vector_type, 8> m_corners;
+        /// Number of field lookups not yet added to the map
+        mutable std::size_t m_n_lookups = 0;
+        /// Number of cell loads not yet added to the map
+        mutable std::size_t m_n_cell_loads = 0;
+    };
+
+    /// Construct the map by sampling another magnetic field
+    ///
+    /// @param field   The field (view) to sample, with an
+    ///                @c at(x,y,z) function
+    /// @param min     Position of the first grid node
+    /// @param max     Position of the last grid node
+    /// @param n_bins  Number of grid nodes along every axis (at least 2)
+    ///
+    /// @throws std::invalid_argument if an axis has less than 2 nodes, since
+    ///         the interpolation needs a cell on every axis, or if @c max is
+    ///         not above @c min on an axis
+    ///
+    template <typename field_view_t>
+    cached_field_map(const field_view_t& field, const vector_type& min,
+                     const vector_type& max,
+                     const std::array<size_type, 3>& n_bins)
+        : m_min(min), m_n_bins(n_bins) {
+
+        for (unsigned int i = 0; i < 3; ++i) {
+            if (n_bins[i] < 2) {
+                throw std::invalid_argument(
+                    "The cached field map needs at least 2 grid nodes along "
+                    "every axis");
+            }
+            if (!(max[i] > min[i])) {
+                throw std::invalid_argument(
+                    "The cached field map needs max > min along every axis");
+            }
+            m_step[i] = (max[i] - min[i]) /
+                        static_cast<scalar_type>(n_bins[i] - 1);
+            m_inv_step[i] = 1.f / m_step[i];
+        }
+
+        m_values.resize(n_bins[0] * n_bins[1] * n_bins[2]);
+        for (size_type ix = 0; ix < n_bins[0]; ++ix) {
+            for (size_type iy = 0; iy < n_bins[1]; ++iy) {
+                for (size_type iz = 0; iz < n_bins[2]; ++iz) {
+                    const auto b = field.at(node_position(0, ix),
+                                            node_position(1, iy),
+                                            node_position(2, iz));
+                    m_values[node_index(ix, iy, iz)] = {
+                        static_cast<scalar_type>(b[0]),
+                        static_cast<scalar_type>(b[1]),
+                        static_cast<scalar_type>(b[2])};
+                }
+            }
+        }
+    }
+
+    /// The map can not be copied, as its views point at it
+    cached_field_map(const cached_field_map&) = delete;
+    cached_field_map& operator=(const cached_field_map&) = delete;
+
+    /// Total number of field lookups of all destroyed views
+    std::size_t n_lookups() const {
+        return m_n_lookups.load(std::memory_order_relaxed);
+    }
+    /// Total number of cell loads of all destroyed views
+    std::size_t n_cell_loads() const {
+        return m_n_cell_loads.load(std::memory_order_relaxed);
+    }
+    /// Reset the lookup counters
+    void reset_counters() {
+        m_n_lookups.store(0, std::memory_order_relaxed);
+        m_n_cell_loads.store(0, std::memory_order_relaxed);
+    }
+
+    private:
+    /// Position of a grid node along one axis
+    scalar_type node_position(unsigned int axis, size_type i) const {
+        return m_min[axis] + static_cast<scalar_type>(i) * m_step[axis];
+    }
+
+    /// Index of a grid node in the value array
+    size_type node_index(size_type ix, size_type iy, size_type iz) const {
+        return (ix * m_n_bins[1] + iy) * m_n_bins[2] + iz;
+    }
+
+    /// Position of the first grid node
+    vector_type m_min;
+    /// Distance of the grid nodes, and its inverse
+    vector_type m_step, m_inv_step;
+    /// Number of grid nodes along every axis
+    std::array<size_type, 3> m_n_bins;
+    /// Field values on the grid nodes
+    std::vector<vector_type> m_values;
+
+    /// Number of field lookups of all destroyed views
+    mutable std::atomic<std::size_t> m_n_lookups{0};
+    /// Number of cell loads of all destroyed views
+    mutable std::atomic<std::size_t> m_n_cell_loads{0};
+};
+
+}  // namespace traccc
@@ -0,0 +1,159 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// VecMem include(s).
+#include <vecmem/memory/memory_resource.hpp>
+
+// System include(s).
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace traccc {
+
+/// Statistics of memory allocations, per tag
+struct memory_profile {
+
+    /// Statistics of the allocations made with one tag
+    struct tag_stats {
+        /// Number of allocations
+        std::size_t allocations = 0;
+        /// Number of deallocations
+        std::size_t deallocations = 0;
+        /// Total number of bytes allocated
+        std::size_t allocated_bytes = 0;
+        /// Number of bytes currently allocated
+        std::size_t live_bytes = 0;
+        /// Peak number of bytes allocated at the same time
+        std::size_t peak_bytes = 0;
+    };
+
+    /// Statistics of the individual tags, in the order of their first use
+    std::vector<std::pair<std::string, tag_stats>> tags;
+    /// Statistics of all tags together
+    tag_stats total;
+
+    /// Add the statistics of another profile (e.g. of another thread)
+    ///
+    /// The peaks are summed up, so the result is an upper limit of the peak
+    /// of the combined allocations.
+    ///
+    memory_profile& operator+=(const memory_profile& other);
+
+};  // struct memory_profile
+
+/// Print a memory profile as a table
+std::ostream& operator<<(std::ostream& out, const memory_profile& profile);
+
+/// Memory resource recording the allocations made through it, per tag
+///
+/// Every allocation is attributed to the tag that is active in the calling
+/// thread at the time of the allocation, which is set with the RAII
+/// @c instrumented_memory_resource::scope type. For every tag the number of
+/// allocations and deallocations, the number of allocated bytes, and the
+/// current and peak number of live bytes are recorded. Deallocations are
+/// attributed to the tag that made the allocation.
+///
+/// The resource is thread-safe. It serialises all allocations and
+/// deallocations, including the calls to the upstream resource, through a
+/// mutex. So it can be put in front of a resource that is not thread-safe
+/// itself, but it is only meant for profiling the memory use of algorithms.
+///
+/// Since the active tag is set per thread, allocations made by other threads
+/// on behalf of a tagged scope, like the TBB worker threads running the
+/// nested parallel loops of an algorithm, are attributed to the tag active
+/// in those threads instead. (Usually @c untagged.)
+///
+class instrumented_memory_resource : public vecmem::memory_resource {
+
+    public:
+    /// Statistics of the allocations made with one tag
+    using tag_stats = memory_profile::tag_stats;
+
+    /// Set the active tag of the calling thread until the end of the scope
+    class scope {
+
+        public:
+        /// Activate a tag
+        ///
+        /// @param tag The tag to activate, which must outlive the scope
+        ///
+        explicit scope(std::string_view tag);
+        /// Re-activate the previous tag
+        ~scope();
+
+        /// The scope can not be copied
+        scope(const scope&) = delete;
+        scope& operator=(const scope&) = delete;
+
+        private:
+        /// The tag that was active before this scope
+        std::string_view m_previous;
+    };
+
+    /// Tag of the allocations made outside of any scope
+    static constexpr std::string_view untagged = "Untagged";
+
+    /// The currently active tag of the calling thread
+    static std::string_view current_tag();
+
+    /// Constructor with an upstream memory resource
+    ///
+    /// @param upstream The memory resource to forward the allocations to
+    ///
+    explicit instrumented_memory_resource(vecmem::memory_resource& upstream);
+
+    /// The resource can not be copied
+    instrumented_memory_resource(const instrumented_memory_resource&) =
+        delete;
+    instrumented_memory_resource& operator=(
+        const instrumented_memory_resource&) = delete;
+
+    /// Statistics of the allocations made through the resource so far
+    memory_profile profile() const;
+
+    /// Reset the allocation counters of all tags
+    ///
+    /// The number of live bytes is kept, and the peaks are lowered to it.
+    ///
+    void reset_counters();
+
+    private:
+    /// @name Function(s) implementing @c vecmem::memory_resource
+    /// @{
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* ptr, std::size_t bytes,
+                       std::size_t alignment) override;
+    bool do_is_equal(
+        const vecmem::memory_resource& other) const noexcept override;
+    /// @}
+
+    /// The upstream memory resource
+    std::reference_wrapper<vecmem::memory_resource> m_upstream;
+    /// Mutex protecting all of the statistics
+    mutable std::mutex m_mutex;
+    /// Statistics of the individual tags
+    std::map<std::string, tag_stats, std::less<>> m_tags;
+    /// Names of the tags, in the order of their first use
+    std::vector<std::string_view> m_tag_order;
+    /// Tag of each live allocation
+    std::unordered_map<void*, tag_stats*> m_live;
+    /// Statistics of all tags together
+    tag_stats m_total;
+
+};  // class instrumented_memory_resource
+
+}  // namespace traccc
@@ -0,0 +1,93 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// VecMem include(s).
+#include <vecmem/memory/memory_resource.hpp>
+
+// System include(s).
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace traccc {
+
+/// Monotonic ("arena") memory resource for per-event scratch memory
+///
+/// Allocations are served by bumping a pointer through large blocks taken
+/// from an upstream resource, and deallocations are no-ops. Calling
+/// @c reset() makes all of the memory available again without returning it
+/// to the upstream resource, so an algorithm that resets the arena at the
+/// start of every event stops allocating from the upstream resource once the
+/// arena has grown to the size needed by its largest event.
+///
+/// The resource is not thread-safe. Algorithms that may be called
+/// concurrently take their arenas from a @c monotonic_memory_resource_pool.
+///
+class monotonic_memory_resource : public vecmem::memory_resource {
+
+    public:
+    /// Constructor with an upstream memory resource
+    ///
+    /// @param upstream    The memory resource to take the blocks from
+    /// @param block_size  Size of the first block, in bytes
+    ///
+    explicit monotonic_memory_resource(vecmem::memory_resource& upstream,
+                                       std::size_t block_size = 1024 * 1024);
+
+    /// Destructor, returning all blocks to the upstream resource
+    ~monotonic_memory_resource() override;
+
+    /// The resource can not be copied
+    monotonic_memory_resource(const monotonic_memory_resource&) = delete;
+    monotonic_memory_resource& operator=(const monotonic_memory_resource&) =
+        delete;
+
+    /// Make all of the memory of the arena available again
+    ///
+    /// All memory handed out by the resource earlier becomes invalid. If the
+    /// arena had to grow since the last reset, its blocks are merged into a
+    /// single one.
+    ///
+    void reset();
+
+    private:
+    /// @name Function(s) implementing @c vecmem::memory_resource
+    /// @{
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* ptr, std::size_t bytes,
+                       std::size_t alignment) override;
+    bool do_is_equal(
+        const vecmem::memory_resource& other) const noexcept override;
+    /// @}
+
+    /// Allocate a new block from the upstream resource
+    void allocate_block(std::size_t size);
+    /// Return all blocks to the upstream resource
+    void release_blocks();
+
+    /// A block of memory taken from the upstream resource
+    struct block {
+        void* ptr;
+        std::size_t size;
+    };
+
+    /// The upstream memory resource
+    std::reference_wrapper<vecmem::memory_resource> m_upstream;
+    /// All blocks of the arena
+    std::vector<block> m_blocks;
+    /// Index of the block currently being filled
+    std::size_t m_current = 0;
+    /// Number of bytes used in the current block
+    std::size_t m_offset = 0;
+    /// Size of the next block to allocate
+    std::size_t m_next_block_size;
+
+};  // class monotonic_memory_resource
+
+}  // namespace traccc
@@ -0,0 +1,93 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Library include(s).
+#include "traccc/utils/monotonic_memory_resource.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/memory_resource.hpp>
+
+// System include(s).
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace traccc {
+
+/// Pool of monotonic memory resources, for algorithms called concurrently
+///
+/// Every call of an algorithm takes an arena from the pool for its scratch
+/// memory, and gives it back at its end. Concurrent (and nested) calls get
+/// different arenas, so the pool holds as many arenas as there were calls
+/// running at the same time at most.
+///
+class monotonic_memory_resource_pool {
+
+    public:
+    /// An arena taken from the pool, given back to it when destroyed
+    class lease {
+
+        public:
+        /// Constructor with the pool and the arena
+        lease(monotonic_memory_resource_pool& pool,
+              std::unique_ptr<monotonic_memory_resource> arena);
+        /// Destructor, giving the arena back to the pool
+        ~lease();
+
+        /// The lease can be moved, but not copied
+        lease(lease&&) = default;
+        lease& operator=(lease&&) = delete;
+        lease(const lease&) = delete;
+        lease& operator=(const lease&) = delete;
+
+        /// Access the arena
+        monotonic_memory_resource& operator*() const { return *m_arena; }
+
+        private:
+        /// The pool that the arena belongs to
+        std::reference_wrapper<monotonic_memory_resource_pool> m_pool;
+        /// The arena
+        std::unique_ptr<monotonic_memory_resource> m_arena;
+
+    };  // class lease
+
+    /// Constructor with an upstream memory resource
+    ///
+    /// @param upstream    The memory resource of the blocks of the arenas
+    /// @param block_size  Size of the first block of every arena, in bytes
+    ///
+    explicit monotonic_memory_resource_pool(
+        vecmem::memory_resource& upstream,
+        std::size_t block_size = 1024 * 1024);
+
+    /// Take an arena from the pool, creating a new one if all are in use
+    ///
+    /// The arena is reset, so all of its memory is available. This function
+    /// is thread-safe.
+    ///
+    lease acquire();
+
+    private:
+    /// Give an arena back to the pool
+    void release(std::unique_ptr<monotonic_memory_resource> arena);
+
+    /// The upstream memory resource of the arenas
+    std::reference_wrapper<vecmem::memory_resource> m_upstream;
+    /// Size of the first block of new arenas
+    std::size_t m_block_size;
+    /// Mutex protecting the arenas not in use
+    std::mutex m_mutex;
+    /// Arenas not in use
+    std::vector<std::unique_ptr<monotonic_memory_resource>> m_free;
+
+};  // class monotonic_memory_resource_pool
+
+}  // namespace traccc
@@ -0,0 +1,317 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Library include(s).
+#include "traccc/ambiguity_resolution/greedy_ambiguity_resolution_algorithm.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <set>
+#include <vector>
+
+namespace traccc {
+
+namespace {
+
+/// Strict ordering of the measurements of the track candidates
+///
+/// The track candidates hold copies of the measurements of the event, so
+/// the same measurement is identical on all tracks that it was assigned to.
+///
+bool measurement_less(const measurement& lhs, const measurement& rhs) {
+
+    if (lhs.surface_link != rhs.surface_link) {
+        return lhs.surface_link < rhs.surface_link;
+    } else if (lhs.local[0] != rhs.local[0]) {
+        return lhs.local[0] < rhs.local[0];
+    } else {
+        return lhs.local[1] < rhs.local[1];
+    }
+}
+
+}  // namespace
+
+greedy_ambiguity_resolution_algorithm::greedy_ambiguity_resolution_algorithm(
+    const config_type& cfg, vecmem::memory_resource& mr)
+    : m_cfg(cfg), m_mr(mr) {}
+
+greedy_ambiguity_resolution_algorithm::output_type
+greedy_ambiguity_resolution_algorithm::operator()(
+    const track_candidate_container_types::host& track_candidates) const {
+
+    const std::vector<unsigned int> survivors =
+        surviving_tracks(track_candidates);
+
+    output_type result(&m_mr.get());
+    result.resize(survivors.size());
+    for (std::size_t i = 0; i < survivors.size(); i++) {
+        result[i].header = track_candidates[survivors[i]].header;
+        result[i].items = track_candidates[survivors[i]].items;
+    }
+    return result;
+}
+
+std::vector<unsigned int>
+greedy_ambiguity_resolution_algorithm::surviving_tracks(
+    const track_candidate_container_types::host& track_candidates) const {
+
+    const unsigned int n_tracks =
+        static_cast<unsigned int>(track_candidates.size());
+
+    /*****************************************************************
+     * Index the measurements of all tracks
+     *****************************************************************/
+
+    // Flat list of the (track, measurement) entries, in track order
+    std::vector<unsigned int> track_offsets(n_tracks + 1, 0u);
+    for (unsigned int i = 0; i < n_tracks; i++) {
+        track_offsets[i + 1] =
+            track_offsets[i] +
+            static_cast<unsigned int>(track_candidates[i].items.size());
+    }
+    const unsigned int n_entries = track_offsets[n_tracks];
+
+    std::vector<const measurement*> entry_meas(n_entries);
+    for (unsigned int i = 0; i < n_tracks; i++) {
+        const auto& cands = track_candidates[i].items;
+        for (unsigned int j = 0; j < cands.size(); j++) {
+            entry_meas[track_offsets[i] + j] = &cands[j];
+        }
+    }
+
+    // Give the same index to the same measurement on different tracks
+    std::vector<unsigned int> order(n_entries);
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(),
+              [&entry_meas](unsigned int lhs, unsigned int rhs) {
+                  return measurement_less(*entry_meas[lhs], *entry_meas[rhs]);
+              });
+
+    std::vector<unsigned int> entry_meas_id(n_entries);
+    unsigned int meas_id = 0;
+    for (unsigned int k = 0; k < n_entries; k++) {
+        if (k > 0 && measurement_less(*entry_meas[order[k - 1]],
+                                      *entry_meas[order[k]])) {
+            ++meas_id;
+        }
+        entry_meas_id[order[k]] = meas_id;
+    }
+    const unsigned int n_meas = (n_entries > 0) ? meas_id + 1 : 0u;
+
+    /*****************************************************************
+     * Build the measurement -> track incidence table
+     *****************************************************************/
+
+    // Apply the (optional) minimum length cut. Tracks that are too short are
+    // not considered at all, and are not part of the output.
+    std::vector<char> accepted(n_tracks, 0);
+    for (unsigned int i = 0; i < n_tracks; i++) {
+        accepted[i] = (track_offsets[i + 1] - track_offsets[i] >=
+                       m_cfg.n_measurements_min);
+    }
+
+    std::vector<unsigned int> meas_offsets(n_meas + 1, 0u);
+    for (unsigned int i = 0; i < n_tracks; i++) {
+        if (!accepted[i]) {
+            continue;
+        }
+        for (unsigned int e = track_offsets[i]; e < track_offsets[i + 1];
+             e++) {
+            ++meas_offsets[entry_meas_id[e] + 1];
+        }
+    }
+
+    // Number of surviving tracks per measurement
+    std::vector<unsigned int> meas_n_tracks(meas_offsets.begin() + 1,
+                                            meas_offsets.end());
+    std::partial_sum(meas_offsets.begin(), meas_offsets.end(),
+                     meas_offsets.begin());
+
+    std::vector<unsigned int> meas_tracks(meas_offsets[n_meas]);
+    std::vector<unsigned int> fill(meas_offsets.begin(),
+                                   meas_offsets.end() - 1);
+    for (unsigned int i = 0; i < n_tracks; i++) {
+        if (!accepted[i]) {
+            continue;
+        }
+        for (unsigned int e = track_offsets[i]; e < track_offsets[i + 1];
+             e++) {
+            meas_tracks[fill[entry_meas_id[e]]++] = i;
+        }
+    }
+
+    /*****************************************************************
+     * Count the shared measurements of every track
+     *****************************************************************/
+
+    std::vector<unsigned int> n_shared(n_tracks, 0u);
+    unsigned int max_n_meas = 0;
+    for (unsigned int i = 0; i < n_tracks; i++) {
+        if (!accepted[i]) {
+            continue;
+        }
+        for (unsigned int e = track_offsets[i]; e < track_offsets[i + 1];
+             e++) {
+            n_shared[i] += (meas_n_tracks[entry_meas_id[e]] > 1);
+        }
+        max_n_meas = std::max(max_n_meas, track_offsets[i + 1] -
+                                              track_offsets[i]);
+    }
+
+    // Number of surviving tracks for every number of shared measurements.
+    // The shared counts never grow, so the largest one is followed downwards.
+    std::vector<unsigned int> n_tracks_per_shared(max_n_meas + 1, 0u);
+    unsigned int max_shared = 0;
+    for (unsigned int i = 0; i < n_tracks; i++) {
+        if (accepted[i]) {
+            ++n_tracks_per_shared[n_shared[i]];
+            max_shared = std::max(max_shared, n_shared[i]);
+        }
+    }
+
+    // Rank the tracks by their relative number of shared measurements. Among
+    // equally shared tracks the shorter (and then the later) one goes first.
+    auto more_ambiguous = [&n_shared, &track_offsets](unsigned int lhs,
+                                                      unsigned int rhs) {
+        const unsigned int lhs_size =
+            track_offsets[lhs + 1] - track_offsets[lhs];
+        const unsigned int rhs_size =
+            track_offsets[rhs + 1] - track_offsets[rhs];
+        const unsigned long lhs_rel =
+            static_cast<unsigned long>(n_shared[lhs]) * rhs_size;
+        const unsigned long rhs_rel =
+            static_cast<unsigned long>(n_shared[rhs]) * lhs_size;
+        if (lhs_rel != rhs_rel) {
+            return lhs_rel > rhs_rel;
+        } else if (lhs_size != rhs_size) {
+            return lhs_size < rhs_size;
+        }
+        return lhs > rhs;
+    };
+    std::set<unsigned int, decltype(more_ambiguous)> ranking(more_ambiguous);
+    for (unsigned int i = 0; i < n_tracks; i++) {
+        if (accepted[i]) {
+            ranking.insert(i);
+        }
+    }
+
+    /*****************************************************************
+     * Remove the most ambiguous tracks in batches
+     *****************************************************************/
+
+    // Removing a track only makes the tracks sharing its measurements less
+    // ambiguous. So as long as the next tracks of the ranking share no
+    // measurement with the ones before them, they would be the next ones to
+    // be removed one by one as well, and they are removed together.
+    std::vector<unsigned int> batch;
+    std::vector<char> meas_in_batch(n_meas, 0);
+    std::vector<unsigned int> affected;
+    std::vector<unsigned int> n_unshared(n_tracks, 0u);
+
+    unsigned int n_removed = 0;
+    while (n_removed < m_cfg.maximum_iterations && !ranking.empty() &&
+           max_shared >= m_cfg.maximum_shared_hits) {
+
+        // Collect the batch from the front of the ranking. A track with too
+        // few shared measurements could end the iteration after the removal
+        // of the tracks before it, so it also ends the batch.
+        batch.clear();
+        for (auto it = ranking.begin();
+             it != ranking.end() &&
+             n_removed + batch.size() < m_cfg.maximum_iterations;
+             ++it) {
+
+            const unsigned int candidate = *it;
+            if (!batch.empty() &&
+                n_shared[candidate] < m_cfg.maximum_shared_hits) {
+                break;
+            }
+            bool conflict = false;
+            for (unsigned int e = track_offsets[candidate];
+                 e < track_offsets[candidate + 1] && !conflict; e++) {
+                conflict = meas_in_batch[entry_meas_id[e]];
+            }
+            if (conflict) {
+                break;
+            }
+            for (unsigned int e = track_offsets[candidate];
+                 e < track_offsets[candidate + 1]; e++) {
+                meas_in_batch[entry_meas_id[e]] = 1;
+            }
+            batch.push_back(candidate);
+        }
+
+        for (unsigned int removed : batch) {
+            ranking.erase(removed);
+            --n_tracks_per_shared[n_shared[removed]];
+            accepted[removed] = 0;
+        }
+
+        // The tracks of the batch have no measurement in common, so the
+        // occupancy of every measurement changes at most once. Only the
+        // surviving tracks that stop sharing a measurement are re-ranked,
+        // once per batch.
+        affected.clear();
+        for (unsigned int removed : batch) {
+            for (unsigned int e = track_offsets[removed];
+                 e < track_offsets[removed + 1]; e++) {
+
+                const unsigned int m = entry_meas_id[e];
+                meas_in_batch[m] = 0;
+                if (--meas_n_tracks[m] != 1) {
+                    continue;
+                }
+
+                // The last track on the measurement does not share it any
+                // more
+                for (unsigned int k = meas_offsets[m];
+                     k < meas_offsets[m + 1]; k++) {
+                    const unsigned int other = meas_tracks[k];
+                    if (!accepted[other]) {
+                        continue;
+                    }
+                    if (n_unshared[other]++ == 0u) {
+                        affected.push_back(other);
+                    }
+                    break;
+                }
+            }
+        }
+
+        for (unsigned int other : affected) {
+            ranking.erase(other);
+            --n_tracks_per_shared[n_shared[other]];
+            n_shared[other] -= n_unshared[other];
+            n_unshared[other] = 0u;
+            ++n_tracks_per_shared[n_shared[other]];
+            ranking.insert(other);
+        }
+
+        n_removed += static_cast<unsigned int>(batch.size());
+        while (max_shared > 0 && n_tracks_per_shared[max_shared] == 0) {
+            --max_shared;
+        }
+    }
+
+    /*****************************************************************
+     * Collect the surviving tracks in their original order
+     *****************************************************************/
+
+    std::vector<unsigned int> result;
+    result.reserve(ranking.size());
+    for (unsigned int i = 0; i < n_tracks; i++) {
+        if (accepted[i]) {
+            result.push_back(i);
+        }
+    }
+
+    return result;
+}
+
+}  // namespace traccc
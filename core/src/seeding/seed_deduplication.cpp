@@ -0,0 +1,87 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Library include(s).
+#include "traccc/seeding/seed_deduplication.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <unordered_set>
+#include <vector>
+
+namespace traccc {
+
+namespace {
+
+/// Get the keys of the three spacepoint pairs of a seed
+std::array<std::uint64_t, 3> spacepoint_pair_keys(const seed& s) {
+
+    std::array<std::uint64_t, 3> links{s.spB_link, s.spM_link, s.spT_link};
+    std::sort(links.begin(), links.end());
+    return {(links[0] << 32) | links[1], (links[0] << 32) | links[2],
+            (links[1] << 32) | links[2]};
+}
+
+}  // namespace
+
+seed_deduplication::seed_deduplication(vecmem::memory_resource& mr)
+    : m_mr(mr) {}
+
+seed_deduplication::output_type seed_deduplication::operator()(
+    const seed_collection_types::host& seeds) const {
+
+    const std::size_t n_seeds = seeds.size();
+
+    // Visit the seeds in decreasing order of their weight
+    std::vector<std::size_t> order(n_seeds);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(),
+                     [&seeds](std::size_t lhs, std::size_t rhs) {
+                         return seeds[lhs].weight > seeds[rhs].weight;
+                     });
+
+    // Spacepoint pairs used by the accepted seeds
+    std::unordered_set<std::uint64_t> used_pairs;
+    used_pairs.reserve(3 * n_seeds);
+
+    std::vector<char> accepted(n_seeds, 0);
+    std::size_t n_accepted = 0;
+    for (std::size_t i : order) {
+
+        const std::array<std::uint64_t, 3> keys =
+            spacepoint_pair_keys(seeds[i]);
+
+        // A seed sharing two spacepoints with an accepted one shares one of
+        // its spacepoint pairs with it
+        if (std::any_of(keys.begin(), keys.end(),
+                        [&used_pairs](std::uint64_t key) {
+                            return used_pairs.count(key) > 0;
+                        })) {
+            continue;
+        }
+
+        used_pairs.insert(keys.begin(), keys.end());
+        accepted[i] = 1;
+        ++n_accepted;
+    }
+
+    // Collect the accepted seeds in their original order
+    output_type result(&m_mr.get());
+    result.reserve(n_accepted);
+    for (std::size_t i = 0; i < n_seeds; ++i) {
+        if (accepted[i]) {
+            result.push_back(seeds[i]);
+        }
+    }
+
+    return result;
+}
+
+}  // namespace traccc
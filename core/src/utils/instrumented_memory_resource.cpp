@@ -0,0 +1,184 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Library include(s).
+#include "traccc/utils/instrumented_memory_resource.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <cassert>
+#include <iomanip>
+#include <iostream>
+
+namespace traccc {
+
+namespace {
+
+/// The active tag of the current thread
+thread_local std::string_view active_tag =
+    instrumented_memory_resource::untagged;
+
+/// Record an allocation in a set of statistics
+void record_allocation(memory_profile::tag_stats& stats,
+                       std::size_t bytes) {
+
+    ++stats.allocations;
+    stats.allocated_bytes += bytes;
+    stats.live_bytes += bytes;
+    stats.peak_bytes = std::max(stats.peak_bytes, stats.live_bytes);
+}
+
+/// Record a deallocation in a set of statistics
+void record_deallocation(memory_profile::tag_stats& stats,
+                         std::size_t bytes) {
+
+    ++stats.deallocations;
+    assert(stats.live_bytes >= bytes);
+    stats.live_bytes -= bytes;
+}
+
+/// Reset the allocation counters of a set of statistics
+void reset(memory_profile::tag_stats& stats) {
+
+    stats.allocations = 0;
+    stats.deallocations = 0;
+    stats.allocated_bytes = 0;
+    stats.peak_bytes = stats.live_bytes;
+}
+
+/// Add up two sets of statistics
+void add(memory_profile::tag_stats& result,
+         const memory_profile::tag_stats& stats) {
+
+    result.allocations += stats.allocations;
+    result.deallocations += stats.deallocations;
+    result.allocated_bytes += stats.allocated_bytes;
+    result.live_bytes += stats.live_bytes;
+    result.peak_bytes += stats.peak_bytes;
+}
+
+/// Print one set of statistics as a row of a table
+void print(std::ostream& out, std::string_view name,
+           const memory_profile::tag_stats& s) {
+
+    out << std::setw(30) << std::right << name << std::setw(14)
+        << s.allocations << std::setw(14) << s.deallocations << std::setw(18)
+        << s.allocated_bytes << std::setw(14) << s.live_bytes << std::setw(14)
+        << s.peak_bytes;
+}
+
+}  // namespace
+
+memory_profile& memory_profile::operator+=(const memory_profile& other) {
+
+    for (const auto& [tag, stats] : other.tags) {
+        auto it = std::find_if(
+            tags.begin(), tags.end(),
+            [&name = tag](const auto& t) { return t.first == name; });
+        if (it == tags.end()) {
+            tags.emplace_back(tag, stats);
+        } else {
+            add(it->second, stats);
+        }
+    }
+    add(total, other.total);
+    return *this;
+}
+
+std::ostream& operator<<(std::ostream& out, const memory_profile& profile) {
+
+    out << std::setw(30) << std::right << "Tag" << std::setw(14)
+        << "allocations" << std::setw(14) << "deallocations" << std::setw(18)
+        << "allocated bytes" << std::setw(14) << "live bytes"
+        << std::setw(14) << "peak bytes";
+    for (const auto& [tag, stats] : profile.tags) {
+        out << "\n";
+        print(out, tag, stats);
+    }
+    out << "\n";
+    print(out, "Total", profile.total);
+    return out;
+}
+
+instrumented_memory_resource::scope::scope(std::string_view tag)
+    : m_previous(active_tag) {
+
+    active_tag = tag;
+}
+
+instrumented_memory_resource::scope::~scope() {
+
+    active_tag = m_previous;
+}
+
+std::string_view instrumented_memory_resource::current_tag() {
+
+    return active_tag;
+}
+
+instrumented_memory_resource::instrumented_memory_resource(
+    vecmem::memory_resource& upstream)
+    : m_upstream(upstream) {}
+
+memory_profile instrumented_memory_resource::profile() const {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    memory_profile result;
+    result.tags.reserve(m_tag_order.size());
+    for (std::string_view tag : m_tag_order) {
+        result.tags.emplace_back(std::string(tag), m_tags.find(tag)->second);
+    }
+    result.total = m_total;
+    return result;
+}
+
+void instrumented_memory_resource::reset_counters() {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& [tag, stats] : m_tags) {
+        reset(stats);
+    }
+    reset(m_total);
+}
+
+void* instrumented_memory_resource::do_allocate(std::size_t bytes,
+                                                std::size_t alignment) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    void* ptr = m_upstream.get().allocate(bytes, alignment);
+
+    const std::string_view tag = active_tag;
+    auto it = m_tags.find(tag);
+    if (it == m_tags.end()) {
+        it = m_tags.emplace(std::string(tag), tag_stats{}).first;
+        m_tag_order.push_back(it->first);
+    }
+    record_allocation(it->second, bytes);
+    record_allocation(m_total, bytes);
+    m_live[ptr] = &(it->second);
+    return ptr;
+}
+
+void instrumented_memory_resource::do_deallocate(void* ptr, std::size_t bytes,
+                                                 std::size_t alignment) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_live.find(ptr);
+    assert(it != m_live.end());
+    record_deallocation(*(it->second), bytes);
+    record_deallocation(m_total, bytes);
+    m_live.erase(it);
+    m_upstream.get().deallocate(ptr, bytes, alignment);
+}
+
+bool instrumented_memory_resource::do_is_equal(
+    const vecmem::memory_resource& other) const noexcept {
+
+    return this == &other;
+}
+
+}  // namespace traccc
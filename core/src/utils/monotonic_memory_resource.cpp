@@ -0,0 +1,103 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Library include(s).
+#include "traccc/utils/monotonic_memory_resource.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <memory>
+
+namespace traccc {
+
+namespace {
+
+/// Alignment of the blocks taken from the upstream resource
+constexpr std::size_t block_alignment = alignof(std::max_align_t);
+
+}  // namespace
+
+monotonic_memory_resource::monotonic_memory_resource(
+    vecmem::memory_resource& upstream, std::size_t block_size)
+    : m_upstream(upstream),
+      m_next_block_size(std::max<std::size_t>(block_size, 1u)) {}
+
+monotonic_memory_resource::~monotonic_memory_resource() {
+
+    release_blocks();
+}
+
+void monotonic_memory_resource::reset() {
+
+    // Merge the blocks, so that the next event fits into a single one
+    if (m_blocks.size() > 1) {
+        std::size_t total_size = 0;
+        for (const block& b : m_blocks) {
+            total_size += b.size;
+        }
+        release_blocks();
+        allocate_block(total_size);
+    }
+
+    m_current = 0;
+    m_offset = 0;
+}
+
+void* monotonic_memory_resource::do_allocate(std::size_t bytes,
+                                             std::size_t alignment) {
+
+    // Try the current block, and the ones after it that were allocated
+    // before the last reset
+    for (; m_current < m_blocks.size(); ++m_current, m_offset = 0) {
+
+        const block& b = m_blocks[m_current];
+        void* ptr = static_cast<char*>(b.ptr) + m_offset;
+        std::size_t space = b.size - m_offset;
+
+        if (std::align(alignment, bytes, ptr, space) != nullptr) {
+            m_offset = b.size - space + bytes;
+            return ptr;
+        }
+    }
+
+    // Allocate a new block, that is big enough for the request
+    allocate_block(std::max(m_next_block_size, bytes + alignment));
+    return do_allocate(bytes, alignment);
+}
+
+void monotonic_memory_resource::do_deallocate(void*, std::size_t,
+                                              std::size_t) {
+
+    // Memory is only given back by reset()
+}
+
+bool monotonic_memory_resource::do_is_equal(
+    const vecmem::memory_resource& other) const noexcept {
+
+    return this == &other;
+}
+
+void monotonic_memory_resource::allocate_block(std::size_t size) {
+
+    m_blocks.push_back(
+        {m_upstream.get().allocate(size, block_alignment), size});
+    m_current = m_blocks.size() - 1;
+    m_offset = 0;
+    m_next_block_size = 2 * size;
+}
+
+void monotonic_memory_resource::release_blocks() {
+
+    for (const block& b : m_blocks) {
+        m_upstream.get().deallocate(b.ptr, b.size, block_alignment);
+    }
+    m_blocks.clear();
+    m_current = 0;
+    m_offset = 0;
+}
+
+}  // namespace traccc
@@ -0,0 +1,60 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Library include(s).
+#include "traccc/utils/monotonic_memory_resource_pool.hpp"
+
+// System include(s).
+#include <utility>
+
+namespace traccc {
+
+monotonic_memory_resource_pool::lease::lease(
+    monotonic_memory_resource_pool& pool,
+    std::unique_ptr<monotonic_memory_resource> arena)
+    : m_pool(pool), m_arena(std::move(arena)) {}
+
+monotonic_memory_resource_pool::lease::~lease() {
+
+    // Moved-from leases do not own an arena
+    if (m_arena) {
+        m_pool.get().release(std::move(m_arena));
+    }
+}
+
+monotonic_memory_resource_pool::monotonic_memory_resource_pool(
+    vecmem::memory_resource& upstream, std::size_t block_size)
+    : m_upstream(upstream), m_block_size(block_size) {}
+
+monotonic_memory_resource_pool::lease
+monotonic_memory_resource_pool::acquire() {
+
+    std::unique_ptr<monotonic_memory_resource> arena;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_free.empty()) {
+            arena = std::move(m_free.back());
+            m_free.pop_back();
+        }
+    }
+    if (arena) {
+        arena->reset();
+    } else {
+        arena = std::make_unique<monotonic_memory_resource>(m_upstream.get(),
+                                                            m_block_size);
+    }
+    return lease(*this, std::move(arena));
+}
+
+void monotonic_memory_resource_pool::release(
+    std::unique_ptr<monotonic_memory_resource> arena) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_free.push_back(std::move(arena));
+}
+
+}  // namespace traccc
@@ -0,0 +1,36 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Project include(s).
+#include "traccc/definitions/qualifiers.hpp"
+#include "traccc/edm/fitted_track_state.hpp"
+#include "traccc/edm/track_state.hpp"
+
+// System include(s).
+#include <cstddef>
+
+namespace traccc::device {
+
+/// Function used for keeping only the fit results of the track states of a
+/// fitted track
+///
+/// @param[in] globalIndex   The index of the current thread
+/// @param[in] track_states_view The fitted track states
+/// @param[out] fitted_states_view The compact fit results, with the same
+///                                sizes as the fitted track states
+///
+TRACCC_HOST_DEVICE inline void compact_track_states(
+    std::size_t globalIndex,
+    track_state_container_types::const_view track_states_view,
+    fitted_track_state_container_types::view fitted_states_view);
+
+}  // namespace traccc::device
+
+// Include the implementation.
+#include "traccc/fitting/device/impl/compact_track_states.ipp"
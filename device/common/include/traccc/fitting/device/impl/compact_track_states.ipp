@@ -0,0 +1,41 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+namespace traccc::device {
+
+TRACCC_HOST_DEVICE inline void compact_track_states(
+    std::size_t globalIndex,
+    track_state_container_types::const_view track_states_view,
+    fitted_track_state_container_types::view fitted_states_view) {
+
+    track_state_container_types::const_device track_states(
+        track_states_view);
+
+    fitted_track_state_container_types::device fitted_states(
+        fitted_states_view);
+
+    if (globalIndex >= track_states.size()) {
+        return;
+    }
+
+    // Track states per track
+    const auto track_states_per_track = track_states[globalIndex].items;
+
+    // Fit results per track
+    auto fitted_states_per_track = fitted_states[globalIndex].items;
+
+    for (unsigned int i = 0; i < track_states_per_track.size(); i++) {
+        fitted_states_per_track[i] =
+            fitted_track_state<transform3>(track_states_per_track[i], i);
+    }
+
+    fitted_states[globalIndex].header = track_states[globalIndex].header;
+}
+
+}  // namespace traccc::device
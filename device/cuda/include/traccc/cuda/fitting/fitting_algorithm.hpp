@@ -9,6 +9,7 @@
 
 // Project include(s).
 #include "traccc/cuda/utils/stream.hpp"
+#include "traccc/edm/fitted_track_state.hpp"
 #include "traccc/edm/track_candidate.hpp"
 #include "traccc/edm/track_state.hpp"
 #include "traccc/fitting/fitting_config.hpp"
@@ -57,6 +58,17 @@ class fitting_algorithm
         const typename track_candidate_container_types::const_view&
             track_candidates_view) const override;
 
+    /// Keep only the fit results of fitted track states
+    ///
+    /// The compact fit results are a lot smaller than the track states, so
+    /// they are much cheaper to copy to the host.
+    ///
+    /// @param track_states_view the track states from the fit
+    /// @return the compact fit results of the track states
+    fitted_track_state_container_types::buffer compact(
+        const track_state_container_types::const_view& track_states_view)
+        const;
+
     private:
     /// Config object
     config_type m_cfg;
@@ -9,6 +9,7 @@
 #include "../utils/utils.hpp"
 #include "traccc/cuda/fitting/fitting_algorithm.hpp"
 #include "traccc/cuda/utils/definitions.hpp"
+#include "traccc/fitting/device/compact_track_states.hpp"
 #include "traccc/fitting/device/fit.hpp"
 #include "traccc/fitting/kalman_filter/kalman_fitter.hpp"
 
@@ -42,6 +43,15 @@ __global__ void fit(
                           track_candidates_view, track_states_view);
 }
 
+__global__ void compact_track_states(
+    track_state_container_types::const_view track_states_view,
+    fitted_track_state_container_types::view fitted_states_view) {
+
+    int gid = threadIdx.x + blockIdx.x * blockDim.x;
+
+    device::compact_track_states(gid, track_states_view, fitted_states_view);
+}
+
 }  // namespace kernels
 
 template <typename fitter_t>
@@ -98,6 +108,44 @@ track_state_container_types::buffer fitting_algorithm<fitter_t>::operator()(
     return track_states_buffer;
 }
 
+template <typename fitter_t>
+fitted_track_state_container_types::buffer
+fitting_algorithm<fitter_t>::compact(
+    const track_state_container_types::const_view& track_states_view) const {
+
+    // Get a convenience variable for the stream that we'll be using.
+    cudaStream_t stream = details::get_stream(m_stream);
+
+    // Number of tracks
+    const track_state_container_types::const_device::header_vector::size_type
+        n_tracks = m_copy.get_size(track_states_view.headers);
+
+    // Get the number of track states in each track
+    const std::vector<track_state_container_types::const_device::item_vector::
+                          value_type::size_type>
+        state_sizes = m_copy.get_sizes(track_states_view.items);
+
+    fitted_track_state_container_types::buffer fitted_states_buffer{
+        {n_tracks, m_mr.main}, {state_sizes, m_mr.main, m_mr.host}};
+
+    m_copy.setup(fitted_states_buffer.headers);
+    m_copy.setup(fitted_states_buffer.items);
+
+    if (n_tracks > 0) {
+        const unsigned int nThreads = WARP_SIZE * 2;
+        const unsigned int nBlocks = (n_tracks + nThreads - 1) / nThreads;
+
+        // Keep only the fit results
+        kernels::compact_track_states<<<nBlocks, nThreads, 0, stream>>>(
+            track_states_view, fitted_states_buffer);
+        CUDA_ERROR_CHECK(cudaGetLastError());
+    }
+
+    m_stream.synchronize();
+
+    return fitted_states_buffer;
+}
+
 // Explicit template instantiation
 using default_detector_type =
     detray::detector<detray::default_metadata, detray::device_container_types>;
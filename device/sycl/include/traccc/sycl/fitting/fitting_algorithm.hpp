@@ -11,6 +11,7 @@
 #include "traccc/sycl/utils/queue_wrapper.hpp"
 
 // Project include(s).
+#include "traccc/edm/fitted_track_state.hpp"
 #include "traccc/edm/track_candidate.hpp"
 #include "traccc/edm/track_state.hpp"
 #include "traccc/utils/algorithm.hpp"
@@ -56,6 +57,17 @@ class fitting_algorithm
         const typename track_candidate_container_types::const_view&
             track_candidates_view) const override;
 
+    /// Keep only the fit results of fitted track states
+    ///
+    /// The compact fit results are a lot smaller than the track states, so
+    /// they are much cheaper to copy to the host.
+    ///
+    /// @param track_states_view the track states from the fit
+    /// @return the compact fit results of the track states
+    fitted_track_state_container_types::buffer compact(
+        const track_state_container_types::const_view& track_states_view)
+        const;
+
     private:
     /// Config object
     config_type m_cfg;
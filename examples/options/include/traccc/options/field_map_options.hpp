@@ -0,0 +1,50 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Boost include(s).
+#include <boost/program_options.hpp>
+
+// System include(s).
+#include <array>
+#include <cstddef>
+#include <iosfwd>
+
+namespace traccc {
+
+/// Options for evaluating the magnetic field through a cached field map
+struct field_map_options {
+
+    /// Whether to sample the magnetic field onto a @c traccc::cached_field_map
+    /// and propagate through that, instead of the field itself
+    bool use_cached_map = false;
+    /// Half-length of the (box-shaped) field map along x and y [mm]
+    float half_length_xy = 1100.f;
+    /// Half-length of the field map along z [mm]
+    float half_length_z = 3100.f;
+    /// Number of grid nodes of the field map along x, y and z
+    std::array<std::size_t, 3> n_bins = {45u, 45u, 125u};
+
+    /// Constructor on top of a common @c program_options object
+    ///
+    /// @param desc The program options to add to
+    ///
+    field_map_options(boost::program_options::options_description& desc);
+
+    /// Read the command line options
+    ///
+    /// @param vm The command line options to interpret/read
+    ///
+    void read(const boost::program_options::variables_map& vm);
+
+};  // struct field_map_options
+
+/// Printout helper for @c traccc::field_map_options
+std::ostream& operator<<(std::ostream& out, const field_map_options& opt);
+
+}  // namespace traccc
@@ -13,6 +13,7 @@
 // System include(s).
 #include <cstddef>
 #include <iosfwd>
+#include <vector>
 
 namespace traccc {
 
@@ -21,6 +22,13 @@ struct mt_options {
 
     /// The number of threads to use for the data processing
     std::size_t threads = 1;
+    /// Thread counts to sweep over, in a thread-scaling measurement
+    ///
+    /// Given on the command line as a comma separated list of thread counts
+    /// and thread count ranges, like "1,2,4-8". When empty, only @c threads
+    /// threads are used.
+    ///
+    std::vector<std::size_t> thread_sweep;
 
     /// Constructor on top of a common @c program_options object
     ///
@@ -0,0 +1,48 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Boost include(s).
+#include <boost/program_options.hpp>
+
+// System include(s).
+#include <cstddef>
+#include <iosfwd>
+
+namespace traccc {
+
+/// Options for the pipelined processing of events
+struct pipeline_options {
+
+    /// The maximal number of events processed at the same time
+    ///
+    /// When zero, twice the number of threads is used.
+    ///
+    std::size_t events_in_flight = 0;
+
+    /// Constructor on top of a common @c program_options object
+    ///
+    /// @param desc The program options to add to
+    ///
+    pipeline_options(boost::program_options::options_description& desc);
+
+    /// Read the command line options
+    ///
+    /// @param vm The command line options to interpret/read
+    ///
+    void read(const boost::program_options::variables_map& vm);
+
+    /// The number of events in flight to use with a given number of threads
+    std::size_t events_in_flight_for(std::size_t threads) const;
+
+};  // struct pipeline_options
+
+/// Printout helper for @c traccc::pipeline_options
+std::ostream& operator<<(std::ostream& out, const pipeline_options& opt);
+
+}  // namespace traccc
@@ -8,13 +8,22 @@
 // Boost
 #include <boost/program_options.hpp>
 
+// System include(s).
+#include <iosfwd>
+
 namespace traccc {
 
 namespace po = boost::program_options;
 
 struct seeding_input_config {
+    /// Remove the seeds that overlap with a higher weight seed
+    bool deduplicate_seeds = false;
+
     seeding_input_config(po::options_description& desc);
     void read(const po::variables_map& vm);
 };
 
+/// Printout helper for traccc::seeding_input_config
+std::ostream& operator<<(std::ostream& out, const seeding_input_config& cfg);
+
 }  // namespace traccc
\ No newline at end of file
@@ -32,6 +32,15 @@ struct throughput_options {
     /// The file describing the detector digitization configuration
     std::string digitization_config_file;
 
+    /// The file describing the Detray detector geometry, used by the track
+    /// finding and fitting. No track finding and fitting is done if empty.
+    std::string detray_detector_file;
+    /// The file describing the material of the Detray detector (optional)
+    std::string detray_material_file;
+    /// The file describing the surface grids of the Detray detector
+    /// (optional)
+    std::string detray_grid_file;
+
     /// The average number of cells in each partition.
     /// Equal to the number of threads in the clusterization kernels multiplied
     /// by CELLS_PER_THREAD defined in clusterization. Adapt to different GPUs'
@@ -48,6 +57,18 @@ struct throughput_options {
 
     /// Output log file
     std::string log_file;
+    /// Output (JSON) report file
+    std::string report_file;
+
+    /// Whether to measure the time spent in the individual reconstruction
+    /// stages
+    bool stage_timing = false;
+    /// Whether to read the hardware performance counters of the individual
+    /// reconstruction stages (implies @c stage_timing)
+    bool hardware_counters = false;
+    /// Whether to profile the memory allocations of the reconstruction
+    /// stages
+    bool memory_profile = false;
 
     /// Constructor on top of a common @c program_options object
     ///
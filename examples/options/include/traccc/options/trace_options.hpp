@@ -0,0 +1,45 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Boost include(s).
+#include <boost/program_options.hpp>
+
+// System include(s).
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace traccc {
+
+/// Options for recording a (Chrome) trace of the processing
+struct trace_options {
+
+    /// Output trace file (no trace is recorded if empty)
+    std::string trace_file;
+    /// The number of spans to keep per thread
+    std::size_t trace_buffer_size = 1u << 16;
+
+    /// Constructor on top of a common @c program_options object
+    ///
+    /// @param desc The program options to add to
+    ///
+    trace_options(boost::program_options::options_description& desc);
+
+    /// Read the command line options
+    ///
+    /// @param vm The command line options to interpret/read
+    ///
+    void read(const boost::program_options::variables_map& vm);
+
+};  // struct trace_options
+
+/// Printout helper for @c traccc::trace_options
+std::ostream& operator<<(std::ostream& out, const trace_options& opt);
+
+}  // namespace traccc
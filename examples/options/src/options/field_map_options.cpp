@@ -0,0 +1,78 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Local include(s).
+#include "traccc/options/field_map_options.hpp"
+
+// System include(s).
+#include <iostream>
+#include <stdexcept>
+
+namespace traccc {
+
+field_map_options::field_map_options(
+    boost::program_options::options_description& desc) {
+
+    desc.add_options()("cached-field-map",
+                       boost::program_options::bool_switch(),
+                       "Propagate through a cached grid map of the magnetic "
+                       "field, instead of the field itself");
+    desc.add_options()(
+        "field-map-half-length-xy-mm",
+        boost::program_options::value<float>()->default_value(half_length_xy),
+        "Half-length of the field map along x and y [mm]");
+    desc.add_options()(
+        "field-map-half-length-z-mm",
+        boost::program_options::value<float>()->default_value(half_length_z),
+        "Half-length of the field map along z [mm]");
+    desc.add_options()(
+        "field-map-bins-xy",
+        boost::program_options::value<std::size_t>()->default_value(
+            n_bins[0]),
+        "Number of grid nodes of the field map along x and y");
+    desc.add_options()(
+        "field-map-bins-z",
+        boost::program_options::value<std::size_t>()->default_value(
+            n_bins[2]),
+        "Number of grid nodes of the field map along z");
+}
+
+void field_map_options::read(
+    const boost::program_options::variables_map& vm) {
+
+    use_cached_map = vm["cached-field-map"].as<bool>();
+    half_length_xy = vm["field-map-half-length-xy-mm"].as<float>();
+    half_length_z = vm["field-map-half-length-z-mm"].as<float>();
+    const std::size_t n_bins_xy = vm["field-map-bins-xy"].as<std::size_t>();
+    n_bins = {n_bins_xy, n_bins_xy, vm["field-map-bins-z"].as<std::size_t>()};
+
+    if (!(half_length_xy > 0.f) || !(half_length_z > 0.f)) {
+        throw std::invalid_argument{
+            "The field map half-lengths must be positive"};
+    }
+    for (std::size_t n : n_bins) {
+        if (n < 2) {
+            throw std::invalid_argument{
+                "The field map needs at least 2 grid nodes per axis"};
+        }
+    }
+}
+
+std::ostream& operator<<(std::ostream& out, const field_map_options& opt) {
+
+    out << ">>> Field map options <<<\n"
+        << "Cached field map: " << (opt.use_cached_map ? "yes" : "no");
+    if (opt.use_cached_map) {
+        out << "\nHalf-lengths (x/y, z): " << opt.half_length_xy << " mm, "
+            << opt.half_length_z << " mm"
+            << "\nGrid nodes (x, y, z): " << opt.n_bins[0] << ", "
+            << opt.n_bins[1] << ", " << opt.n_bins[2];
+    }
+    return out;
+}
+
+}  // namespace traccc
@@ -10,7 +10,30 @@
 
 // System include(s).
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
+#include <string>
+
+namespace {
+
+/// Parse a thread count, which must be a positive integer
+std::size_t parse_thread_count(const std::string& str) {
+
+    std::size_t pos = 0;
+    unsigned long value = 0;
+    try {
+        value = std::stoul(str, &pos);
+    } catch (const std::exception&) {
+        pos = 0;
+    }
+    if ((pos == 0) || (pos != str.size()) || (value == 0)) {
+        throw std::invalid_argument{"Invalid thread count in thread_sweep: \"" +
+                                    str + "\""};
+    }
+    return value;
+}
+
+}  // namespace
 
 namespace traccc {
 
@@ -20,6 +43,11 @@ mt_options::mt_options(boost::program_options::options_description& desc) {
         "threads",
         boost::program_options::value<std::size_t>()->default_value(1),
         "The number of CPU threads to use");
+    desc.add_options()(
+        "thread_sweep",
+        boost::program_options::value<std::string>()->default_value(""),
+        "Thread counts to measure the throughput with, one after the other "
+        "(e.g. \"1,2,4-8\")");
 }
 
 void mt_options::read(const boost::program_options::variables_map& vm) {
@@ -28,12 +56,39 @@ void mt_options::read(const boost::program_options::variables_map& vm) {
     if (threads == 0) {
         throw std::invalid_argument{"Must use threads>0"};
     }
+
+    thread_sweep.clear();
+    std::istringstream sweep(vm["thread_sweep"].as<std::string>());
+    std::string item;
+    while (std::getline(sweep, item, ',')) {
+        const std::size_t dash = item.find('-');
+        if (dash == std::string::npos) {
+            thread_sweep.push_back(parse_thread_count(item));
+            continue;
+        }
+        const std::size_t first = parse_thread_count(item.substr(0, dash));
+        const std::size_t last = parse_thread_count(item.substr(dash + 1));
+        if (last < first) {
+            throw std::invalid_argument{"Invalid thread count range in "
+                                        "thread_sweep: \"" +
+                                        item + "\""};
+        }
+        for (std::size_t i = first; i <= last; ++i) {
+            thread_sweep.push_back(i);
+        }
+    }
 }
 
 std::ostream& operator<<(std::ostream& out, const mt_options& opt) {
 
     out << ">>> Multi-threading options <<<\n"
         << "CPU threads: " << opt.threads;
+    if (!opt.thread_sweep.empty()) {
+        out << "\nThread sweep:";
+        for (std::size_t threads : opt.thread_sweep) {
+            out << " " << threads;
+        }
+    }
     return out;
 }
 
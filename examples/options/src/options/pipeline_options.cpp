@@ -0,0 +1,48 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Local include(s).
+#include "traccc/options/pipeline_options.hpp"
+
+// System include(s).
+#include <iostream>
+
+namespace traccc {
+
+namespace po = boost::program_options;
+
+pipeline_options::pipeline_options(po::options_description& desc) {
+
+    desc.add_options()("events_in_flight",
+                       po::value<std::size_t>()->default_value(0),
+                       "Maximal number of events processed at the same time "
+                       "(0: twice the number of threads)");
+}
+
+void pipeline_options::read(const po::variables_map& vm) {
+
+    events_in_flight = vm["events_in_flight"].as<std::size_t>();
+}
+
+std::size_t pipeline_options::events_in_flight_for(std::size_t threads) const {
+
+    return (events_in_flight == 0 ? 2 * threads : events_in_flight);
+}
+
+std::ostream& operator<<(std::ostream& out, const pipeline_options& opt) {
+
+    out << ">>> Pipeline options <<<\n"
+        << "Events in flight: ";
+    if (opt.events_in_flight == 0) {
+        out << "2 x threads";
+    } else {
+        out << opt.events_in_flight;
+    }
+    return out;
+}
+
+}  // namespace traccc
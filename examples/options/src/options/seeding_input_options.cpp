@@ -8,7 +8,26 @@
 // options
 #include "traccc/options/seeding_input_options.hpp"
 
+// System include(s).
+#include <iostream>
+
 traccc::seeding_input_config::seeding_input_config(
-    po::options_description& /*desc*/) {}
+    po::options_description& desc) {
+
+    desc.add_options()("deduplicate_seeds",
+                       po::value<bool>()->default_value(false),
+                       "Remove the seeds that share two spacepoints with a "
+                       "higher weight seed");
+}
+
+void traccc::seeding_input_config::read(const po::variables_map& vm) {
+    deduplicate_seeds = vm["deduplicate_seeds"].as<bool>();
+}
+
+std::ostream& traccc::operator<<(std::ostream& out,
+                                 const seeding_input_config& cfg) {
 
-void traccc::seeding_input_config::read(const po::variables_map& /*vm*/) {}
+    out << ">>> Seeding options <<<\n"
+        << "Seed deduplication: " << (cfg.deduplicate_seeds ? "on" : "off");
+    return out;
+}
@@ -28,6 +28,16 @@ throughput_options::throughput_options(po::options_description& desc) {
     desc.add_options()("digitization_config_file",
                        po::value<std::string>()->required(),
                        "Digitization configuration file");
+    desc.add_options()("detray_detector_file",
+                       po::value<std::string>()->default_value(""),
+                       "Detray detector geometry file, for running the track "
+                       "finding and fitting");
+    desc.add_options()("detray_material_file",
+                       po::value<std::string>()->default_value(""),
+                       "Detray detector material file");
+    desc.add_options()("detray_grid_file",
+                       po::value<std::string>()->default_value(""),
+                       "Detray detector surface grid file");
     desc.add_options()(
         "target_cells_per_partition",
         po::value<unsigned short>()->default_value(1024),
@@ -47,6 +57,21 @@ throughput_options::throughput_options(po::options_description& desc) {
         "log_file",
         po::value<std::string>()->default_value(
             "\0", "File where result logs will be printed (in append mode)."));
+    desc.add_options()("report_file",
+                       po::value<std::string>()->default_value(""),
+                       "File where a JSON report of the results is written");
+    desc.add_options()("stage_timing", po::value<bool>()->default_value(false),
+                       "Measure the time spent in the individual stages of "
+                       "the reconstruction");
+    desc.add_options()("hardware_counters",
+                       po::value<bool>()->default_value(false),
+                       "Read the hardware performance counters of the "
+                       "individual stages of the reconstruction (implies "
+                       "stage_timing)");
+    desc.add_options()("memory_profile",
+                       po::value<bool>()->default_value(false),
+                       "Profile the memory allocations of the individual "
+                       "stages of the reconstruction");
 }
 
 void throughput_options::read(const po::variables_map& vm) {
@@ -68,12 +93,19 @@ void throughput_options::read(const po::variables_map& vm) {
     input_directory = vm["input_directory"].as<std::string>();
     detector_file = vm["detector_file"].as<std::string>();
     digitization_config_file = vm["digitization_config_file"].as<std::string>();
+    detray_detector_file = vm["detray_detector_file"].as<std::string>();
+    detray_material_file = vm["detray_material_file"].as<std::string>();
+    detray_grid_file = vm["detray_grid_file"].as<std::string>();
     target_cells_per_partition =
         vm["target_cells_per_partition"].as<unsigned short>();
     loaded_events = vm["loaded_events"].as<std::size_t>();
     processed_events = vm["processed_events"].as<std::size_t>();
     cold_run_events = vm["cold_run_events"].as<std::size_t>();
     log_file = vm["log_file"].as<std::string>();
+    report_file = vm["report_file"].as<std::string>();
+    hardware_counters = vm["hardware_counters"].as<bool>();
+    stage_timing = vm["stage_timing"].as<bool>() || hardware_counters;
+    memory_profile = vm["memory_profile"].as<bool>();
 }
 
 std::ostream& operator<<(std::ostream& out, const throughput_options& opt) {
@@ -84,12 +116,24 @@ std::ostream& operator<<(std::ostream& out, const throughput_options& opt) {
         << "Detector geometry          : " << opt.detector_file << "\n"
         << "Digitization config        : " << opt.digitization_config_file
         << "\n"
+        << "Detray detector            : " << opt.detray_detector_file
+        << "\n"
+        << "Detray material            : " << opt.detray_material_file
+        << "\n"
+        << "Detray surface grids       : " << opt.detray_grid_file << "\n"
         << "Target cells per partition : " << opt.target_cells_per_partition
         << "\n"
         << "Loaded event(s)            : " << opt.loaded_events << "\n"
         << "Cold run event(s)          : " << opt.cold_run_events << "\n"
         << "Processed event(s)         : " << opt.processed_events << "\n"
-        << "Log_file                   : " << opt.log_file;
+        << "Log_file                   : " << opt.log_file << "\n"
+        << "Report file                : " << opt.report_file << "\n"
+        << "Stage timing               : "
+        << (opt.stage_timing ? "yes" : "no") << "\n"
+        << "Hardware counters          : "
+        << (opt.hardware_counters ? "yes" : "no") << "\n"
+        << "Memory profile             : "
+        << (opt.memory_profile ? "yes" : "no");
     return out;
 }
 
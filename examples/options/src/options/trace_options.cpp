@@ -0,0 +1,48 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Local include(s).
+#include "traccc/options/trace_options.hpp"
+
+// System include(s).
+#include <iostream>
+#include <stdexcept>
+
+namespace traccc {
+
+namespace po = boost::program_options;
+
+trace_options::trace_options(po::options_description& desc) {
+
+    desc.add_options()("trace_file",
+                       po::value<std::string>()->default_value(""),
+                       "File where a Chrome trace of the processing is "
+                       "written");
+    desc.add_options()("trace_buffer_size",
+                       po::value<std::size_t>()->default_value(1u << 16),
+                       "Number of trace spans to keep per thread");
+}
+
+void trace_options::read(const po::variables_map& vm) {
+
+    trace_file = vm["trace_file"].as<std::string>();
+    trace_buffer_size = vm["trace_buffer_size"].as<std::size_t>();
+    if (trace_buffer_size == 0) {
+        throw std::invalid_argument{"Must use trace_buffer_size>0"};
+    }
+}
+
+std::ostream& operator<<(std::ostream& out, const trace_options& opt) {
+
+    out << ">>> Tracing options <<<\n"
+        << "Trace file       : "
+        << (opt.trace_file.empty() ? "none" : opt.trace_file) << "\n"
+        << "Trace buffer size: " << opt.trace_buffer_size;
+    return out;
+}
+
+}  // namespace traccc
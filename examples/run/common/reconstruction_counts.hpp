@@ -0,0 +1,86 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Project include(s).
+#include "traccc/edm/cell.hpp"
+#include "traccc/edm/measurement.hpp"
+#include "traccc/edm/track_parameters.hpp"
+
+// System include(s).
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace traccc {
+
+/// Number of the objects reconstructed in an event
+///
+/// The throughput applications only count these, to make sure that the
+/// compiler would not optimise away any of the processing.
+///
+struct reconstruction_counts {
+    /// Number of the estimated track parameters
+    std::size_t track_params = 0;
+    /// Number of the fitted tracks
+    std::size_t tracks = 0;
+};
+
+namespace details {
+
+/// Whether a full-chain algorithm can run its stages one by one
+template <typename FULL_CHAIN_ALG, typename = void>
+struct has_tracking_stages : std::false_type {};
+
+template <typename FULL_CHAIN_ALG>
+struct has_tracking_stages<
+    FULL_CHAIN_ALG,
+    std::void_t<decltype(std::declval<const FULL_CHAIN_ALG&>().fit_tracks(
+        std::declval<const FULL_CHAIN_ALG&>().find_tracks(
+            std::declval<measurement_collection_types::host&>(),
+            std::declval<
+                const bound_track_parameters_collection_types::host&>())))>>
+    : std::true_type {};
+
+}  // namespace details
+
+/// Reconstruct one event with a full-chain algorithm
+///
+/// The chains that run the track finding and fitting are run stage by stage,
+/// to count both their estimated track parameters and their fitted tracks.
+/// The chains only estimating the track parameters are just run as a whole.
+///
+/// @param alg The full-chain algorithm to run
+/// @param cells The cells of the event
+/// @param modules The modules of the event
+/// @return The number of objects reconstructed in the event
+///
+template <typename FULL_CHAIN_ALG>
+reconstruction_counts reconstruct(
+    const FULL_CHAIN_ALG& alg, const cell_collection_types::host& cells,
+    const cell_module_collection_types::host& modules) {
+
+    reconstruction_counts result;
+    if constexpr (details::has_tracking_stages<FULL_CHAIN_ALG>::value) {
+        measurement_collection_types::host measurements =
+            alg.clusterize(cells, modules);
+        const auto track_params =
+            alg.seed(alg.form_spacepoints(measurements, modules));
+        result.track_params = track_params.size();
+        if (alg.runs_tracking()) {
+            result.tracks =
+                alg.fit_tracks(alg.find_tracks(measurements, track_params))
+                    .size();
+        }
+    } else {
+        result.track_params = alg(cells, modules).size();
+    }
+    return result;
+}
+
+}  // namespace traccc
@@ -7,20 +7,35 @@
 
 #pragma once
 
+// Local include(s).
+#include "reconstruction_counts.hpp"
+
 // Command line option include(s).
 #include "traccc/options/handle_argument_errors.hpp"
 #include "traccc/options/mt_options.hpp"
+#include "traccc/options/seeding_input_options.hpp"
 #include "traccc/options/throughput_options.hpp"
+#include "traccc/options/trace_options.hpp"
 #include "traccc/seeding/detail/seeding_config.hpp"
 
 // I/O include(s).
 #include "traccc/io/demonstrator_edm.hpp"
 #include "traccc/io/read.hpp"
+#include "traccc/io/utils.hpp"
 
 // Performance measurement include(s).
+#include "traccc/performance/benchmark_report.hpp"
+#include "traccc/performance/latency_histogram.hpp"
+#include "traccc/performance/stage_timing.hpp"
+#include "traccc/performance/thread_scaling.hpp"
 #include "traccc/performance/throughput.hpp"
 #include "traccc/performance/timer.hpp"
 #include "traccc/performance/timing_info.hpp"
+#include "traccc/performance/trace_recorder.hpp"
+#include "traccc/utils/instrumented_memory_resource.hpp"
+
+// Detray include(s).
+#include "detray/io/common/detector_reader.hpp"
 
 // VecMem include(s).
 #include <vecmem/memory/binary_page_memory_resource.hpp>
@@ -31,12 +46,15 @@
 #include <tbb/task_group.h>
 
 // System include(s).
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstdlib>
 #include <ctime>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace traccc {
@@ -52,20 +70,26 @@ int throughput_mt(std::string_view description, int argc, char* argv[],
     po::options_description desc{description.data()};
     desc.add_options()("help,h", "Give help with the program's options");
     throughput_options throughput_cfg{desc};
+    seeding_input_config seeding_cfg{desc};
     mt_options mt_cfg{desc};
+    trace_options trace_cfg{desc};
 
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
     handle_argument_errors(vm, desc);
 
     throughput_cfg.read(vm);
+    seeding_cfg.read(vm);
     mt_cfg.read(vm);
+    trace_cfg.read(vm);
 
     // Greet the user.
     std::cout << "\n"
               << description << "\n\n"
               << throughput_cfg << "\n"
+              << seeding_cfg << "\n"
               << mt_cfg << "\n"
+              << trace_cfg << "\n"
               << std::endl;
 
     // Set seeding config
@@ -73,15 +97,23 @@ int throughput_mt(std::string_view description, int argc, char* argv[],
     seedfinder_config finder_config;
     spacepoint_grid_config grid_config(finder_config);
     seedfilter_config filter_config;
+    filter_config.deduplicate_seeds = seeding_cfg.deduplicate_seeds;
 
-    // Set up the timing info holder.
+    // Set up the timing info holders.
     performance::timing_info times;
+    performance::stage_timing stage_times{throughput_cfg.hardware_counters};
+    performance::event_latency_recorder latencies;
 
-    // Set up the TBB arena and thread group.
-    tbb::global_control global_thread_limit(
-        tbb::global_control::max_allowed_parallelism, mt_cfg.threads + 1);
-    tbb::task_arena arena{static_cast<int>(mt_cfg.threads), 0};
-    tbb::task_group group;
+    // Set up the (optional) trace of the processing.
+    const bool tracing = !trace_cfg.trace_file.empty();
+    performance::trace_recorder trace{trace_cfg.trace_buffer_size};
+
+    // The thread counts to measure the throughput with.
+    const std::vector<std::size_t> thread_counts =
+        (mt_cfg.thread_sweep.empty() ? std::vector<std::size_t>{mt_cfg.threads}
+                                     : mt_cfg.thread_sweep);
+    const std::size_t max_threads =
+        *std::max_element(thread_counts.begin(), thread_counts.end());
 
     // Memory resource to use in the test.
     HOST_MR uncached_host_mr;
@@ -91,6 +123,9 @@ int throughput_mt(std::string_view description, int argc, char* argv[],
 
     {
         performance::timer t{"File reading", times};
+        performance::trace_recorder::scope ts{
+            tracing ? &trace.make_buffer(max_threads + 1) : nullptr,
+            "File reading"};
         // Create empty inputs using the correct memory resource
         for (std::size_t i = 0; i < throughput_cfg.loaded_events; ++i) {
             input.push_back(demonstrator_input::value_type(&uncached_host_mr));
@@ -102,105 +137,262 @@ int throughput_mt(std::string_view description, int argc, char* argv[],
                  throughput_cfg.input_data_format);
     }
 
-    // Set up cached memory resources on top of the host memory resource
-    // separately for each CPU thread.
-    std::vector<std::unique_ptr<vecmem::binary_page_memory_resource> >
-        cached_host_mrs{mt_cfg.threads + 1};
-
-    // Set up the full-chain algorithm(s). One for each thread.
-    std::vector<FULL_CHAIN_ALG> algs;
-    algs.reserve(mt_cfg.threads + 1);
-    for (std::size_t i = 0; i < mt_cfg.threads + 1; ++i) {
-
-        cached_host_mrs.at(i) =
-            std::make_unique<vecmem::binary_page_memory_resource>(
-                uncached_host_mr);
-        vecmem::memory_resource& alg_host_mr =
-            use_host_caching
-                ? static_cast<vecmem::memory_resource&>(
-                      *(cached_host_mrs.at(i)))
-                : static_cast<vecmem::memory_resource&>(uncached_host_mr);
-        algs.push_back({alg_host_mr, throughput_cfg.target_cells_per_partition,
-                        finder_config, grid_config, filter_config});
+    // Read in the Detray detector of the track finding and fitting, if one
+    // was specified. It is only read by the algorithms, so all of them share
+    // the same one.
+    std::unique_ptr<typename FULL_CHAIN_ALG::host_detector_type> detector;
+    if (!throughput_cfg.detray_detector_file.empty()) {
+        performance::timer t{"Detector reading", times};
+        detray::io::detector_reader_config reader_cfg{};
+        reader_cfg.add_file(io::data_directory() +
+                            throughput_cfg.detray_detector_file);
+        if (!throughput_cfg.detray_material_file.empty()) {
+            reader_cfg.add_file(io::data_directory() +
+                                throughput_cfg.detray_material_file);
+        }
+        if (!throughput_cfg.detray_grid_file.empty()) {
+            reader_cfg.add_file(io::data_directory() +
+                                throughput_cfg.detray_grid_file);
+        }
+        auto [det, names] = detray::io::read_detector<
+            typename FULL_CHAIN_ALG::host_detector_type>(uncached_host_mr,
+                                                         reader_cfg);
+        detector =
+            std::make_unique<typename FULL_CHAIN_ALG::host_detector_type>(
+                std::move(det));
+    }
+
+    // Set up the trace buffers of the threads, shared by all thread counts.
+    std::vector<performance::trace_recorder::buffer*> trace_buffers;
+    if (tracing) {
+        for (std::size_t i = 0; i < max_threads + 1; ++i) {
+            trace_buffers.push_back(&trace.make_buffer(i));
+        }
     }
 
     // Seed the random number generator.
     std::srand(std::time(0));
 
-    // Dummy count uses output of tp algorithm to ensure the compiler
+    // Dummy counts use the output of the algorithms to ensure the compiler
     // optimisations don't skip any step
     std::atomic_size_t rec_track_params = 0;
+    std::atomic_size_t rec_tracks = 0;
+
+    // Results of the thread-scaling sweep, and the (coarse) timing of the
+    // latest measurement.
+    performance::thread_scaling scaling;
+    performance::timing_info run_times;
+    memory_profile allocations;
+
+    // Measure the throughput with each of the requested thread counts,
+    // re-using the events read in above. The detailed (stage timing, latency
+    // and memory) measurements are reported for the last thread count.
+    for (const std::size_t threads : thread_counts) {
+
+        run_times = {};
+        latencies.reset();
+
+        // Set up the TBB arena and thread group.
+        tbb::global_control global_thread_limit(
+            tbb::global_control::max_allowed_parallelism, threads + 1);
+        tbb::task_arena arena{static_cast<int>(threads), 0};
+        tbb::task_group group;
+
+        // Set up cached memory resources on top of the host memory resource
+        // separately for each CPU thread.
+        std::vector<std::unique_ptr<vecmem::binary_page_memory_resource> >
+            cached_host_mrs{threads + 1};
+        // Profile the allocations of the algorithms on top of the (caching)
+        // memory resources, so that the caching would not hide them.
+        std::vector<std::unique_ptr<instrumented_memory_resource> >
+            profiling_host_mrs{threads + 1};
+
+        // Set up the full-chain algorithm(s). One for each thread.
+        std::vector<FULL_CHAIN_ALG> algs;
+        algs.reserve(threads + 1);
+        for (std::size_t i = 0; i < threads + 1; ++i) {
+
+            cached_host_mrs.at(i) =
+                std::make_unique<vecmem::binary_page_memory_resource>(
+                    uncached_host_mr);
+            vecmem::memory_resource& upstream_host_mr =
+                use_host_caching
+                    ? static_cast<vecmem::memory_resource&>(
+                          *(cached_host_mrs.at(i)))
+                    : static_cast<vecmem::memory_resource&>(uncached_host_mr);
+            profiling_host_mrs.at(i) =
+                std::make_unique<instrumented_memory_resource>(
+                    upstream_host_mr);
+            vecmem::memory_resource& alg_host_mr =
+                throughput_cfg.memory_profile
+                    ? static_cast<vecmem::memory_resource&>(
+                          *(profiling_host_mrs.at(i)))
+                    : upstream_host_mr;
+            algs.push_back({alg_host_mr,
+                            throughput_cfg.target_cells_per_partition,
+                            finder_config, grid_config, filter_config,
+                            detector.get()});
+            if (throughput_cfg.stage_timing) {
+                algs.back().set_stage_timing(stage_times.make_accumulator());
+            }
+            if (tracing) {
+                algs.back().set_trace_buffer(*(trace_buffers.at(i)));
+            }
+        }
 
-    // Cold Run events. To discard any "initialisation issues" in the
-    // measurements.
-    {
-        // Measure the time of execution.
-        performance::timer t{"Warm-up processing", times};
-
-        // Process the requested number of events.
-        for (std::size_t i = 0; i < throughput_cfg.cold_run_events; ++i) {
-
-            // Choose which event to process.
-            const std::size_t event =
-                std::rand() % throughput_cfg.loaded_events;
-
-            // Launch the processing of the event.
-            arena.execute([&, event]() {
-                group.run([&, event]() {
-                    rec_track_params.fetch_add(
-                        algs.at(tbb::this_task_arena::current_thread_index())(
-                                input[event].cells, input[event].modules)
-                            .size());
+        // Cold Run events. To discard any "initialisation issues" in the
+        // measurements.
+        {
+            // Measure the time of execution.
+            performance::timer t{"Warm-up processing", run_times};
+
+            // Process the requested number of events.
+            for (std::size_t i = 0; i < throughput_cfg.cold_run_events; ++i) {
+
+                // Choose which event to process.
+                const std::size_t event =
+                    std::rand() % throughput_cfg.loaded_events;
+
+                // Launch the processing of the event.
+                arena.execute([&, event]() {
+                    group.run([&, event]() {
+                        // Isolate the event, so that a thread waiting for
+                        // the nested parallel loops of the algorithm would
+                        // not pick up another event with the same algorithm.
+                        tbb::this_task_arena::isolate([&]() {
+                            const int thread =
+                                tbb::this_task_arena::current_thread_index();
+                            if (tracing) {
+                                trace_buffers.at(thread)->set_event(event);
+                            }
+                            const reconstruction_counts counts =
+                                reconstruct(algs.at(thread),
+                                            input[event].cells,
+                                            input[event].modules);
+                            rec_track_params.fetch_add(counts.track_params);
+                            rec_tracks.fetch_add(counts.tracks);
+                        });
+                    });
                 });
-            });
-        }
+            }
 
-        // Wait for all tasks to finish.
-        group.wait();
-    }
+            // Wait for all tasks to finish.
+            group.wait();
+        }
 
-    // Reset the dummy counter.
-    rec_track_params = 0;
+        // Reset the dummy counter, and the stage times and allocation counts
+        // of the warm-up.
+        rec_track_params = 0;
+        rec_tracks = 0;
+        stage_times.reset();
+        for (auto& mr : profiling_host_mrs) {
+            mr->reset_counters();
+        }
 
-    {
-        // Measure the total time of execution.
-        performance::timer t{"Event processing", times};
-
-        // Process the requested number of events.
-        for (std::size_t i = 0; i < throughput_cfg.processed_events; ++i) {
-
-            // Choose which event to process.
-            const std::size_t event =
-                std::rand() % throughput_cfg.loaded_events;
-
-            // std::cout << "running event " << i << " : " << event <<
-            // std::endl;
-
-            // Launch the processing of the event.
-            arena.execute([&, event]() {
-                group.run([&, event]() {
-                    rec_track_params.fetch_add(
-                        algs.at(tbb::this_task_arena::current_thread_index())(
-                                input[event].cells, input[event].modules)
-                            .size());
+        {
+            // Measure the total time of execution.
+            performance::timer t{"Event processing", run_times};
+
+            // Process the requested number of events.
+            for (std::size_t i = 0; i < throughput_cfg.processed_events; ++i) {
+
+                // Choose which event to process.
+                const std::size_t event =
+                    std::rand() % throughput_cfg.loaded_events;
+
+                // Launch the processing of the event, measuring its latency.
+                arena.execute([&, event]() {
+                    group.run([&, event]() {
+                        // Isolate the event, as for the warm-up.
+                        tbb::this_task_arena::isolate([&]() {
+                            const int thread =
+                                tbb::this_task_arena::current_thread_index();
+                            if (tracing) {
+                                trace_buffers.at(thread)->set_event(event);
+                            }
+                            const auto start =
+                                std::chrono::steady_clock::now();
+                            const reconstruction_counts counts =
+                                reconstruct(algs.at(thread),
+                                            input[event].cells,
+                                            input[event].modules);
+                            rec_track_params.fetch_add(counts.track_params);
+                            rec_tracks.fetch_add(counts.tracks);
+                            latencies.record(
+                                std::chrono::steady_clock::now() - start,
+                                input[event].cells.size());
+                        });
+                    });
                 });
-            });
+            }
+
+            // Wait for all tasks to finish.
+            group.wait();
+        }
+
+        // Delete the algorithms and host memory caches explicitly before
+        // their parent object would go out of scope.
+        algs.clear();
+        cached_host_mrs.clear();
+
+        // Collect the results of this thread count.
+        scaling.add(threads, throughput_cfg.processed_events,
+                    run_times.get_time("Event processing"));
+        allocations = {};
+        for (const auto& mr : profiling_host_mrs) {
+            allocations += mr->profile();
+        }
+        if (!mt_cfg.thread_sweep.empty()) {
+            std::cout << "Throughput with " << threads << " thread(s):\n"
+                      << performance::throughput{
+                             throughput_cfg.processed_events, run_times,
+                             "Event processing"}
+                      << std::endl;
         }
 
-        // Wait for all tasks to finish.
-        group.wait();
+        // Print results to log file
+        if (throughput_cfg.log_file != "\0") {
+            std::ofstream logFile;
+            logFile.open(throughput_cfg.log_file, std::fstream::app);
+            logFile << "\"" << throughput_cfg.input_directory << "\""
+                    << "," << threads << "," << throughput_cfg.loaded_events
+                    << "," << throughput_cfg.cold_run_events << ","
+                    << throughput_cfg.processed_events << ","
+                    << throughput_cfg.target_cells_per_partition << ","
+                    << run_times.get_time("Warm-up processing").count() << ","
+                    << run_times.get_time("Event processing").count()
+                    << std::endl;
+            logFile.close();
+        }
     }
 
-    // Delete the algorithms and host memory caches explicitly before their
-    // parent object would go out of scope.
-    algs.clear();
-    cached_host_mrs.clear();
+    // Add the coarse timing of the last measurement to the overall timing.
+    times.data.insert(times.data.end(), run_times.data.begin(),
+                      run_times.data.end());
 
     // Print some results.
     std::cout << "Reconstructed track parameters: " << rec_track_params.load()
               << std::endl;
+    std::cout << "Fitted tracks: " << rec_tracks.load() << std::endl;
     std::cout << "Time totals:" << std::endl;
     std::cout << times << std::endl;
+    if (throughput_cfg.stage_timing) {
+        std::cout << "Stage time totals (summed over all threads):"
+                  << std::endl;
+        std::cout << stage_times.merge() << std::endl;
+    }
+    if (throughput_cfg.hardware_counters) {
+        std::cout << "Stage hardware counters (summed over the threads "
+                     "running the stages):"
+                  << std::endl;
+        stage_times.print_hardware_counters(std::cout);
+        std::cout << std::endl;
+    }
+    if (throughput_cfg.memory_profile) {
+        std::cout << "Memory allocation profile (summed over all threads):"
+                  << std::endl;
+        std::cout << allocations << std::endl;
+    }
     std::cout << "Throughput:" << std::endl;
     std::cout << performance::throughput{throughput_cfg.cold_run_events, times,
                                          "Warm-up processing"}
@@ -208,19 +400,51 @@ int throughput_mt(std::string_view description, int argc, char* argv[],
               << performance::throughput{throughput_cfg.processed_events, times,
                                          "Event processing"}
               << std::endl;
+    std::cout << "Event latencies:" << std::endl;
+    std::cout << latencies << std::endl;
+    if (!mt_cfg.thread_sweep.empty()) {
+        std::cout << "Thread scaling:" << std::endl;
+        std::cout << scaling << std::endl;
+    }
+
+    // Write the trace of the processing
+    if (tracing) {
+        std::ofstream trace_file(trace_cfg.trace_file);
+        trace.write_json(trace_file);
+    }
 
-    // Print results to log file
-    if (throughput_cfg.log_file != "\0") {
-        std::ofstream logFile;
-        logFile.open(throughput_cfg.log_file, std::fstream::app);
-        logFile << "\"" << throughput_cfg.input_directory << "\""
-                << "," << mt_cfg.threads << "," << throughput_cfg.loaded_events
-                << "," << throughput_cfg.cold_run_events << ","
-                << throughput_cfg.processed_events << ","
-                << throughput_cfg.target_cells_per_partition << ","
-                << times.get_time("Warm-up processing").count() << ","
-                << times.get_time("Event processing").count() << std::endl;
-        logFile.close();
+    // Write the JSON report
+    if (!throughput_cfg.report_file.empty()) {
+        performance::benchmark_report report;
+        report.application = description;
+        report.add_configuration("input_data_format",
+                                 throughput_cfg.input_data_format);
+        report.add_configuration("input_directory",
+                                 throughput_cfg.input_directory);
+        report.add_configuration("detector_file", throughput_cfg.detector_file);
+        report.add_configuration("digitization_config_file",
+                                 throughput_cfg.digitization_config_file);
+        report.add_configuration("target_cells_per_partition",
+                                 throughput_cfg.target_cells_per_partition);
+        report.add_configuration("loaded_events", throughput_cfg.loaded_events);
+        report.add_configuration("cold_run_events",
+                                 throughput_cfg.cold_run_events);
+        report.add_configuration("use_host_caching", use_host_caching);
+        report.threads = thread_counts.back();
+        report.processed_events = throughput_cfg.processed_events;
+        report.times = &times;
+        if (throughput_cfg.stage_timing) {
+            report.stage_times = &stage_times;
+        }
+        report.latencies = &latencies;
+        if (throughput_cfg.memory_profile) {
+            report.allocations = &allocations;
+        }
+        if (!mt_cfg.thread_sweep.empty()) {
+            report.scaling = &scaling;
+        }
+        std::ofstream report_file(throughput_cfg.report_file);
+        performance::write_json(report_file, report);
     }
 
     // Return gracefully.
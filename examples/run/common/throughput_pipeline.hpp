@@ -0,0 +1,43 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// VecMem include(s).
+#include <vecmem/memory/host_memory_resource.hpp>
+
+// System include(s).
+#include <string_view>
+
+namespace traccc {
+
+/// Helper function running a pipelined, multi-threaded throughput test
+///
+/// The events are sent through a pipeline of reconstruction stages, with a
+/// bounded number of events in flight. The stages of different events run
+/// concurrently, while the threads not needed by the pipeline can help with
+/// the (internally parallel) stages of the events in flight.
+///
+/// @tparam FULL_CHAIN_ALG The type of the full chain algorithm to use. It
+///                        has to provide the stages of the chain one by one.
+/// @tparam HOST_MR The host memory resource type to use
+/// @param description A short description of the application
+/// @param argc The count of command line arguments (from @c main(...))
+/// @param argv The command line arguments (from @c main(...))
+/// @param use_host_caching Flag specifying whether host-side memory caching
+///                         should be used
+/// @return The value to be returned from @c main(...)
+///
+template <typename FULL_CHAIN_ALG,
+          typename HOST_MR = vecmem::host_memory_resource>
+int throughput_pipeline(std::string_view description, int argc, char* argv[],
+                        bool use_host_caching = false);
+
+}  // namespace traccc
+
+// Local include(s).
+#include "throughput_pipeline.ipp"
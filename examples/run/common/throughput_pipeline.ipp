@@ -0,0 +1,558 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Project include(s).
+#include "traccc/edm/measurement.hpp"
+#include "traccc/edm/spacepoint.hpp"
+#include "traccc/edm/track_parameters.hpp"
+#include "traccc/edm/track_state.hpp"
+
+// Command line option include(s).
+#include "traccc/options/handle_argument_errors.hpp"
+#include "traccc/options/mt_options.hpp"
+#include "traccc/options/pipeline_options.hpp"
+#include "traccc/options/seeding_input_options.hpp"
+#include "traccc/options/throughput_options.hpp"
+#include "traccc/options/trace_options.hpp"
+#include "traccc/seeding/detail/seeding_config.hpp"
+
+// I/O include(s).
+#include "traccc/io/demonstrator_edm.hpp"
+#include "traccc/io/read.hpp"
+#include "traccc/io/utils.hpp"
+
+// Performance measurement include(s).
+#include "traccc/performance/benchmark_report.hpp"
+#include "traccc/performance/latency_histogram.hpp"
+#include "traccc/performance/stage_timing.hpp"
+#include "traccc/performance/thread_scaling.hpp"
+#include "traccc/performance/throughput.hpp"
+#include "traccc/performance/timer.hpp"
+#include "traccc/performance/timing_info.hpp"
+#include "traccc/performance/trace_recorder.hpp"
+#include "traccc/utils/instrumented_memory_resource.hpp"
+
+// Detray include(s).
+#include "detray/io/common/detector_reader.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/binary_page_memory_resource.hpp>
+
+// TBB include(s).
+#include <tbb/concurrent_queue.h>
+#include <tbb/global_control.h>
+#include <tbb/parallel_pipeline.h>
+#include <tbb/task_arena.h>
+
+// System include(s).
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace traccc {
+
+namespace details {
+
+/// State of one event "in flight" in the reconstruction pipeline
+///
+/// Every slot has its own algorithm and memory resources. Since a slot only
+/// holds one event at a time, and the stages of an event are run one after
+/// the other, an algorithm object is never used by two threads at once.
+///
+template <typename FULL_CHAIN_ALG>
+struct pipeline_slot {
+
+    /// Index of the slot (used as the "thread" of its trace)
+    std::size_t index = 0;
+
+    /// Caching memory resource of the slot
+    std::unique_ptr<vecmem::binary_page_memory_resource> cached_host_mr;
+    /// Allocation profiling memory resource of the slot
+    std::unique_ptr<instrumented_memory_resource> profiling_host_mr;
+    /// The algorithm processing the events of the slot
+    std::unique_ptr<FULL_CHAIN_ALG> alg;
+
+    /// The event being processed
+    std::size_t event = 0;
+    /// The time when the processing of the event started
+    std::chrono::steady_clock::time_point start;
+
+    /// @name Results of the stages for the current event
+    /// @{
+    std::optional<measurement_collection_types::host> measurements;
+    std::optional<spacepoint_collection_types::host> spacepoints;
+    std::optional<bound_track_parameters_collection_types::host> track_params;
+    std::optional<track_state_container_types::host> track_states;
+    std::optional<typename FULL_CHAIN_ALG::output_type> tracks;
+    /// @}
+
+    /// Release the results of the current event
+    void clear() {
+        tracks.reset();
+        track_states.reset();
+        track_params.reset();
+        spacepoints.reset();
+        measurements.reset();
+    }
+
+};  // struct pipeline_slot
+
+}  // namespace details
+
+template <typename FULL_CHAIN_ALG, typename HOST_MR>
+int throughput_pipeline(std::string_view description, int argc, char* argv[],
+                        bool use_host_caching) {
+
+    // Convenience typedefs.
+    namespace po = boost::program_options;
+    using slot_type = details::pipeline_slot<FULL_CHAIN_ALG>;
+
+    // Read in the command line options.
+    po::options_description desc{description.data()};
+    desc.add_options()("help,h", "Give help with the program's options");
+    throughput_options throughput_cfg{desc};
+    seeding_input_config seeding_cfg{desc};
+    mt_options mt_cfg{desc};
+    pipeline_options pipeline_cfg{desc};
+    trace_options trace_cfg{desc};
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    handle_argument_errors(vm, desc);
+
+    throughput_cfg.read(vm);
+    seeding_cfg.read(vm);
+    mt_cfg.read(vm);
+    pipeline_cfg.read(vm);
+    trace_cfg.read(vm);
+
+    // Greet the user.
+    std::cout << "\n"
+              << description << "\n\n"
+              << throughput_cfg << "\n"
+              << seeding_cfg << "\n"
+              << mt_cfg << "\n"
+              << pipeline_cfg << "\n"
+              << trace_cfg << "\n"
+              << std::endl;
+
+    // Set seeding config
+    // @FIXME: Seeding config should be configured by options
+    seedfinder_config finder_config;
+    spacepoint_grid_config grid_config(finder_config);
+    seedfilter_config filter_config;
+    filter_config.deduplicate_seeds = seeding_cfg.deduplicate_seeds;
+
+    // Set up the timing info holders.
+    performance::timing_info times;
+    performance::stage_timing stage_times{throughput_cfg.hardware_counters};
+    performance::event_latency_recorder latencies;
+
+    // Set up the (optional) trace of the processing.
+    const bool tracing = !trace_cfg.trace_file.empty();
+    performance::trace_recorder trace{trace_cfg.trace_buffer_size};
+
+    // The thread counts to measure the throughput with, and the largest
+    // number of events in flight that any of them would use.
+    const std::vector<std::size_t> thread_counts =
+        (mt_cfg.thread_sweep.empty() ? std::vector<std::size_t>{mt_cfg.threads}
+                                     : mt_cfg.thread_sweep);
+    std::size_t max_slots = 0;
+    for (const std::size_t threads : thread_counts) {
+        max_slots =
+            std::max(max_slots, pipeline_cfg.events_in_flight_for(threads));
+    }
+
+    // Memory resource to use in the test.
+    HOST_MR uncached_host_mr;
+
+    // Read in all input events into memory.
+    demonstrator_input input(&uncached_host_mr);
+
+    {
+        performance::timer t{"File reading", times};
+        performance::trace_recorder::scope ts{
+            tracing ? &trace.make_buffer(max_slots) : nullptr, "File reading"};
+        // Create empty inputs using the correct memory resource
+        for (std::size_t i = 0; i < throughput_cfg.loaded_events; ++i) {
+            input.push_back(demonstrator_input::value_type(&uncached_host_mr));
+        }
+        // Read event data into input vector
+        io::read(input, throughput_cfg.loaded_events,
+                 throughput_cfg.input_directory, throughput_cfg.detector_file,
+                 throughput_cfg.digitization_config_file,
+                 throughput_cfg.input_data_format);
+    }
+
+    // Read in the Detray detector of the track finding and fitting, if one
+    // was specified. It is only read by the algorithms, so all of them share
+    // the same one.
+    std::unique_ptr<typename FULL_CHAIN_ALG::host_detector_type> detector;
+    if (!throughput_cfg.detray_detector_file.empty()) {
+        performance::timer t{"Detector reading", times};
+        detray::io::detector_reader_config reader_cfg{};
+        reader_cfg.add_file(io::data_directory() +
+                            throughput_cfg.detray_detector_file);
+        if (!throughput_cfg.detray_material_file.empty()) {
+            reader_cfg.add_file(io::data_directory() +
+                                throughput_cfg.detray_material_file);
+        }
+        if (!throughput_cfg.detray_grid_file.empty()) {
+            reader_cfg.add_file(io::data_directory() +
+                                throughput_cfg.detray_grid_file);
+        }
+        auto [det, names] = detray::io::read_detector<
+            typename FULL_CHAIN_ALG::host_detector_type>(uncached_host_mr,
+                                                         reader_cfg);
+        detector =
+            std::make_unique<typename FULL_CHAIN_ALG::host_detector_type>(
+                std::move(det));
+    }
+
+    // Set up the trace buffers of the slots, shared by all thread counts.
+    std::vector<performance::trace_recorder::buffer*> trace_buffers;
+    if (tracing) {
+        for (std::size_t i = 0; i < max_slots; ++i) {
+            trace_buffers.push_back(&trace.make_buffer(i));
+        }
+    }
+
+    // Seed the random number generator.
+    std::srand(std::time(0));
+
+    // Dummy counts use the output of the algorithms to ensure the compiler
+    // optimisations don't skip any step. They are only updated by the
+    // (serial) last stage of the pipeline.
+    std::size_t rec_track_params = 0;
+    std::size_t rec_tracks = 0;
+
+    // Results of the thread-scaling sweep, and the (coarse) timing of the
+    // latest measurement.
+    performance::thread_scaling scaling;
+    performance::timing_info run_times;
+    memory_profile allocations;
+
+    // Measure the throughput with each of the requested thread counts,
+    // re-using the events read in above. The detailed (stage timing, latency
+    // and memory) measurements are reported for the last thread count.
+    for (const std::size_t threads : thread_counts) {
+
+        run_times = {};
+        latencies.reset();
+
+        // Set up the TBB arena.
+        tbb::global_control global_thread_limit(
+            tbb::global_control::max_allowed_parallelism, threads + 1);
+        tbb::task_arena arena{static_cast<int>(threads), 0};
+
+        // Set up the slots of the events in flight.
+        const std::size_t n_slots = pipeline_cfg.events_in_flight_for(threads);
+        std::vector<slot_type> slots(n_slots);
+        tbb::concurrent_queue<slot_type*> free_slots;
+        for (std::size_t i = 0; i < n_slots; ++i) {
+
+            slot_type& slot = slots[i];
+            slot.index = i;
+            slot.cached_host_mr =
+                std::make_unique<vecmem::binary_page_memory_resource>(
+                    uncached_host_mr);
+            vecmem::memory_resource& upstream_host_mr =
+                use_host_caching
+                    ? static_cast<vecmem::memory_resource&>(
+                          *(slot.cached_host_mr))
+                    : static_cast<vecmem::memory_resource&>(uncached_host_mr);
+            slot.profiling_host_mr =
+                std::make_unique<instrumented_memory_resource>(
+                    upstream_host_mr);
+            vecmem::memory_resource& alg_host_mr =
+                throughput_cfg.memory_profile
+                    ? static_cast<vecmem::memory_resource&>(
+                          *(slot.profiling_host_mr))
+                    : upstream_host_mr;
+            slot.alg = std::make_unique<FULL_CHAIN_ALG>(
+                alg_host_mr, throughput_cfg.target_cells_per_partition,
+                finder_config, grid_config, filter_config, detector.get());
+            if (throughput_cfg.stage_timing) {
+                slot.alg->set_stage_timing(stage_times.make_accumulator());
+            }
+            if (tracing) {
+                slot.alg->set_trace_buffer(*(trace_buffers.at(i)));
+            }
+            free_slots.push(&slot);
+        }
+
+        // Process a given number of randomly chosen events with the
+        // pipeline. No more than n_slots events are in flight at any time,
+        // so a free slot is always available for a new event.
+        auto process = [&](std::size_t n_events, bool record_latencies) {
+            std::size_t n_read = 0;
+            arena.execute([&]() {
+                tbb::parallel_pipeline(
+                    n_slots,
+                    // "Read" the next event from memory.
+                    tbb::make_filter<void, slot_type*>(
+                        tbb::filter_mode::serial_in_order,
+                        [&](tbb::flow_control& fc) -> slot_type* {
+                            if (n_read == n_events) {
+                                fc.stop();
+                                return nullptr;
+                            }
+                            ++n_read;
+                            slot_type* slot = nullptr;
+                            if (!free_slots.try_pop(slot)) {
+                                throw std::logic_error{
+                                    "No free pipeline slot was found"};
+                            }
+                            slot->event =
+                                std::rand() % throughput_cfg.loaded_events;
+                            slot->start = std::chrono::steady_clock::now();
+                            if (tracing) {
+                                trace_buffers.at(slot->index)
+                                    ->set_event(slot->event);
+                            }
+                            return slot;
+                        }) &
+                    // Run the reconstruction stages of the event. Every stage
+                    // runs isolated, so that a thread waiting for the nested
+                    // parallel loops of a stage can not pick up a stage of
+                    // another event, whose time, hardware counters and
+                    // memory would then be accounted to this stage.
+                    tbb::make_filter<slot_type*, slot_type*>(
+                        tbb::filter_mode::parallel,
+                        [&](slot_type* slot) {
+                            tbb::this_task_arena::isolate([&]() {
+                                const auto& event = input[slot->event];
+                                slot->measurements.emplace(
+                                    slot->alg->clusterize(event.cells,
+                                                          event.modules));
+                            });
+                            return slot;
+                        }) &
+                    tbb::make_filter<slot_type*, slot_type*>(
+                        tbb::filter_mode::parallel,
+                        [&](slot_type* slot) {
+                            tbb::this_task_arena::isolate([&]() {
+                                slot->spacepoints.emplace(
+                                    slot->alg->form_spacepoints(
+                                        *(slot->measurements),
+                                        input[slot->event].modules));
+                            });
+                            return slot;
+                        }) &
+                    tbb::make_filter<slot_type*, slot_type*>(
+                        tbb::filter_mode::parallel,
+                        [&](slot_type* slot) {
+                            tbb::this_task_arena::isolate([&]() {
+                                slot->track_params.emplace(
+                                    slot->alg->seed(*(slot->spacepoints)));
+                            });
+                            return slot;
+                        }) &
+                    tbb::make_filter<slot_type*, slot_type*>(
+                        tbb::filter_mode::parallel,
+                        [&](slot_type* slot) {
+                            if (slot->alg->runs_tracking()) {
+                                tbb::this_task_arena::isolate([&]() {
+                                    slot->track_states.emplace(
+                                        slot->alg->find_tracks(
+                                            *(slot->measurements),
+                                            *(slot->track_params)));
+                                });
+                            }
+                            return slot;
+                        }) &
+                    tbb::make_filter<slot_type*, slot_type*>(
+                        tbb::filter_mode::parallel,
+                        [&](slot_type* slot) {
+                            if (slot->alg->runs_tracking()) {
+                                tbb::this_task_arena::isolate([&]() {
+                                    slot->tracks.emplace(
+                                        slot->alg->fit_tracks(std::move(
+                                            *(slot->track_states))));
+                                });
+                            }
+                            return slot;
+                        }) &
+                    // "Write" the results of the event, and free its slot.
+                    tbb::make_filter<slot_type*, void>(
+                        tbb::filter_mode::serial_out_of_order,
+                        [&](slot_type* slot) {
+                            rec_track_params += slot->track_params->size();
+                            if (slot->tracks) {
+                                rec_tracks += slot->tracks->size();
+                            }
+                            if (record_latencies) {
+                                latencies.record(
+                                    std::chrono::steady_clock::now() -
+                                        slot->start,
+                                    input[slot->event].cells.size());
+                            }
+                            slot->clear();
+                            free_slots.push(slot);
+                        }));
+            });
+        };
+
+        // Cold Run events. To discard any "initialisation issues" in the
+        // measurements.
+        {
+            // Measure the time of execution.
+            performance::timer t{"Warm-up processing", run_times};
+            process(throughput_cfg.cold_run_events, false);
+        }
+
+        // Reset the dummy counters, and the stage times and allocation
+        // counts of the warm-up.
+        rec_track_params = 0;
+        rec_tracks = 0;
+        stage_times.reset();
+        for (auto& slot : slots) {
+            slot.profiling_host_mr->reset_counters();
+        }
+
+        {
+            // Measure the total time of execution.
+            performance::timer t{"Event processing", run_times};
+            process(throughput_cfg.processed_events, true);
+        }
+
+        // Collect the results of this thread count.
+        scaling.add(threads, throughput_cfg.processed_events,
+                    run_times.get_time("Event processing"));
+        allocations = {};
+        for (const auto& slot : slots) {
+            allocations += slot.profiling_host_mr->profile();
+        }
+        if (!mt_cfg.thread_sweep.empty()) {
+            std::cout << "Throughput with " << threads << " thread(s) and "
+                      << n_slots << " event(s) in flight:\n"
+                      << performance::throughput{
+                             throughput_cfg.processed_events, run_times,
+                             "Event processing"}
+                      << std::endl;
+        }
+
+        // Delete the algorithms and host memory caches before their parent
+        // object would go out of scope.
+        slots.clear();
+
+        // Print results to log file
+        if (throughput_cfg.log_file != "\0") {
+            std::ofstream logFile;
+            logFile.open(throughput_cfg.log_file, std::fstream::app);
+            logFile << "\"" << throughput_cfg.input_directory << "\""
+                    << "," << threads << "," << throughput_cfg.loaded_events
+                    << "," << throughput_cfg.cold_run_events << ","
+                    << throughput_cfg.processed_events << ","
+                    << throughput_cfg.target_cells_per_partition << ","
+                    << run_times.get_time("Warm-up processing").count() << ","
+                    << run_times.get_time("Event processing").count()
+                    << std::endl;
+            logFile.close();
+        }
+    }
+
+    // Add the coarse timing of the last measurement to the overall timing.
+    times.data.insert(times.data.end(), run_times.data.begin(),
+                      run_times.data.end());
+
+    // Print some results.
+    std::cout << "Reconstructed track parameters: " << rec_track_params
+              << std::endl;
+    std::cout << "Fitted tracks: " << rec_tracks << std::endl;
+    std::cout << "Time totals:" << std::endl;
+    std::cout << times << std::endl;
+    if (throughput_cfg.stage_timing) {
+        std::cout << "Stage time totals (summed over all events in flight):"
+                  << std::endl;
+        std::cout << stage_times.merge() << std::endl;
+    }
+    if (throughput_cfg.hardware_counters) {
+        std::cout << "Stage hardware counters (summed over all events in "
+                     "flight):"
+                  << std::endl;
+        stage_times.print_hardware_counters(std::cout);
+        std::cout << std::endl;
+    }
+    if (throughput_cfg.memory_profile) {
+        std::cout << "Memory allocation profile (summed over all events in "
+                     "flight):"
+                  << std::endl;
+        std::cout << allocations << std::endl;
+    }
+    std::cout << "Throughput:" << std::endl;
+    std::cout << performance::throughput{throughput_cfg.cold_run_events, times,
+                                         "Warm-up processing"}
+              << "\n"
+              << performance::throughput{throughput_cfg.processed_events, times,
+                                         "Event processing"}
+              << std::endl;
+    std::cout << "Event latencies:" << std::endl;
+    std::cout << latencies << std::endl;
+    if (!mt_cfg.thread_sweep.empty()) {
+        std::cout << "Thread scaling:" << std::endl;
+        std::cout << scaling << std::endl;
+    }
+
+    // Write the trace of the processing
+    if (tracing) {
+        std::ofstream trace_file(trace_cfg.trace_file);
+        trace.write_json(trace_file);
+    }
+
+    // Write the JSON report
+    if (!throughput_cfg.report_file.empty()) {
+        performance::benchmark_report report;
+        report.application = description;
+        report.add_configuration("input_data_format",
+                                 throughput_cfg.input_data_format);
+        report.add_configuration("input_directory",
+                                 throughput_cfg.input_directory);
+        report.add_configuration("detector_file", throughput_cfg.detector_file);
+        report.add_configuration("digitization_config_file",
+                                 throughput_cfg.digitization_config_file);
+        report.add_configuration("target_cells_per_partition",
+                                 throughput_cfg.target_cells_per_partition);
+        report.add_configuration("loaded_events", throughput_cfg.loaded_events);
+        report.add_configuration("cold_run_events",
+                                 throughput_cfg.cold_run_events);
+        report.add_configuration("use_host_caching", use_host_caching);
+        report.add_configuration(
+            "events_in_flight",
+            pipeline_cfg.events_in_flight_for(thread_counts.back()));
+        report.threads = thread_counts.back();
+        report.processed_events = throughput_cfg.processed_events;
+        report.times = &times;
+        if (throughput_cfg.stage_timing) {
+            report.stage_times = &stage_times;
+        }
+        report.latencies = &latencies;
+        if (throughput_cfg.memory_profile) {
+            report.allocations = &allocations;
+        }
+        if (!mt_cfg.thread_sweep.empty()) {
+            report.scaling = &scaling;
+        }
+        std::ofstream report_file(throughput_cfg.report_file);
+        performance::write_json(report_file, report);
+    }
+
+    // Return gracefully.
+    return 0;
+}
+
+}  // namespace traccc
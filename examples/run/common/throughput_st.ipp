@@ -7,27 +7,44 @@
 
 #pragma once
 
+// Local include(s).
+#include "reconstruction_counts.hpp"
+
 // Command line option include(s).
 #include "traccc/options/handle_argument_errors.hpp"
+#include "traccc/options/seeding_input_options.hpp"
 #include "traccc/options/throughput_options.hpp"
+#include "traccc/options/trace_options.hpp"
 
 // I/O include(s).
 #include "traccc/io/demonstrator_edm.hpp"
 #include "traccc/io/read.hpp"
+#include "traccc/io/utils.hpp"
 
 // Performance measurement include(s).
+#include "traccc/performance/benchmark_report.hpp"
+#include "traccc/performance/latency_histogram.hpp"
+#include "traccc/performance/stage_timing.hpp"
 #include "traccc/performance/throughput.hpp"
 #include "traccc/performance/timer.hpp"
 #include "traccc/performance/timing_info.hpp"
+#include "traccc/performance/trace_recorder.hpp"
+#include "traccc/utils/instrumented_memory_resource.hpp"
+
+// Detray include(s).
+#include "detray/io/common/detector_reader.hpp"
 
 // VecMem include(s).
 #include <vecmem/memory/binary_page_memory_resource.hpp>
 
 // System include(s).
+#include <chrono>
 #include <cstdlib>
 #include <ctime>
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <utility>
 
 namespace traccc {
 
@@ -42,17 +59,23 @@ int throughput_st(std::string_view description, int argc, char* argv[],
     po::options_description desc{description.data()};
     desc.add_options()("help,h", "Give help with the program's options");
     throughput_options throughput_cfg{desc};
+    seeding_input_config seeding_cfg{desc};
+    trace_options trace_cfg{desc};
 
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
     handle_argument_errors(vm, desc);
 
     throughput_cfg.read(vm);
+    seeding_cfg.read(vm);
+    trace_cfg.read(vm);
 
     // Greet the user.
     std::cout << "\n"
               << description << "\n\n"
               << throughput_cfg << "\n"
+              << seeding_cfg << "\n"
+              << trace_cfg << "\n"
               << std::endl;
 
     // Set seeding config
@@ -60,25 +83,44 @@ int throughput_st(std::string_view description, int argc, char* argv[],
     seedfinder_config finder_config;
     spacepoint_grid_config grid_config(finder_config);
     seedfilter_config filter_config;
+    filter_config.deduplicate_seeds = seeding_cfg.deduplicate_seeds;
 
-    // Set up the timing info holder.
+    // Set up the timing info holders.
     performance::timing_info times;
+    performance::stage_timing stage_times{throughput_cfg.hardware_counters};
+    performance::event_latency_recorder latencies;
+
+    // Set up the (optional) trace of the processing.
+    const bool tracing = !trace_cfg.trace_file.empty();
+    performance::trace_recorder trace{trace_cfg.trace_buffer_size};
 
     // Memory resource to use in the test.
     HOST_MR uncached_host_mr;
     std::unique_ptr<vecmem::binary_page_memory_resource> cached_host_mr =
         std::make_unique<vecmem::binary_page_memory_resource>(uncached_host_mr);
 
-    vecmem::memory_resource& alg_host_mr =
+    vecmem::memory_resource& upstream_host_mr =
         use_host_caching
             ? static_cast<vecmem::memory_resource&>(*cached_host_mr)
             : static_cast<vecmem::memory_resource&>(uncached_host_mr);
 
+    // Profile the allocations of the algorithm on top of the (caching)
+    // memory resource, so that the caching would not hide them.
+    instrumented_memory_resource profiling_host_mr{upstream_host_mr};
+    vecmem::memory_resource& alg_host_mr =
+        throughput_cfg.memory_profile
+            ? static_cast<vecmem::memory_resource&>(profiling_host_mr)
+            : upstream_host_mr;
+
     // Read in all input events into memory.
     demonstrator_input input(&uncached_host_mr);
 
+    performance::trace_recorder::buffer* trace_buffer =
+        tracing ? &trace.make_buffer(0) : nullptr;
+
     {
         performance::timer t{"File reading", times};
+        performance::trace_recorder::scope ts{trace_buffer, "File reading"};
         // Create empty inputs using the correct memory resource
         for (std::size_t i = 0; i < throughput_cfg.loaded_events; ++i) {
             input.push_back(demonstrator_input::value_type(&uncached_host_mr));
@@ -90,17 +132,48 @@ int throughput_st(std::string_view description, int argc, char* argv[],
                  throughput_cfg.input_data_format);
     }
 
+    // Read in the Detray detector of the track finding and fitting, if one
+    // was specified.
+    std::unique_ptr<typename FULL_CHAIN_ALG::host_detector_type> detector;
+    if (!throughput_cfg.detray_detector_file.empty()) {
+        performance::timer t{"Detector reading", times};
+        detray::io::detector_reader_config reader_cfg{};
+        reader_cfg.add_file(io::data_directory() +
+                            throughput_cfg.detray_detector_file);
+        if (!throughput_cfg.detray_material_file.empty()) {
+            reader_cfg.add_file(io::data_directory() +
+                                throughput_cfg.detray_material_file);
+        }
+        if (!throughput_cfg.detray_grid_file.empty()) {
+            reader_cfg.add_file(io::data_directory() +
+                                throughput_cfg.detray_grid_file);
+        }
+        auto [det, names] = detray::io::read_detector<
+            typename FULL_CHAIN_ALG::host_detector_type>(uncached_host_mr,
+                                                         reader_cfg);
+        detector =
+            std::make_unique<typename FULL_CHAIN_ALG::host_detector_type>(
+                std::move(det));
+    }
+
     // Set up the full-chain algorithm.
     std::unique_ptr<FULL_CHAIN_ALG> alg = std::make_unique<FULL_CHAIN_ALG>(
         alg_host_mr, throughput_cfg.target_cells_per_partition, finder_config,
-        grid_config, filter_config);
+        grid_config, filter_config, detector.get());
+    if (throughput_cfg.stage_timing) {
+        alg->set_stage_timing(stage_times.make_accumulator());
+    }
+    if (tracing) {
+        alg->set_trace_buffer(*trace_buffer);
+    }
 
     // Seed the random number generator.
     std::srand(std::time(0));
 
-    // Dummy count uses output of tp algorithm to ensure the compiler
+    // Dummy counts use the output of the algorithms to ensure the compiler
     // optimisations don't skip any step
     std::size_t rec_track_params = 0;
+    std::size_t rec_tracks = 0;
 
     // Cold Run events. To discard any "initialisation issues" in the
     // measurements.
@@ -116,13 +189,22 @@ int throughput_st(std::string_view description, int argc, char* argv[],
                 std::rand() % throughput_cfg.loaded_events;
 
             // Process one event.
-            rec_track_params +=
-                (*alg)(input[event].cells, input[event].modules).size();
+            if (tracing) {
+                trace_buffer->set_event(event);
+            }
+            const reconstruction_counts counts =
+                reconstruct(*alg, input[event].cells, input[event].modules);
+            rec_track_params += counts.track_params;
+            rec_tracks += counts.tracks;
         }
     }
 
-    // Reset the dummy counter.
+    // Reset the dummy counter, and the stage times and allocation counts of
+    // the warm-up.
     rec_track_params = 0;
+    rec_tracks = 0;
+    stage_times.reset();
+    profiling_host_mr.reset_counters();
 
     {
         // Measure the total time of execution.
@@ -135,9 +217,17 @@ int throughput_st(std::string_view description, int argc, char* argv[],
             const std::size_t event =
                 std::rand() % throughput_cfg.loaded_events;
 
-            // Process one event.
-            rec_track_params +=
-                (*alg)(input[event].cells, input[event].modules).size();
+            // Process one event, measuring its latency.
+            if (tracing) {
+                trace_buffer->set_event(event);
+            }
+            const auto start = std::chrono::steady_clock::now();
+            const reconstruction_counts counts =
+                reconstruct(*alg, input[event].cells, input[event].modules);
+            rec_track_params += counts.track_params;
+            rec_tracks += counts.tracks;
+            latencies.record(std::chrono::steady_clock::now() - start,
+                             input[event].cells.size());
         }
     }
 
@@ -148,8 +238,23 @@ int throughput_st(std::string_view description, int argc, char* argv[],
     // Print some results.
     std::cout << "Reconstructed track parameters: " << rec_track_params
               << std::endl;
+    std::cout << "Fitted tracks: " << rec_tracks << std::endl;
     std::cout << "Time totals:" << std::endl;
     std::cout << times << std::endl;
+    if (throughput_cfg.stage_timing) {
+        std::cout << "Stage time totals:" << std::endl;
+        std::cout << stage_times.merge() << std::endl;
+    }
+    if (throughput_cfg.hardware_counters) {
+        std::cout << "Stage hardware counters:" << std::endl;
+        stage_times.print_hardware_counters(std::cout);
+        std::cout << std::endl;
+    }
+    const memory_profile allocations = profiling_host_mr.profile();
+    if (throughput_cfg.memory_profile) {
+        std::cout << "Memory allocation profile:" << std::endl;
+        std::cout << allocations << std::endl;
+    }
     std::cout << "Throughput:" << std::endl;
     std::cout << performance::throughput{throughput_cfg.cold_run_events, times,
                                          "Warm-up processing"}
@@ -157,6 +262,45 @@ int throughput_st(std::string_view description, int argc, char* argv[],
               << performance::throughput{throughput_cfg.processed_events, times,
                                          "Event processing"}
               << std::endl;
+    std::cout << "Event latencies:" << std::endl;
+    std::cout << latencies << std::endl;
+
+    // Write the trace of the processing
+    if (tracing) {
+        std::ofstream trace_file(trace_cfg.trace_file);
+        trace.write_json(trace_file);
+    }
+
+    // Write the JSON report
+    if (!throughput_cfg.report_file.empty()) {
+        performance::benchmark_report report;
+        report.application = description;
+        report.add_configuration("input_data_format",
+                                 throughput_cfg.input_data_format);
+        report.add_configuration("input_directory",
+                                 throughput_cfg.input_directory);
+        report.add_configuration("detector_file", throughput_cfg.detector_file);
+        report.add_configuration("digitization_config_file",
+                                 throughput_cfg.digitization_config_file);
+        report.add_configuration("target_cells_per_partition",
+                                 throughput_cfg.target_cells_per_partition);
+        report.add_configuration("loaded_events", throughput_cfg.loaded_events);
+        report.add_configuration("cold_run_events",
+                                 throughput_cfg.cold_run_events);
+        report.add_configuration("use_host_caching", use_host_caching);
+        report.threads = 1;
+        report.processed_events = throughput_cfg.processed_events;
+        report.times = &times;
+        if (throughput_cfg.stage_timing) {
+            report.stage_times = &stage_times;
+        }
+        report.latencies = &latencies;
+        if (throughput_cfg.memory_profile) {
+            report.allocations = &allocations;
+        }
+        std::ofstream report_file(throughput_cfg.report_file);
+        performance::write_json(report_file, report);
+    }
 
     // Return gracefully.
     return 0;
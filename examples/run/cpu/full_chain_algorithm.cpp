@@ -8,29 +8,161 @@
 // Local include(s).
 #include "full_chain_algorithm.hpp"
 
+// System include(s).
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
 namespace traccc {
 
 full_chain_algorithm::full_chain_algorithm(
     vecmem::memory_resource& mr, unsigned int,
     const seedfinder_config& finder_config,
     const spacepoint_grid_config& grid_config,
-    const seedfilter_config& filter_config)
+    const seedfilter_config& filter_config,
+    const host_detector_type* detector)
     : m_clusterization(mr),
       m_spacepoint_formation(mr),
-      m_seeding(finder_config, grid_config, filter_config, mr),
+      m_spacepoint_binning(finder_config, grid_config, mr),
+      m_seed_finding(finder_config, filter_config),
+      m_seed_deduplication(mr),
       m_track_parameter_estimation(mr),
+      m_finding(finding_algorithm::config_type{}, mr),
+      m_ambiguity_resolution(
+          greedy_ambiguity_resolution_algorithm::config_type{}, mr),
+      m_fitting(fitting_algorithm::config_type{}),
       m_finder_config(finder_config),
       m_grid_config(grid_config),
-      m_filter_config(filter_config) {}
+      m_filter_config(filter_config),
+      m_mr(mr),
+      m_detector(detector),
+      m_field(detray::bfield::create_const_field(
+          vector3{0.f, 0.f, finder_config.bFieldInZ})) {}
 
 full_chain_algorithm::output_type full_chain_algorithm::operator()(
     const cell_collection_types::host& cells,
     const cell_module_collection_types::host& modules) const {
 
-    const spacepoint_formation::output_type spacepoints =
-        m_spacepoint_formation(m_clusterization(cells, modules), modules);
-    return m_track_parameter_estimation(spacepoints, m_seeding(spacepoints),
+    measurement_collection_types::host measurements =
+        clusterize(cells, modules);
+    const spacepoint_collection_types::host spacepoints =
+        form_spacepoints(measurements, modules);
+    const bound_track_parameters_collection_types::host track_params =
+        seed(spacepoints);
+
+    // Stop here if there is no detector to run the track finding and fitting
+    // on.
+    if (!runs_tracking()) {
+        return output_type{&(m_mr.get())};
+    }
+    return fit_tracks(find_tracks(measurements, track_params));
+}
+
+measurement_collection_types::host full_chain_algorithm::clusterize(
+    const cell_collection_types::host& cells,
+    const cell_module_collection_types::host& modules) const {
+
+    performance::stage_timing::scope t{
+        m_stage_timing, performance::stage::clusterization, m_trace};
+    return m_clusterization(cells, modules);
+}
+
+spacepoint_collection_types::host full_chain_algorithm::form_spacepoints(
+    const measurement_collection_types::host& measurements,
+    const cell_module_collection_types::host& modules) const {
+
+    performance::stage_timing::scope t{
+        m_stage_timing, performance::stage::spacepoint_formation, m_trace};
+    return m_spacepoint_formation(measurements, modules);
+}
+
+bound_track_parameters_collection_types::host full_chain_algorithm::seed(
+    const spacepoint_collection_types::host& spacepoints) const {
+
+    using performance::stage;
+    using scope = performance::stage_timing::scope;
+
+    // Run every step in its own (optionally timed and traced) scope
+    const spacepoint_binning::output_type sp_grid = [&]() {
+        scope t{m_stage_timing, stage::spacepoint_binning, m_trace};
+        return m_spacepoint_binning(spacepoints);
+    }();
+    const seed_finding::output_type seeds = [&]() {
+        scope t{m_stage_timing, stage::seeding, m_trace};
+        seed_finding::output_type result = m_seed_finding(spacepoints, sp_grid);
+        if (m_filter_config.deduplicate_seeds) {
+            result = m_seed_deduplication(result);
+        }
+        return result;
+    }();
+
+    scope t{m_stage_timing, stage::track_params_estimation, m_trace};
+    return m_track_parameter_estimation(spacepoints, seeds,
                                         {0.f, 0.f, m_finder_config.bFieldInZ});
 }
 
+track_state_container_types::host full_chain_algorithm::find_tracks(
+    measurement_collection_types::host& measurements,
+    const bound_track_parameters_collection_types::host& track_params) const {
+
+    assert(runs_tracking());
+
+    using performance::stage;
+    using scope = performance::stage_timing::scope;
+
+    // Keep the filtered states of the found tracks, so that the fit would
+    // only need to smooth them.
+    track_state_container_types::host track_states{&(m_mr.get())};
+    const track_candidate_container_types::host track_candidates = [&]() {
+        scope t{m_stage_timing, stage::track_finding, m_trace};
+
+        // The track finding expects the measurements to be sorted by surface
+        if (!std::is_sorted(measurements.begin(), measurements.end(),
+                            measurement_sort_comp())) {
+            std::sort(measurements.begin(), measurements.end(),
+                      measurement_sort_comp());
+        }
+        return m_finding(*m_detector, m_field, measurements, track_params,
+                         track_states);
+    }();
+
+    // Only keep the states of the tracks that survive the ambiguity
+    // resolution
+    scope t{m_stage_timing, stage::ambiguity_resolution, m_trace};
+    const std::vector<unsigned int> survivors =
+        m_ambiguity_resolution.surviving_tracks(track_candidates);
+    if (survivors.size() == track_states.size()) {
+        return track_states;
+    }
+    track_state_container_types::host result{&(m_mr.get())};
+    result.reserve(survivors.size());
+    for (unsigned int i : survivors) {
+        result.push_back(std::move(track_states.get_headers()[i]),
+                         std::move(track_states.get_items()[i]));
+    }
+    return result;
+}
+
+full_chain_algorithm::output_type full_chain_algorithm::fit_tracks(
+    track_state_container_types::host&& track_states) const {
+
+    assert(runs_tracking());
+    performance::stage_timing::scope t{
+        m_stage_timing, performance::stage::track_fitting, m_trace};
+    return m_fitting(*m_detector, m_field, std::move(track_states));
+}
+
+void full_chain_algorithm::set_stage_timing(
+    performance::stage_timing::accumulator& acc) {
+
+    m_stage_timing = &acc;
+}
+
+void full_chain_algorithm::set_trace_buffer(
+    performance::trace_recorder::buffer& buf) {
+
+    m_trace = &buf;
+}
+
 }  // namespace traccc
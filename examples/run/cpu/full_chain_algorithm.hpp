@@ -8,50 +8,158 @@
 #pragma once
 
 // Project include(s).
+#include "traccc/ambiguity_resolution/greedy_ambiguity_resolution_algorithm.hpp"
 #include "traccc/clusterization/clusterization_algorithm.hpp"
 #include "traccc/clusterization/spacepoint_formation.hpp"
 #include "traccc/edm/cell.hpp"
-#include "traccc/seeding/seeding_algorithm.hpp"
+#include "traccc/edm/track_state.hpp"
+#include "traccc/finding/finding_algorithm.hpp"
+#include "traccc/fitting/fitting_algorithm.hpp"
+#include "traccc/fitting/kalman_filter/kalman_fitter.hpp"
+#include "traccc/performance/stage_timing.hpp"
+#include "traccc/performance/trace_recorder.hpp"
+#include "traccc/seeding/seed_deduplication.hpp"
+#include "traccc/seeding/seed_finding.hpp"
+#include "traccc/seeding/spacepoint_binning.hpp"
 #include "traccc/seeding/track_params_estimation.hpp"
 #include "traccc/utils/algorithm.hpp"
 
+// Detray include(s).
+#include "detray/core/detector.hpp"
+#include "detray/core/detector_metadata.hpp"
+#include "detray/detectors/bfield.hpp"
+#include "detray/propagator/navigator.hpp"
+#include "detray/propagator/rk_stepper.hpp"
+
 // VecMem include(s).
 #include <vecmem/memory/memory_resource.hpp>
 
+// System include(s).
+#include <functional>
+
 namespace traccc {
 
 /// Algorithm performing the full chain of track reconstruction
 ///
 /// At least as much as is implemented in the project at any given moment.
 ///
+/// The track finding and fitting are only run when a Detray detector is
+/// given to the algorithm. The detector is only read by the algorithm, so
+/// the algorithms used by different threads can all share the same one.
+///
 class full_chain_algorithm
-    : public algorithm<bound_track_parameters_collection_types::host(
+    : public algorithm<track_state_container_types::host(
           const cell_collection_types::host&,
           const cell_module_collection_types::host&)> {
 
     public:
+    /// @name Type declaration(s)
+    /// @{
+
+    /// (Host) Detector type used during track finding and fitting
+    using host_detector_type = detray::detector<detray::default_metadata,
+                                                detray::host_container_types>;
+
+    /// Magnetic field type
+    using bfield_type = covfie::field<detray::bfield::const_bknd_t>;
+    /// Stepper type used by the track finding and fitting algorithms
+    using stepper_type =
+        detray::rk_stepper<bfield_type::view_t,
+                           typename host_detector_type::transform3,
+                           detray::constrained_step<>>;
+    /// Navigator type used by the track finding and fitting algorithms
+    using navigator_type = detray::navigator<const host_detector_type>;
+
+    /// Track finding algorithm type
+    using finding_algorithm =
+        traccc::finding_algorithm<stepper_type, navigator_type>;
+    /// Track fitting algorithm type
+    using fitting_algorithm = traccc::fitting_algorithm<
+        traccc::kalman_fitter<stepper_type, navigator_type>>;
+
+    /// @}
+
     /// Algorithm constructor
     ///
     /// @param mr The memory resource to use for the intermediate and result
     ///           objects
     /// @param dummy This is not used anywhere. Allows templating CPU/Device
     /// algorithm.
+    /// @param detector The detector to run the track finding and fitting on
+    ///                 (no track finding and fitting is done without one)
     ///
 
     full_chain_algorithm(vecmem::memory_resource& mr, unsigned int dummy,
                          const seedfinder_config& finder_config,
                          const spacepoint_grid_config& grid_config,
-                         const seedfilter_config& filter_config);
+                         const seedfilter_config& filter_config,
+                         const host_detector_type* detector = nullptr);
 
-    /// Reconstruct track parameters in the entire detector
+    /// Reconstruct tracks in the entire detector
     ///
     /// @param cells The cells for every detector module in the event
-    /// @return The track parameters reconstructed
+    /// @return The fitted tracks, or an empty container if no detector was
+    ///         given to the algorithm
     ///
     output_type operator()(
         const cell_collection_types::host& cells,
         const cell_module_collection_types::host& modules) const override;
 
+    /// @name Individual stages of the chain
+    ///
+    /// They allow a scheduler to run the stages of one event on different
+    /// threads, one after the other. One algorithm object must still only be
+    /// used by one thread at a time.
+    ///
+    /// @{
+
+    /// Run the clusterization of the cells of an event
+    measurement_collection_types::host clusterize(
+        const cell_collection_types::host& cells,
+        const cell_module_collection_types::host& modules) const;
+    /// Form the spacepoints of the measurements of an event
+    spacepoint_collection_types::host form_spacepoints(
+        const measurement_collection_types::host& measurements,
+        const cell_module_collection_types::host& modules) const;
+    /// Find the seeds of an event, and estimate their track parameters
+    bound_track_parameters_collection_types::host seed(
+        const spacepoint_collection_types::host& spacepoints) const;
+    /// Find the tracks of an event, with their filtered track states
+    ///
+    /// The ambiguities between the found tracks are resolved before they
+    /// are returned. May only be called if @c runs_tracking() is true. It
+    /// sorts the measurements by surface if they are not sorted yet.
+    ///
+    track_state_container_types::host find_tracks(
+        measurement_collection_types::host& measurements,
+        const bound_track_parameters_collection_types::host& track_params)
+        const;
+    /// Fit (smooth) the tracks found by @c find_tracks
+    ///
+    /// May only be called if @c runs_tracking() is true.
+    ///
+    output_type fit_tracks(
+        track_state_container_types::host&& track_states) const;
+
+    /// Whether the algorithm runs the track finding and fitting
+    bool runs_tracking() const { return m_detector != nullptr; }
+
+    /// @}
+
+    /// Record the time spent in the individual stages of the chain
+    ///
+    /// @param acc The accumulator to record the stage times into. It must
+    ///            not be shared with algorithms used by other threads.
+    ///
+    void set_stage_timing(performance::stage_timing::accumulator& acc);
+
+    /// Record the stages of the chain into a trace
+    ///
+    /// @param buf The trace buffer to record the stages into. It must not
+    ///            be shared with algorithms used by other threads.
+    ///
+    void set_trace_buffer(performance::trace_recorder::buffer& buf);
+
     private:
     /// @name Sub-algorithms used by this full-chain algorithm
     /// @{
@@ -60,10 +168,21 @@ class full_chain_algorithm
     clusterization_algorithm m_clusterization;
     /// Spacepoint formation algorithm
     spacepoint_formation m_spacepoint_formation;
-    /// Seeding algorithm
-    seeding_algorithm m_seeding;
+    /// Spacepoint binning algorithm
+    spacepoint_binning m_spacepoint_binning;
+    /// Seed finding algorithm
+    seed_finding m_seed_finding;
+    /// Seed deduplication algorithm (only used if enabled in the seed
+    /// filter configuration)
+    seed_deduplication m_seed_deduplication;
     /// Track parameter estimation algorithm
     track_params_estimation m_track_parameter_estimation;
+    /// Track finding algorithm
+    finding_algorithm m_finding;
+    /// Ambiguity resolution algorithm
+    greedy_ambiguity_resolution_algorithm m_ambiguity_resolution;
+    /// Track fitting algorithm
+    fitting_algorithm m_fitting;
 
     /// Configs
     seedfinder_config m_finder_config;
@@ -72,6 +191,18 @@ class full_chain_algorithm
 
     /// @}
 
+    /// Memory resource used for the intermediate and result objects
+    std::reference_wrapper<vecmem::memory_resource> m_mr;
+    /// The detector used by the track finding and fitting (optional)
+    const host_detector_type* m_detector;
+    /// The magnetic field used by the track finding and fitting
+    bfield_type m_field;
+
+    /// Accumulator of the stage times (optional)
+    performance::stage_timing::accumulator* m_stage_timing = nullptr;
+    /// Trace buffer of the stages (optional)
+    performance::trace_recorder::buffer* m_trace = nullptr;
+
 };  // class full_chain_algorithm
 
 }  // namespace traccc
@@ -16,8 +16,10 @@
 #include "traccc/io/utils.hpp"
 
 // algorithms
+#include "traccc/ambiguity_resolution/greedy_ambiguity_resolution_algorithm.hpp"
 #include "traccc/finding/finding_algorithm.hpp"
 #include "traccc/fitting/fitting_algorithm.hpp"
+#include "traccc/seeding/seed_deduplication.hpp"
 #include "traccc/seeding/seeding_algorithm.hpp"
 #include "traccc/seeding/track_params_estimation.hpp"
 
@@ -52,7 +54,7 @@
 using namespace traccc;
 namespace po = boost::program_options;
 
-int seq_run(const traccc::seeding_input_config& /*i_cfg*/,
+int seq_run(const traccc::seeding_input_config& i_cfg,
             const traccc::finding_input_config& finding_cfg,
             const traccc::propagation_options<traccc::scalar>& propagation_opts,
             const traccc::common_options& common_opts,
@@ -85,7 +87,9 @@ int seq_run(const traccc::seeding_input_config& /*i_cfg*/,
     uint64_t n_spacepoints = 0;
     uint64_t n_measurements = 0;
     uint64_t n_seeds = 0;
+    uint64_t n_unique_seeds = 0;
     uint64_t n_found_tracks = 0;
+    uint64_t n_resolved_tracks = 0;
     uint64_t n_fitted_tracks = 0;
 
     /*****************************
@@ -117,9 +121,11 @@ int seq_run(const traccc::seeding_input_config& /*i_cfg*/,
     traccc::seedfinder_config finder_config;
     traccc::spacepoint_grid_config grid_config(finder_config);
     traccc::seedfilter_config filter_config;
+    filter_config.deduplicate_seeds = i_cfg.deduplicate_seeds;
 
     traccc::seeding_algorithm sa(finder_config, grid_config, filter_config,
                                  host_mr);
+    traccc::seed_deduplication sd(host_mr);
     traccc::track_params_estimation tp(host_mr);
 
     // Finding algorithm configuration
@@ -131,7 +137,11 @@ int seq_run(const traccc::seeding_input_config& /*i_cfg*/,
     cfg.constrained_step_size = propagation_opts.step_constraint;
 
     traccc::finding_algorithm<rk_stepper_type, host_navigator_type>
-        host_finding(cfg);
+        host_finding(cfg, host_mr);
+
+    // Ambiguity resolution algorithm object
+    traccc::greedy_ambiguity_resolution_algorithm host_ambiguity_resolution(
+        traccc::ambiguity_resolution_config{}, host_mr);
 
     // Fitting algorithm object
     typename traccc::fitting_algorithm<host_fitter_type>::config_type fit_cfg;
@@ -156,15 +166,27 @@ int seq_run(const traccc::seeding_input_config& /*i_cfg*/,
 
         auto seeds = sa(spacepoints_per_event);
 
+        /*----------------------
+           Seed Deduplication
+          ----------------------*/
+
+        traccc::seed_collection_types::host unique_seeds{&host_mr};
+        if (filter_config.deduplicate_seeds) {
+            unique_seeds = sd(seeds);
+        }
+        const traccc::seed_collection_types::host& selected_seeds =
+            (filter_config.deduplicate_seeds ? unique_seeds : seeds);
+
         /*----------------------------
            Track Parameter Estimation
           ----------------------------*/
 
-        auto params = tp(spacepoints_per_event, seeds,
+        auto params = tp(spacepoints_per_event, selected_seeds,
                          {0.f, 0.f, finder_config.bFieldInZ});
 
         // Run CKF and KF if we are using a detray geometry
         traccc::track_candidate_container_types::host track_candidates;
+        traccc::track_candidate_container_types::host resolved_track_candidates;
         traccc::track_state_container_types::host track_states;
 
         // Read measurements
@@ -184,11 +206,18 @@ int seq_run(const traccc::seeding_input_config& /*i_cfg*/,
             host_finding(host_det, field, measurements_per_event, params);
         n_found_tracks += track_candidates.size();
 
+        /*------------------------
+           Ambiguity Resolution
+          ------------------------*/
+
+        resolved_track_candidates = host_ambiguity_resolution(track_candidates);
+        n_resolved_tracks += resolved_track_candidates.size();
+
         /*------------------------
            Track Fitting with KF
           ------------------------*/
 
-        track_states = host_fitting(host_det, field, track_candidates);
+        track_states = host_fitting(host_det, field, resolved_track_candidates);
         n_fitted_tracks += track_states.size();
 
         /*------------
@@ -197,6 +226,7 @@ int seq_run(const traccc::seeding_input_config& /*i_cfg*/,
 
         n_spacepoints += spacepoints_per_event.size();
         n_seeds += seeds.size();
+        n_unique_seeds += selected_seeds.size();
 
         /*------------
           Writer
@@ -235,8 +265,14 @@ int seq_run(const traccc::seeding_input_config& /*i_cfg*/,
     std::cout << "- read    " << n_spacepoints << " spacepoints" << std::endl;
     std::cout << "- read    " << n_measurements << " measurements" << std::endl;
     std::cout << "- created (cpu)  " << n_seeds << " seeds" << std::endl;
+    if (filter_config.deduplicate_seeds) {
+        std::cout << "- kept    (cpu)  " << n_unique_seeds
+                  << " non-overlapping seeds" << std::endl;
+    }
     std::cout << "- created (cpu)  " << n_found_tracks << " found tracks"
               << std::endl;
+    std::cout << "- created (cpu)  " << n_resolved_tracks
+              << " ambiguity-free tracks" << std::endl;
     std::cout << "- created (cpu)  " << n_fitted_tracks << " fitted tracks"
               << std::endl;
 
@@ -273,6 +309,7 @@ int main(int argc, char* argv[]) {
     std::cout << "Running " << argv[0] << " " << det_opts.detector_file << " "
               << common_opts.input_directory << " " << common_opts.events
               << std::endl;
+    std::cout << seeding_input_cfg << std::endl;
 
     return seq_run(seeding_input_cfg, finding_input_cfg, propagation_opts,
                    common_opts, det_opts);
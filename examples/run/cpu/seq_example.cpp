@@ -13,30 +13,48 @@
 // algorithms
 #include "traccc/clusterization/clusterization_algorithm.hpp"
 #include "traccc/clusterization/spacepoint_formation.hpp"
+#include "traccc/seeding/seed_deduplication.hpp"
 #include "traccc/seeding/seeding_algorithm.hpp"
 #include "traccc/seeding/track_params_estimation.hpp"
 
 // performance
 #include "traccc/efficiency/seeding_performance_writer.hpp"
+#include "traccc/performance/trace_recorder.hpp"
 
 // options
 #include "traccc/options/common_options.hpp"
 #include "traccc/options/detector_input_options.hpp"
 #include "traccc/options/full_tracking_input_options.hpp"
 #include "traccc/options/handle_argument_errors.hpp"
+#include "traccc/options/seeding_input_options.hpp"
+#include "traccc/options/trace_options.hpp"
 
 // VecMem include(s).
 #include <vecmem/memory/host_memory_resource.hpp>
 
 // System include(s).
 #include <exception>
+#include <fstream>
 #include <iostream>
 
 namespace po = boost::program_options;
 
 int seq_run(const traccc::full_tracking_input_config& i_cfg,
+            const traccc::seeding_input_config& seeding_cfg,
             const traccc::common_options& common_opts,
-            const traccc::detector_input_options& det_opts) {
+            const traccc::detector_input_options& det_opts,
+            const traccc::trace_options& trace_opts) {
+
+    // Set up the (optional) trace of the processing
+    traccc::performance::trace_recorder trace{trace_opts.trace_buffer_size};
+    traccc::performance::trace_recorder::buffer* trace_buffer =
+        trace_opts.trace_file.empty() ? nullptr : &trace.make_buffer(0);
+
+    // Run an algorithm in a (traced) span
+    auto traced = [trace_buffer](const char* name, auto&& func) {
+        traccc::performance::trace_recorder::scope span{trace_buffer, name};
+        return func();
+    };
 
     // Read the surface transforms
     auto surface_transforms = traccc::io::read_geometry(det_opts.detector_file);
@@ -51,11 +69,13 @@ int seq_run(const traccc::full_tracking_input_config& i_cfg,
     uint64_t n_measurements = 0;
     uint64_t n_spacepoints = 0;
     uint64_t n_seeds = 0;
+    uint64_t n_unique_seeds = 0;
 
     // Configs
     traccc::seedfinder_config finder_config;
     traccc::spacepoint_grid_config grid_config(finder_config);
     traccc::seedfilter_config filter_config;
+    filter_config.deduplicate_seeds = seeding_cfg.deduplicate_seeds;
 
     // Memory resource used by the EDM.
     vecmem::host_memory_resource host_mr;
@@ -64,6 +84,7 @@ int seq_run(const traccc::full_tracking_input_config& i_cfg,
     traccc::spacepoint_formation sf(host_mr);
     traccc::seeding_algorithm sa(finder_config, grid_config, filter_config,
                                  host_mr);
+    traccc::seed_deduplication sd(host_mr);
     traccc::track_params_estimation tp(host_mr);
 
     // performance writer
@@ -74,12 +95,18 @@ int seq_run(const traccc::full_tracking_input_config& i_cfg,
     for (unsigned int event = common_opts.skip;
          event < common_opts.events + common_opts.skip; ++event) {
 
+        if (trace_buffer != nullptr) {
+            trace_buffer->set_event(event);
+        }
+
         traccc::io::cell_reader_output readOut(&host_mr);
 
         // Read the cells from the relevant event file
-        traccc::io::read_cells(readOut, event, common_opts.input_directory,
-                               common_opts.input_data_format,
-                               &surface_transforms, &digi_cfg);
+        traced("Cell reading", [&]() {
+            traccc::io::read_cells(readOut, event, common_opts.input_directory,
+                                   common_opts.input_data_format,
+                                   &surface_transforms, &digi_cfg);
+        });
         traccc::cell_collection_types::host& cells_per_event = readOut.cells;
         traccc::cell_module_collection_types::host& modules_per_event =
             readOut.modules;
@@ -88,27 +115,45 @@ int seq_run(const traccc::full_tracking_input_config& i_cfg,
             Clusterization
           -------------------*/
 
-        auto measurements_per_event = ca(cells_per_event, modules_per_event);
+        auto measurements_per_event = traced("Clusterization", [&]() {
+            return ca(cells_per_event, modules_per_event);
+        });
 
         /*------------------------
             Spacepoint formation
           ------------------------*/
 
-        auto spacepoints_per_event =
-            sf(measurements_per_event, modules_per_event);
+        auto spacepoints_per_event = traced("Spacepoint formation", [&]() {
+            return sf(measurements_per_event, modules_per_event);
+        });
 
         /*-----------------------
           Seeding algorithm
           -----------------------*/
 
-        auto seeds = sa(spacepoints_per_event);
+        auto seeds =
+            traced("Seeding", [&]() { return sa(spacepoints_per_event); });
+
+        /*-----------------------
+          Seed deduplication
+          -----------------------*/
+
+        traccc::seed_collection_types::host unique_seeds{&host_mr};
+        if (filter_config.deduplicate_seeds) {
+            unique_seeds =
+                traced("Seed deduplication", [&]() { return sd(seeds); });
+        }
+        const traccc::seed_collection_types::host& selected_seeds =
+            (filter_config.deduplicate_seeds ? unique_seeds : seeds);
 
         /*----------------------------
           Track params estimation
           ----------------------------*/
 
-        auto params = tp(spacepoints_per_event, seeds,
-                         {0.f, 0.f, finder_config.bFieldInZ});
+        auto params = traced("Track parameter estimation", [&]() {
+            return tp(spacepoints_per_event, selected_seeds,
+                      {0.f, 0.f, finder_config.bFieldInZ});
+        });
 
         /*----------------------------
           Statistics
@@ -119,6 +164,7 @@ int seq_run(const traccc::full_tracking_input_config& i_cfg,
         n_measurements += measurements_per_event.size();
         n_spacepoints += spacepoints_per_event.size();
         n_seeds += seeds.size();
+        n_unique_seeds += selected_seeds.size();
 
         /*------------
              Writer
@@ -140,6 +186,11 @@ int seq_run(const traccc::full_tracking_input_config& i_cfg,
         sd_performance_writer.finalize();
     }
 
+    if (trace_buffer != nullptr) {
+        std::ofstream trace_file(trace_opts.trace_file);
+        trace.write_json(trace_file);
+    }
+
     std::cout << "==> Statistics ... " << std::endl;
     std::cout << "- read    " << n_cells << " cells from " << n_modules
               << " modules" << std::endl;
@@ -148,6 +199,10 @@ int seq_run(const traccc::full_tracking_input_config& i_cfg,
     std::cout << "- created " << n_spacepoints << " space points. "
               << std::endl;
     std::cout << "- created " << n_seeds << " seeds" << std::endl;
+    if (filter_config.deduplicate_seeds) {
+        std::cout << "- kept    " << n_unique_seeds
+                  << " non-overlapping seeds" << std::endl;
+    }
 
     return 0;
 }
@@ -163,6 +218,8 @@ int main(int argc, char* argv[]) {
     traccc::common_options common_opts(desc);
     traccc::detector_input_options det_opts(desc);
     traccc::full_tracking_input_config full_tracking_input_cfg(desc);
+    traccc::seeding_input_config seeding_input_cfg(desc);
+    traccc::trace_options trace_opts(desc);
 
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -174,11 +231,15 @@ int main(int argc, char* argv[]) {
     common_opts.read(vm);
     det_opts.read(vm);
     full_tracking_input_cfg.read(vm);
+    seeding_input_cfg.read(vm);
+    trace_opts.read(vm);
 
     std::cout << "Running " << argv[0] << " "
               << full_tracking_input_cfg.detector_file << " "
               << common_opts.input_directory << " " << common_opts.events
               << std::endl;
+    std::cout << seeding_input_cfg << std::endl;
 
-    return seq_run(full_tracking_input_cfg, common_opts, det_opts);
+    return seq_run(full_tracking_input_cfg, seeding_input_cfg, common_opts,
+                   det_opts, trace_opts);
 }
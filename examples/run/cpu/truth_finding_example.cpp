@@ -17,10 +17,12 @@
 #include "traccc/io/utils.hpp"
 #include "traccc/options/common_options.hpp"
 #include "traccc/options/detector_input_options.hpp"
+#include "traccc/options/field_map_options.hpp"
 #include "traccc/options/finding_input_options.hpp"
 #include "traccc/options/handle_argument_errors.hpp"
 #include "traccc/options/propagation_options.hpp"
 #include "traccc/resolution/fitting_performance_writer.hpp"
+#include "traccc/utils/cached_field_map.hpp"
 #include "traccc/utils/seed_generator.hpp"
 
 // Detray include(s).
@@ -43,18 +45,24 @@
 using namespace traccc;
 namespace po = boost::program_options;
 
+/// Run the finding and fitting, propagating through a given magnetic field
+///
+/// @tparam field_view_t The magnetic field (view) type of the stepper
+/// @param field The magnetic field, convertible to @c field_view_t
+///
+template <typename field_view_t, typename field_t>
 int seq_run(const traccc::finding_input_config& i_cfg,
             const traccc::propagation_options<scalar>& propagation_opts,
             const traccc::common_options& common_opts,
-            const traccc::detector_input_options& det_opts) {
+            const traccc::detector_input_options& det_opts,
+            const field_t& field) {
 
     /// Type declarations
     using host_detector_type = detray::detector<detray::default_metadata,
                                                 detray::host_container_types>;
 
-    using b_field_t = covfie::field<detray::bfield::const_bknd_t>;
     using rk_stepper_type =
-        detray::rk_stepper<b_field_t::view_t, traccc::transform3,
+        detray::rk_stepper<field_view_t, traccc::transform3,
                            detray::constrained_step<>>;
 
     using host_navigator_type = detray::navigator<const host_detector_type>;
@@ -74,11 +82,6 @@ int seq_run(const traccc::finding_input_config& i_cfg,
      * Build a geometry
      *****************************/
 
-    // B field value and its type
-    // @TODO: Set B field as argument
-    const traccc::vector3 B{0, 0, 2 * detray::unit<traccc::scalar>::T};
-    auto field = detray::bfield::create_const_field(B);
-
     // Read the detector
     detray::io::detector_reader_config reader_cfg{};
     reader_cfg.add_file(traccc::io::data_directory() + det_opts.detector_file);
@@ -119,7 +122,7 @@ int seq_run(const traccc::finding_input_config& i_cfg,
 
     // Finding algorithm object
     traccc::finding_algorithm<rk_stepper_type, host_navigator_type>
-        host_finding(cfg);
+        host_finding(cfg, host_mr);
 
     // Fitting algorithm object
     typename traccc::fitting_algorithm<host_fitter_type>::config_type fit_cfg;
@@ -206,6 +209,7 @@ int main(int argc, char* argv[]) {
     traccc::detector_input_options det_opts(desc);
     traccc::finding_input_config finding_input_cfg(desc);
     traccc::propagation_options<scalar> propagation_opts(desc);
+    traccc::field_map_options field_map_opts(desc);
 
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -218,9 +222,35 @@ int main(int argc, char* argv[]) {
     det_opts.read(vm);
     finding_input_cfg.read(vm);
     propagation_opts.read(vm);
+    field_map_opts.read(vm);
 
     std::cout << "Running " << argv[0] << " " << common_opts.input_directory
               << " " << common_opts.events << std::endl;
+    std::cout << field_map_opts << std::endl;
+
+    // B field value and its type
+    // @TODO: Set B field as argument
+    const traccc::vector3 B{0, 0, 2 * detray::unit<traccc::scalar>::T};
+    auto field = detray::bfield::create_const_field(B);
+    using b_field_t = decltype(field);
+
+    if (!field_map_opts.use_cached_map) {
+        return seq_run<b_field_t::view_t>(finding_input_cfg, propagation_opts,
+                                          common_opts, det_opts, field);
+    }
 
-    return seq_run(finding_input_cfg, propagation_opts, common_opts, det_opts);
+    // Sample the field onto a cached grid map, and propagate through that
+    const traccc::cached_field_map field_map(
+        b_field_t::view_t(field),
+        {-field_map_opts.half_length_xy, -field_map_opts.half_length_xy,
+         -field_map_opts.half_length_z},
+        {field_map_opts.half_length_xy, field_map_opts.half_length_xy,
+         field_map_opts.half_length_z},
+        field_map_opts.n_bins);
+    const int result = seq_run<traccc::cached_field_map::view_t>(
+        finding_input_cfg, propagation_opts, common_opts, det_opts,
+        field_map);
+    std::cout << "Field map lookups: " << field_map.n_lookups()
+              << ", cell loads: " << field_map.n_cell_loads() << std::endl;
+    return result;
 }
@@ -32,7 +32,7 @@ full_chain_algorithm::full_chain_algorithm(
     const unsigned short target_cells_per_partition,
     const seedfinder_config& finder_config,
     const spacepoint_grid_config& grid_config,
-    const seedfilter_config& filter_config)
+    const seedfilter_config& filter_config, const host_detector_type*)
     : m_host_mr(host_mr),
       m_stream(),
       m_device_mr(),
@@ -45,6 +45,7 @@ full_chain_algorithm::full_chain_algorithm(
       m_seeding(finder_config, grid_config, filter_config,
                 memory_resource{*m_cached_device_mr, &m_host_mr}, m_copy,
                 m_stream),
+      m_seed_deduplication(m_host_mr),
       m_track_parameter_estimation(
           memory_resource{*m_cached_device_mr, &m_host_mr}, m_copy, m_stream),
       m_finder_config(finder_config),
@@ -74,6 +75,7 @@ full_chain_algorithm::full_chain_algorithm(const full_chain_algorithm& parent)
       m_seeding(
           parent.m_finder_config, parent.m_grid_config, parent.m_filter_config,
           memory_resource{*m_cached_device_mr, &m_host_mr}, m_copy, m_stream),
+      m_seed_deduplication(m_host_mr),
       m_track_parameter_estimation(
           memory_resource{*m_cached_device_mr, &m_host_mr}, m_copy, m_stream),
       m_finder_config(parent.m_finder_config),
@@ -91,29 +93,86 @@ full_chain_algorithm::output_type full_chain_algorithm::operator()(
     const cell_collection_types::host& cells,
     const cell_module_collection_types::host& modules) const {
 
+    using performance::stage;
+    using scope = performance::stage_timing::scope;
+
+    // Wait for the end of a stage, if the stages are being timed or traced
+    auto end_stage = [this]() {
+        if ((m_stage_timing != nullptr) || (m_trace != nullptr)) {
+            m_stream.synchronize();
+        }
+    };
+
     // Create device copy of input collections
     cell_collection_types::buffer cells_buffer(cells.size(),
                                                *m_cached_device_mr);
-    m_copy(vecmem::get_data(cells), cells_buffer);
     cell_module_collection_types::buffer modules_buffer(modules.size(),
                                                         *m_cached_device_mr);
-    m_copy(vecmem::get_data(modules), modules_buffer);
+    {
+        scope t{m_stage_timing, stage::data_transfer, m_trace};
+        m_copy(vecmem::get_data(cells), cells_buffer);
+        m_copy(vecmem::get_data(modules), modules_buffer);
+        end_stage();
+    }
 
     // Run the clusterization (asynchronously).
-    const clusterization_algorithm::output_type spacepoints =
-        m_clusterization(cells_buffer, modules_buffer);
-    const track_params_estimation::output_type track_params =
-        m_track_parameter_estimation(spacepoints.first,
-                                     m_seeding(spacepoints.first),
-                                     {0.f, 0.f, m_finder_config.bFieldInZ});
+    const clusterization_algorithm::output_type spacepoints = [&]() {
+        scope t{m_stage_timing, stage::clusterization, m_trace};
+        auto result = m_clusterization(cells_buffer, modules_buffer);
+        end_stage();
+        return result;
+    }();
+    const seeding_algorithm::output_type seeds = [&]() {
+        scope t{m_stage_timing, stage::seeding, m_trace};
+        auto result = m_seeding(spacepoints.first);
+        end_stage();
+        if (!m_filter_config.deduplicate_seeds) {
+            return result;
+        }
+
+        // Remove the overlapping seeds on the host
+        seed_collection_types::host seeds_host(&m_host_mr);
+        m_copy(result, seeds_host);
+        m_stream.synchronize();
+        const seed_collection_types::host unique_seeds =
+            m_seed_deduplication(seeds_host);
+        result = seeding_algorithm::output_type(
+            static_cast<unsigned int>(unique_seeds.size()),
+            *m_cached_device_mr);
+        m_copy(vecmem::get_data(unique_seeds), result);
+        m_stream.synchronize();
+        return result;
+    }();
+    const track_params_estimation::output_type track_params = [&]() {
+        scope t{m_stage_timing, stage::track_params_estimation, m_trace};
+        auto result = m_track_parameter_estimation(
+            spacepoints.first, seeds, {0.f, 0.f, m_finder_config.bFieldInZ});
+        end_stage();
+        return result;
+    }();
 
     // Get the final data back to the host.
     bound_track_parameters_collection_types::host result(&m_host_mr);
-    m_copy(track_params, result);
-    m_stream.synchronize();
+    {
+        scope t{m_stage_timing, stage::data_transfer, m_trace};
+        m_copy(track_params, result);
+        m_stream.synchronize();
+    }
 
     // Return the host container.
     return result;
 }
 
+void full_chain_algorithm::set_stage_timing(
+    performance::stage_timing::accumulator& acc) {
+
+    m_stage_timing = &acc;
+}
+
+void full_chain_algorithm::set_trace_buffer(
+    performance::trace_recorder::buffer& buf) {
+
+    m_trace = &buf;
+}
+
 }  // namespace traccc::cuda
@@ -14,8 +14,15 @@
 #include "traccc/cuda/utils/stream.hpp"
 #include "traccc/device/container_h2d_copy_alg.hpp"
 #include "traccc/edm/cell.hpp"
+#include "traccc/performance/stage_timing.hpp"
+#include "traccc/performance/trace_recorder.hpp"
+#include "traccc/seeding/seed_deduplication.hpp"
 #include "traccc/utils/algorithm.hpp"
 
+// Detray include(s).
+#include "detray/core/detector.hpp"
+#include "detray/core/detector_metadata.hpp"
+
 // VecMem include(s).
 #include <vecmem/memory/binary_page_memory_resource.hpp>
 #include <vecmem/memory/cuda/device_memory_resource.hpp>
@@ -37,18 +44,25 @@ class full_chain_algorithm
           const cell_module_collection_types::host&)> {
 
     public:
+    /// (Host) Detector type used during track finding and fitting
+    using host_detector_type = detray::detector<detray::default_metadata,
+                                                detray::host_container_types>;
+
     /// Algorithm constructor
     ///
     /// @param mr The memory resource to use for the intermediate and result
     ///           objects
     /// @param target_cells_per_partition The average number of cells in each
     /// partition.
+    /// @param detector Not used, as this chain does not run the track finding
+    /// and fitting yet. Allows templating CPU/Device algorithm.
     ///
     full_chain_algorithm(vecmem::memory_resource& host_mr,
                          const unsigned short target_cells_per_partiton,
                          const seedfinder_config& finder_config,
                          const spacepoint_grid_config& grid_config,
-                         const seedfilter_config& filter_config);
+                         const seedfilter_config& filter_config,
+                         const host_detector_type* detector = nullptr);
 
     /// Copy constructor
     ///
@@ -72,6 +86,26 @@ class full_chain_algorithm
         const cell_collection_types::host& cells,
         const cell_module_collection_types::host& modules) const override;
 
+    /// Record the time spent in the individual stages of the chain
+    ///
+    /// To attribute the time of the asynchronously executed stages, the
+    /// algorithm waits for the end of every stage while it is recording.
+    ///
+    /// @param acc The accumulator to record the stage times into. It must
+    ///            not be shared with algorithms used by other threads.
+    ///
+    void set_stage_timing(performance::stage_timing::accumulator& acc);
+
+    /// Record the stages of the chain into a trace
+    ///
+    /// Like for the stage timing, the algorithm waits for the end of every
+    /// stage while it is recording.
+    ///
+    /// @param buf The trace buffer to record the stages into. It must not
+    ///            be shared with algorithms used by other threads.
+    ///
+    void set_trace_buffer(performance::trace_recorder::buffer& buf);
+
     private:
     /// Host memory resource
     vecmem::memory_resource& m_host_mr;
@@ -94,6 +128,13 @@ class full_chain_algorithm
     clusterization_algorithm m_clusterization;
     /// Seeding algorithm
     seeding_algorithm m_seeding;
+    /// Seed deduplication algorithm (only used if enabled in the seed
+    /// filter configuration)
+    ///
+    /// It has no device implementation yet, so the seeds are copied to the
+    /// host and back for it.
+    ///
+    traccc::seed_deduplication m_seed_deduplication;
     /// Track parameter estimation algorithm
     track_params_estimation m_track_parameter_estimation;
 
@@ -104,6 +145,11 @@ class full_chain_algorithm
 
     /// @}
 
+    /// Accumulator of the stage times (optional)
+    performance::stage_timing::accumulator* m_stage_timing = nullptr;
+    /// Trace buffer of the stages (optional)
+    performance::trace_recorder::buffer* m_trace = nullptr;
+
 };  // class full_chain_algorithm
 
 }  // namespace traccc::cuda
@@ -13,6 +13,7 @@
 #include "traccc/definitions/common.hpp"
 #include "traccc/device/container_d2h_copy_alg.hpp"
 #include "traccc/device/container_h2d_copy_alg.hpp"
+#include "traccc/edm/fitted_track_state.hpp"
 #include "traccc/efficiency/finding_performance_writer.hpp"
 #include "traccc/efficiency/nseed_performance_writer.hpp"
 #include "traccc/efficiency/seeding_performance_writer.hpp"
@@ -157,6 +158,10 @@ int seq_run(const traccc::seeding_input_config& /*i_cfg*/,
     traccc::device::container_d2h_copy_alg<traccc::track_state_container_types>
         track_state_d2h{mr, copy};
 
+    traccc::device::container_d2h_copy_alg<
+        traccc::fitted_track_state_container_types>
+        fitted_state_d2h{mr, copy};
+
     // Seeding algorithm
     traccc::seedfinder_config finder_config;
     traccc::spacepoint_grid_config grid_config(finder_config);
@@ -369,9 +374,9 @@ int seq_run(const traccc::seeding_input_config& /*i_cfg*/,
         traccc::track_candidate_container_types::host track_candidates_cuda =
             track_candidate_d2h(track_candidates_cuda_buffer);
 
-        // Copy track states from device to host
-        traccc::track_state_container_types::host track_states_cuda =
-            track_state_d2h(track_states_cuda_buffer);
+        // Copy the compact fit results from device to host
+        traccc::fitted_track_state_container_types::host fitted_states_cuda =
+            fitted_state_d2h(device_fitting.compact(track_states_cuda_buffer));
 
         if (run_cpu) {
             // Show which event we are currently presenting the results for.
@@ -421,7 +426,7 @@ int seq_run(const traccc::seeding_input_config& /*i_cfg*/,
         n_seeds += seeds.size();
         n_found_tracks_cuda += track_candidates_cuda.size();
         n_found_tracks += track_candidates.size();
-        n_fitted_tracks_cuda += track_states_cuda.size();
+        n_fitted_tracks_cuda += fitted_states_cuda.size();
         n_fitted_tracks += track_states.size();
 
         /*------------
@@ -439,6 +444,10 @@ int seq_run(const traccc::seeding_input_config& /*i_cfg*/,
             find_performance_writer.write(
                 traccc::get_data(track_candidates_cuda), evt_map);
 
+            // The performance histograms need the full track states
+            const traccc::track_state_container_types::host track_states_cuda =
+                track_state_d2h(track_states_cuda_buffer);
+
             for (unsigned int i = 0; i < track_states_cuda.size(); i++) {
                 const auto& trk_states_per_track =
                     track_states_cuda.at(i).items;
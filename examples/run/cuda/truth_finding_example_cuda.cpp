@@ -13,6 +13,7 @@
 #include "traccc/definitions/primitives.hpp"
 #include "traccc/device/container_d2h_copy_alg.hpp"
 #include "traccc/device/container_h2d_copy_alg.hpp"
+#include "traccc/edm/fitted_track_state.hpp"
 #include "traccc/efficiency/finding_performance_writer.hpp"
 #include "traccc/finding/finding_algorithm.hpp"
 #include "traccc/fitting/fitting_algorithm.hpp"
@@ -141,6 +142,10 @@ int seq_run(const traccc::finding_input_config& i_cfg,
     traccc::device::container_d2h_copy_alg<traccc::track_state_container_types>
         track_state_d2h{mr, async_copy};
 
+    traccc::device::container_d2h_copy_alg<
+        traccc::fitted_track_state_container_types>
+        fitted_state_d2h{mr, async_copy};
+
     // Standard deviations for seed track parameters
     static constexpr std::array<traccc::scalar, traccc::e_bound_size> stddevs =
         {1e-4 * detray::unit<traccc::scalar>::mm,
@@ -254,8 +259,10 @@ int seq_run(const traccc::finding_input_config& i_cfg,
                 device_fitting(det_view, field, navigation_buffer,
                                track_candidates_cuda_buffer);
         }
-        traccc::track_state_container_types::host track_states_cuda =
-            track_state_d2h(track_states_cuda_buffer);
+
+        // Only copy the compact fit results back to the host
+        traccc::fitted_track_state_container_types::host fitted_states_cuda =
+            fitted_state_d2h(device_fitting.compact(track_states_cuda_buffer));
 
         // CPU containers
         traccc::finding_algorithm<
@@ -308,19 +315,23 @@ int seq_run(const traccc::finding_input_config& i_cfg,
                 compare_fitter_infos{"fitted tracks"};
             compare_fitter_infos(
                 vecmem::get_data(track_states.get_headers()),
-                vecmem::get_data(track_states_cuda.get_headers()));
+                vecmem::get_data(fitted_states_cuda.get_headers()));
         }
 
         /// Statistics
         n_found_tracks += track_candidates.size();
         n_fitted_tracks += track_states.size();
         n_found_tracks_cuda += track_candidates_cuda.size();
-        n_fitted_tracks_cuda += track_states_cuda.size();
+        n_fitted_tracks_cuda += fitted_states_cuda.size();
 
         if (common_opts.check_performance) {
             find_performance_writer.write(
                 traccc::get_data(track_candidates_cuda), evt_map2);
 
+            // The performance histograms need the full track states
+            const traccc::track_state_container_types::host track_states_cuda =
+                track_state_d2h(track_states_cuda_buffer);
+
             for (unsigned int i = 0; i < track_states_cuda.size(); i++) {
                 const auto& trk_states_per_track =
                     track_states_cuda.at(i).items;
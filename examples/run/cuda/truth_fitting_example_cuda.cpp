@@ -12,6 +12,7 @@
 #include "traccc/definitions/primitives.hpp"
 #include "traccc/device/container_d2h_copy_alg.hpp"
 #include "traccc/device/container_h2d_copy_alg.hpp"
+#include "traccc/edm/fitted_track_state.hpp"
 #include "traccc/fitting/fitting_algorithm.hpp"
 #include "traccc/fitting/kalman_filter/kalman_fitter.hpp"
 #include "traccc/io/read_geometry.hpp"
@@ -156,6 +157,10 @@ int main(int argc, char* argv[]) {
     traccc::device::container_d2h_copy_alg<traccc::track_state_container_types>
         track_state_d2h{mr, async_copy};
 
+    traccc::device::container_d2h_copy_alg<
+        traccc::fitted_track_state_container_types>
+        fitted_state_d2h{mr, async_copy};
+
     /// Standard deviations for seed track parameters
     static constexpr std::array<scalar, e_bound_size> stddevs = {
         0.03 * detray::unit<scalar>::mm,
@@ -211,8 +216,9 @@ int main(int argc, char* argv[]) {
                                truth_track_candidates_cuda_buffer);
         }
 
-        traccc::track_state_container_types::host track_states_cuda =
-            track_state_d2h(track_states_cuda_buffer);
+        // Only copy the compact fit results back to the host
+        traccc::fitted_track_state_container_types::host fitted_states_cuda =
+            fitted_state_d2h(device_fitting.compact(track_states_cuda_buffer));
 
         // CPU container(s)
         traccc::fitting_algorithm<host_fitter_type>::output_type track_states;
@@ -238,14 +244,18 @@ int main(int argc, char* argv[]) {
                 compare_fitter_infos{"fitted tracks"};
             compare_fitter_infos(
                 vecmem::get_data(track_states.get_headers()),
-                vecmem::get_data(track_states_cuda.get_headers()));
+                vecmem::get_data(fitted_states_cuda.get_headers()));
         }
 
         // Statistics
         n_fitted_tracks += track_states.size();
-        n_fitted_tracks_cuda += track_states_cuda.size();
+        n_fitted_tracks_cuda += fitted_states_cuda.size();
 
         if (common_opts.check_performance) {
+            // The performance histograms need the full track states
+            const traccc::track_state_container_types::host track_states_cuda =
+                track_state_d2h(track_states_cuda_buffer);
+
             for (unsigned int i = 0; i < track_states_cuda.size(); i++) {
                 const auto& trk_states_per_track =
                     track_states_cuda.at(i).items;
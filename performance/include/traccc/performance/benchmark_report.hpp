@@ -0,0 +1,75 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Project include(s).
+#include "traccc/performance/latency_histogram.hpp"
+#include "traccc/performance/stage_timing.hpp"
+#include "traccc/performance/thread_scaling.hpp"
+#include "traccc/performance/timing_info.hpp"
+#include "traccc/utils/instrumented_memory_resource.hpp"
+
+// System include(s).
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace traccc::performance {
+
+/// Description of the results of a benchmark (throughput) job
+///
+/// It collects everything that is needed to compare the results of jobs run
+/// on different machines and with different builds, and writes them into a
+/// JSON document. The description of the host and of the build, and the
+/// peak memory usage of the process, are added automatically when writing
+/// the report.
+///
+struct benchmark_report {
+
+    /// Name of the application
+    std::string application;
+    /// Configuration of the job, as (name, value) pairs
+    std::vector<std::pair<std::string, std::string>> configuration;
+    /// Number of (CPU) threads used for the processing
+    std::size_t threads = 1;
+
+    /// Number of events processed in the measurement
+    std::size_t processed_events = 0;
+    /// Name of the timer measuring the processing of all events
+    std::string processing_timer = "Event processing";
+    /// Coarse timing information of the job
+    const timing_info* times = nullptr;
+    /// Per-stage timing information (optional)
+    const stage_timing* stage_times = nullptr;
+    /// Per-event latencies (optional)
+    const event_latency_recorder* latencies = nullptr;
+    /// Memory allocation profile of the stages (optional)
+    const memory_profile* allocations = nullptr;
+    /// Results of a thread-scaling sweep (optional)
+    const thread_scaling* scaling = nullptr;
+
+    /// Add a configuration parameter
+    template <typename T>
+    void add_configuration(std::string_view name, const T& value);
+
+};  // struct benchmark_report
+
+/// Write a benchmark report as JSON
+///
+/// @param out    The stream to write the report to
+/// @param report The report to write
+///
+void write_json(std::ostream& out, const benchmark_report& report);
+
+}  // namespace traccc::performance
+
+// Include the implementation.
+#include "traccc/performance/impl/benchmark_report.ipp"
@@ -0,0 +1,74 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// System include(s).
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace traccc::performance {
+
+/// Identifiers of the hardware counters that can be read
+enum class hw_counter : unsigned int {
+    cycles = 0,
+    instructions = 1,
+    l1d_read_misses = 2,
+    llc_misses = 3,
+    branch_misses = 4,
+};
+
+/// Number of the hardware counter identifiers
+inline constexpr std::size_t n_hw_counters = 5;
+
+/// Printable name of a hardware counter
+std::string_view hw_counter_name(hw_counter c);
+
+/// Values of all hardware counters
+using hw_counter_values = std::array<std::uint64_t, n_hw_counters>;
+
+/// Hardware performance counters of the calling thread
+///
+/// The counters are read through the Linux @c perf_event_open interface,
+/// counting only user space events of the thread that created the object.
+/// Counters that the platform (or the value of
+/// @c /proc/sys/kernel/perf_event_paranoid) does not allow to open read
+/// as zero. On other operating systems none of the counters is available.
+///
+class hardware_counters {
+
+    public:
+    /// Open the counters for the calling thread
+    hardware_counters();
+    /// Close the counters
+    ~hardware_counters();
+
+    /// The counters can not be copied
+    hardware_counters(const hardware_counters&) = delete;
+    hardware_counters& operator=(const hardware_counters&) = delete;
+
+    /// Check whether a counter could be opened
+    bool is_available(hw_counter c) const;
+
+    /// Read the current value of all counters
+    ///
+    /// The values are scaled up if the kernel had to multiplex the counters.
+    ///
+    hw_counter_values read() const;
+
+    /// The counters of the calling thread, opened on first use
+    static const hardware_counters& this_thread();
+
+    private:
+    /// File descriptors of the counters (-1 if not available)
+    std::array<int, n_hw_counters> m_fds;
+
+};  // class hardware_counters
+
+}  // namespace traccc::performance
@@ -0,0 +1,26 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// System include(s).
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace traccc::performance {
+
+template <typename T>
+void benchmark_report::add_configuration(std::string_view name,
+                                         const T& value) {
+
+    std::ostringstream str;
+    str << std::boolalpha << value;
+    configuration.emplace_back(std::string(name), str.str());
+}
+
+}  // namespace traccc::performance
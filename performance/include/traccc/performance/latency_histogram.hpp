@@ -0,0 +1,132 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// System include(s).
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+
+namespace traccc::performance {
+
+/// Lock-free histogram of (event processing) latencies
+///
+/// The histogram uses log-linear buckets, in the style of HdrHistogram:
+/// every power-of-two range of values is split into the same number of
+/// linear sub-buckets. This keeps the relative precision of the recorded
+/// values (and of the percentiles calculated from them) constant, at about
+/// 3%, over the full range of the (nanosecond) values, with a fixed and
+/// small amount of memory.
+///
+/// Recording a value only needs relaxed atomic operations, so any number of
+/// threads can record into the same histogram concurrently.
+///
+class latency_histogram {
+
+    public:
+    /// Record a latency
+    void record(std::chrono::nanoseconds latency);
+
+    /// Number of recorded latencies
+    std::uint64_t count() const;
+    /// Largest recorded latency (exactly)
+    std::chrono::nanoseconds max() const;
+    /// Mean of the recorded latencies (exactly)
+    std::chrono::nanoseconds mean() const;
+    /// Latency below which a given fraction of the recorded latencies are
+    ///
+    /// @param fraction The fraction, between 0 and 1 (0.99 for p99)
+    /// @return The upper edge of the bucket holding the percentile, or zero
+    ///         if nothing was recorded
+    ///
+    std::chrono::nanoseconds percentile(double fraction) const;
+
+    /// Reset the histogram
+    ///
+    /// Must not be called while values are being recorded.
+    ///
+    void reset();
+
+    private:
+    /// Number of bits of the linear sub-buckets of every power of two
+    static constexpr unsigned int sub_bucket_bits = 5;
+    /// Number of linear sub-buckets of every power of two
+    static constexpr std::uint64_t sub_bucket_count = 1u << sub_bucket_bits;
+    /// Total number of buckets, covering all 64-bit values
+    static constexpr std::size_t bucket_count =
+        (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+    /// Bucket of a value
+    static std::size_t bucket_index(std::uint64_t value);
+    /// Largest value falling into a bucket
+    static std::uint64_t bucket_upper_edge(std::size_t index);
+
+    /// Counts of all buckets
+    std::array<std::atomic<std::uint64_t>, bucket_count> m_counts{};
+    /// Number of recorded values
+    std::atomic<std::uint64_t> m_count{0};
+    /// Sum of the recorded values
+    std::atomic<std::uint64_t> m_sum{0};
+    /// Largest recorded value
+    std::atomic<std::uint64_t> m_max{0};
+
+};  // class latency_histogram
+
+/// Per-event latencies, split up by the size of the events
+///
+/// Next to the histogram of all events, it keeps a histogram for every
+/// power-of-two range of the event size (e.g. in number of cells). This
+/// allows attributing slow outliers to large events, or finding that they
+/// also happen for ordinary ones.
+///
+class event_latency_recorder {
+
+    public:
+    /// Number of event size classes (power-of-two ranges)
+    static constexpr std::size_t n_size_classes = 32;
+
+    /// Constructor
+    event_latency_recorder();
+
+    /// Record the latency of an event
+    ///
+    /// @param latency  The processing time of the event
+    /// @param size     The size of the event (e.g. its number of cells)
+    ///
+    void record(std::chrono::nanoseconds latency, std::size_t size);
+
+    /// Histogram of all events
+    const latency_histogram& all() const { return m_all; }
+    /// Histogram of the events in one size class
+    ///
+    /// Size class @c i holds the events with a size in [2^i, 2^(i+1)), with
+    /// the events of size zero also put into class 0.
+    ///
+    const latency_histogram& size_class(std::size_t i) const {
+        return m_by_size[i];
+    }
+
+    /// Reset all histograms
+    void reset();
+
+    private:
+    /// Histogram of all events
+    latency_histogram m_all;
+    /// Histograms of the size classes (on the heap, for their size)
+    std::unique_ptr<latency_histogram[]> m_by_size;
+
+};  // class event_latency_recorder
+
+/// Printout helper for @c traccc::performance::event_latency_recorder
+std::ostream& operator<<(std::ostream& out, const event_latency_recorder& rec);
+
+}  // namespace traccc::performance
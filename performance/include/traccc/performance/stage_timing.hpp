@@ -0,0 +1,191 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Project include(s).
+#include "traccc/performance/hardware_counters.hpp"
+#include "traccc/performance/timing_info.hpp"
+#include "traccc/performance/trace_recorder.hpp"
+#include "traccc/utils/instrumented_memory_resource.hpp"
+
+// System include(s).
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <mutex>
+#include <string_view>
+
+namespace traccc::performance {
+
+/// Identifiers of the reconstruction stages that can be timed
+enum class stage : unsigned int {
+    clusterization = 0,
+    spacepoint_formation = 1,
+    spacepoint_binning = 2,
+    seeding = 3,
+    track_params_estimation = 4,
+    track_finding = 5,
+    ambiguity_resolution = 6,
+    track_fitting = 7,
+    data_transfer = 8,
+};
+
+/// Number of the stage identifiers
+inline constexpr std::size_t n_stages = 9;
+
+/// Printable name of a stage
+std::string_view stage_name(stage s);
+
+/// Caveat of the per-stage hardware counters, to print next to them
+inline constexpr std::string_view hw_counter_caveat =
+    "The hardware counters only include the thread that ran a stage, not "
+    "the (TBB) worker threads of the parallel loops inside of it";
+
+/// Per-stage timing, collected from any number of threads
+///
+/// Every thread (or rather, every algorithm object that is only used by one
+/// thread at a time) records its measurements into its own accumulator. The
+/// accumulators are only written to with relaxed atomic additions, so the
+/// measurements themselves neither lock nor share cache lines between the
+/// threads. The accumulators are merged into a single @c timing_info object
+/// at the end of the processing.
+///
+/// Optionally the hardware performance counters of the threads are also
+/// accumulated for every stage, to tell whether a stage is limited by its
+/// computations or by its memory accesses. The counters are read from the
+/// thread that opens and closes the stage's scope. Work that the stage
+/// hands to other threads, like the TBB worker threads running its parallel
+/// loops, is not counted (see @c hw_counter_caveat), while its time is.
+///
+class stage_timing {
+
+    public:
+    /// Timing accumulator of a single thread
+    class alignas(64) accumulator {
+
+        public:
+        /// Add the time spent in a stage
+        void add(stage s, std::chrono::nanoseconds time) {
+            entry& e = m_entries[static_cast<std::size_t>(s)];
+            e.time.fetch_add(time.count(), std::memory_order_relaxed);
+            e.calls.fetch_add(1, std::memory_order_relaxed);
+        }
+        /// Add the hardware counter increments of a stage
+        void add(stage s, const hw_counter_values& counters) {
+            entry& e = m_entries[static_cast<std::size_t>(s)];
+            for (std::size_t i = 0; i < n_hw_counters; ++i) {
+                e.counters[i].fetch_add(counters[i],
+                                        std::memory_order_relaxed);
+            }
+        }
+
+        /// Whether the hardware counters are recorded into this accumulator
+        bool records_hardware_counters() const { return m_hardware_counters; }
+
+        private:
+        friend class stage_timing;
+
+        /// Accumulated time, number of calls and counters of one stage
+        struct entry {
+            std::atomic<std::chrono::nanoseconds::rep> time{0};
+            std::atomic<std::uint64_t> calls{0};
+            std::array<std::atomic<std::uint64_t>, n_hw_counters> counters{};
+        };
+        /// Entries of all stages
+        std::array<entry, n_stages> m_entries;
+        /// Whether the hardware counters are recorded
+        bool m_hardware_counters = false;
+    };
+
+    /// Measure the time spent in a stage until the end of the scope
+    ///
+    /// Does not measure anything if no accumulator is given, so that it can
+    /// be left in the code of algorithms that are not always instrumented.
+    /// If a trace buffer is given, the stage is also recorded as a span of
+    /// the trace. The stage is always made the active tag of
+    /// @c traccc::instrumented_memory_resource in the current thread.
+    ///
+    class scope {
+
+        public:
+        /// Start the time measurement
+        scope(accumulator* acc, stage s,
+              trace_recorder::buffer* trace = nullptr);
+        /// End the time measurement
+        ~scope();
+
+        /// The scope can not be copied
+        scope(const scope&) = delete;
+        scope& operator=(const scope&) = delete;
+
+        private:
+        /// The accumulator to record into
+        accumulator* m_accumulator;
+        /// The trace buffer to record into
+        trace_recorder::buffer* m_trace;
+        /// The stage being measured
+        stage m_stage;
+        /// The memory allocation tag of the stage
+        instrumented_memory_resource::scope m_memory_tag;
+        /// Start time of the measurement
+        std::chrono::steady_clock::time_point m_start;
+        /// Hardware counter values at the start of the measurement
+        hw_counter_values m_counters_start;
+    };
+
+    /// Constructor
+    ///
+    /// @param hardware_counters Whether to also record the hardware
+    ///                          performance counters of the stages
+    ///
+    explicit stage_timing(bool hardware_counters = false);
+
+    /// Create a new accumulator, owned by this object
+    ///
+    /// This function is thread-safe, but it is meant to be called while
+    /// setting up the processing, not during it.
+    ///
+    accumulator& make_accumulator();
+
+    /// Total time spent in a stage by all accumulators
+    std::chrono::nanoseconds total_time(stage s) const;
+    /// Total number of calls of a stage in all accumulators
+    std::uint64_t n_calls(stage s) const;
+    /// Total increment of a hardware counter in a stage in all accumulators
+    std::uint64_t total_count(stage s, hw_counter c) const;
+
+    /// Whether hardware counters are recorded
+    bool records_hardware_counters() const { return m_hardware_counters; }
+    /// Print a table of the hardware counters of the stages, followed by
+    /// @c hw_counter_caveat
+    void print_hardware_counters(std::ostream& out) const;
+
+    /// Merge the accumulators, for the stages that were called at all
+    timing_info merge() const;
+
+    /// Reset all accumulators
+    ///
+    /// Must not be called while any of the accumulators is being written to.
+    ///
+    void reset();
+
+    private:
+    /// Whether hardware counters are recorded
+    bool m_hardware_counters;
+    /// Mutex protecting the list of the accumulators
+    mutable std::mutex m_mutex;
+    /// The accumulators (a deque, for stable addresses)
+    std::deque<accumulator> m_accumulators;
+
+};  // class stage_timing
+
+}  // namespace traccc::performance
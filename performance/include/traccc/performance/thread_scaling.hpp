@@ -0,0 +1,75 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// System include(s).
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <vector>
+
+namespace traccc::performance {
+
+/// Results of a thread-scaling sweep
+///
+/// Holds the throughput measured with different numbers of threads, and
+/// derives the speed-up and the parallel efficiency of every measurement
+/// relative to the one made with the fewest threads. If that one used more
+/// than one thread, the results are relative to its thread count, and not
+/// to a (not measured) single thread.
+///
+class thread_scaling {
+
+    public:
+    /// The measurement made with one thread count
+    struct point {
+        /// The number of threads used
+        std::size_t threads;
+        /// The number of events processed
+        std::size_t events;
+        /// The time it took to process the events
+        std::chrono::nanoseconds time;
+
+        /// Throughput of the measurement, in events per second
+        double events_per_second() const;
+    };
+
+    /// Add the result of one measurement
+    void add(std::size_t threads, std::size_t events,
+             std::chrono::nanoseconds time);
+
+    /// The measurements, in the order that they were added
+    const std::vector<point>& points() const { return m_points; }
+
+    /// Speed-up of a measurement, relative to the one with the fewest threads
+    ///
+    /// This is the ratio of the throughputs of the two measurements. No
+    /// scaling from a single thread to the baseline thread count is assumed.
+    ///
+    double speedup(const point& p) const;
+
+    /// Parallel efficiency of a measurement
+    ///
+    /// The speed-up divided by the ratio of the thread counts of the
+    /// measurement and of the baseline.
+    ///
+    double efficiency(const point& p) const;
+
+    private:
+    /// The measurement with the fewest threads
+    const point& baseline() const;
+
+    /// The measurements
+    std::vector<point> m_points;
+
+};  // class thread_scaling
+
+/// Printout helper for @c traccc::performance::thread_scaling
+std::ostream& operator<<(std::ostream& out, const thread_scaling& scaling);
+
+}  // namespace traccc::performance
@@ -0,0 +1,146 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// System include(s).
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <iosfwd>
+#include <mutex>
+#include <vector>
+
+namespace traccc::performance {
+
+/// Recorder of a timeline of the processing, in the Chrome trace format
+///
+/// Every thread records the begin and end time of the algorithms that it
+/// runs into its own ring buffer, tagged with the number of the event being
+/// processed. The buffers are written out as a single trace-event JSON file
+/// at the end of the job, which can be viewed with Perfetto or with
+/// chrome://tracing.
+///
+/// When a buffer fills up, its oldest spans are overwritten, so the memory
+/// use of the recorder is fixed at its construction.
+///
+class trace_recorder {
+
+    public:
+    /// Clock used for the time measurements
+    using clock = std::chrono::steady_clock;
+
+    /// One recorded time span
+    struct span {
+        /// Name of the span (a string with static storage duration)
+        const char* name;
+        /// The event being processed
+        std::size_t event;
+        /// Begin and end time of the span
+        clock::time_point begin, end;
+    };
+
+    /// Ring buffer of the spans of a single thread
+    class buffer {
+
+        public:
+        /// Constructor with the thread identifier and the buffer size
+        buffer(unsigned int thread_id, std::size_t capacity);
+
+        /// Set the event that the following spans belong to
+        void set_event(std::size_t event) { m_event = event; }
+
+        /// Record a span of the current event
+        ///
+        /// @param name  Name of the span, which must have static storage
+        ///              duration (e.g. a string literal)
+        /// @param begin Begin time of the span
+        /// @param end   End time of the span
+        ///
+        void record(const char* name, clock::time_point begin,
+                    clock::time_point end) {
+            m_spans[m_next % m_spans.size()] = {name, m_event, begin, end};
+            ++m_next;
+        }
+
+        private:
+        friend class trace_recorder;
+
+        /// Identifier of the thread using the buffer
+        unsigned int m_thread_id;
+        /// The current event
+        std::size_t m_event = 0;
+        /// The recorded spans
+        std::vector<span> m_spans;
+        /// Number of spans recorded so far
+        std::size_t m_next = 0;
+    };
+
+    /// Record a span until the end of the scope
+    ///
+    /// Does not record anything if no buffer is given.
+    ///
+    class scope {
+
+        public:
+        /// Start the span
+        scope(buffer* buf, const char* name) : m_buffer(buf), m_name(name) {
+            if (m_buffer != nullptr) {
+                m_begin = clock::now();
+            }
+        }
+        /// End the span
+        ~scope() {
+            if (m_buffer != nullptr) {
+                m_buffer->record(m_name, m_begin, clock::now());
+            }
+        }
+
+        /// The scope can not be copied
+        scope(const scope&) = delete;
+        scope& operator=(const scope&) = delete;
+
+        private:
+        /// The buffer to record into
+        buffer* m_buffer;
+        /// Name of the span
+        const char* m_name;
+        /// Begin time of the span
+        clock::time_point m_begin;
+    };
+
+    /// Constructor with the size of the per-thread buffers
+    explicit trace_recorder(std::size_t capacity = 1u << 16);
+
+    /// Create a new buffer, owned by this object
+    ///
+    /// This function is thread-safe, but it is meant to be called while
+    /// setting up the processing, not during it.
+    ///
+    /// @param thread_id Identifier of the thread using the buffer
+    ///
+    buffer& make_buffer(unsigned int thread_id);
+
+    /// Write all recorded spans in the Chrome trace-event JSON format
+    ///
+    /// Must not be called while any of the buffers is being written to.
+    ///
+    void write_json(std::ostream& out) const;
+
+    private:
+    /// Start time of the trace
+    clock::time_point m_start;
+    /// Size of the per-thread buffers
+    std::size_t m_capacity;
+    /// Mutex protecting the list of the buffers
+    mutable std::mutex m_mutex;
+    /// The buffers (a deque, for stable addresses)
+    std::deque<buffer> m_buffers;
+
+};  // class trace_recorder
+
+}  // namespace traccc::performance
@@ -0,0 +1,379 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Library include(s).
+#include "traccc/performance/benchmark_report.hpp"
+
+// System include(s).
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+// POSIX include(s).
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+#endif
+
+namespace traccc::performance {
+
+namespace {
+
+/// Write a string as a (quoted and escaped) JSON string
+void write_string(std::ostream& out, std::string_view str) {
+
+    out << '"';
+    for (const char c : str) {
+        switch (c) {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            case '\n':
+                out << "\\n";
+                break;
+            case '\t':
+                out << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x",
+                                  static_cast<unsigned int>(c));
+                    out << buffer;
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+
+/// Write the key of a JSON object member
+std::ostream& write_key(std::ostream& out, std::string_view indent,
+                        std::string_view key) {
+
+    out << indent;
+    write_string(out, key);
+    return out << ": ";
+}
+
+/// Description of the CPU, from /proc/cpuinfo where available
+std::string cpu_model() {
+
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.rfind("model name", 0) == 0) {
+            const std::size_t pos = line.find(':');
+            if (pos != std::string::npos && pos + 2 <= line.size()) {
+                return line.substr(pos + 2);
+            }
+        }
+    }
+    return "unknown";
+}
+
+/// Peak resident memory of the process, in bytes (zero if unknown)
+std::uint64_t peak_rss() {
+
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+        return static_cast<std::uint64_t>(usage.ru_maxrss);
+#else
+        return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024u;
+#endif
+    }
+#endif
+    return 0u;
+}
+
+/// Write the description of the host
+void write_host(std::ostream& out) {
+
+    std::string hostname = "unknown";
+    std::string os = "unknown";
+#if defined(__unix__) || defined(__APPLE__)
+    char buffer[256];
+    if (gethostname(buffer, sizeof(buffer)) == 0) {
+        buffer[sizeof(buffer) - 1] = '\0';
+        hostname = buffer;
+    }
+    struct utsname uts;
+    if (uname(&uts) == 0) {
+        os = std::string(uts.sysname) + " " + uts.release + " " + uts.machine;
+    }
+#endif
+
+    out << "{\n";
+    write_key(out, "    ", "hostname");
+    write_string(out, hostname);
+    out << ",\n";
+    write_key(out, "    ", "os");
+    write_string(out, os);
+    out << ",\n";
+    write_key(out, "    ", "cpu_model");
+    write_string(out, cpu_model());
+    out << ",\n";
+    write_key(out, "    ", "logical_cores")
+        << std::thread::hardware_concurrency() << "\n  }";
+}
+
+/// Write the description of the build
+void write_build(std::ostream& out) {
+
+#if defined(__clang__)
+    const std::string compiler = "Clang " __clang_version__;
+#elif defined(__GNUC__)
+    const std::string compiler = "GCC " __VERSION__;
+#else
+    const std::string compiler = "unknown";
+#endif
+#ifdef NDEBUG
+    const bool assertions = false;
+#else
+    const bool assertions = true;
+#endif
+
+    out << "{\n";
+    write_key(out, "    ", "compiler");
+    write_string(out, compiler);
+    out << ",\n";
+    write_key(out, "    ", "cxx_standard") << __cplusplus << ",\n";
+    write_key(out, "    ", "assertions")
+        << (assertions ? "true" : "false") << "\n  }";
+}
+
+/// Write the summary of a latency histogram
+void write_latencies(std::ostream& out, const latency_histogram& hist,
+                     std::string_view indent) {
+
+    write_key(out, indent, "count") << hist.count() << ",\n";
+    write_key(out, indent, "mean_ns") << hist.mean().count() << ",\n";
+    write_key(out, indent, "p50_ns") << hist.percentile(0.5).count()
+                                     << ",\n";
+    write_key(out, indent, "p90_ns") << hist.percentile(0.9).count()
+                                     << ",\n";
+    write_key(out, indent, "p99_ns") << hist.percentile(0.99).count()
+                                     << ",\n";
+    write_key(out, indent, "p99.9_ns") << hist.percentile(0.999).count()
+                                       << ",\n";
+    write_key(out, indent, "max_ns") << hist.max().count();
+}
+
+/// Write the statistics of the allocations made with one tag
+void write_allocations(std::ostream& out, std::string_view name,
+                       const memory_profile::tag_stats& stats) {
+
+    out << "    {";
+    write_string(out, "tag");
+    out << ": ";
+    write_string(out, name);
+    out << ", ";
+    write_string(out, "allocations");
+    out << ": " << stats.allocations << ", ";
+    write_string(out, "deallocations");
+    out << ": " << stats.deallocations << ", ";
+    write_string(out, "allocated_bytes");
+    out << ": " << stats.allocated_bytes << ", ";
+    write_string(out, "peak_bytes");
+    out << ": " << stats.peak_bytes << "}";
+}
+
+/// Write the hardware counters of a stage, the ones that are available
+void write_counters(std::ostream& out, const stage_timing& times, stage s) {
+
+    const hardware_counters& counters = hardware_counters::this_thread();
+    out << ", ";
+    write_string(out, "counters");
+    out << ": {";
+    bool first = true;
+    for (std::size_t i = 0; i < n_hw_counters; ++i) {
+        const hw_counter c = static_cast<hw_counter>(i);
+        if (!counters.is_available(c)) {
+            continue;
+        }
+        out << (first ? "" : ", ");
+        first = false;
+        write_string(out, hw_counter_name(c));
+        out << ": " << times.total_count(s, c);
+    }
+    const std::uint64_t cycles = times.total_count(s, hw_counter::cycles);
+    if (counters.is_available(hw_counter::instructions) && (cycles > 0)) {
+        out << ", ";
+        write_string(out, "ipc");
+        out << ": "
+            << static_cast<double>(
+                   times.total_count(s, hw_counter::instructions)) /
+                   static_cast<double>(cycles);
+    }
+    out << "}";
+}
+
+}  // namespace
+
+void write_json(std::ostream& out, const benchmark_report& report) {
+
+    out << std::setprecision(10);
+    out << "{\n";
+    write_key(out, "  ", "application");
+    write_string(out, report.application);
+    out << ",\n";
+
+    // Configuration of the job
+    write_key(out, "  ", "configuration") << "{";
+    for (std::size_t i = 0; i < report.configuration.size(); ++i) {
+        out << (i == 0 ? "\n" : ",\n");
+        write_key(out, "    ", report.configuration[i].first);
+        write_string(out, report.configuration[i].second);
+    }
+    out << (report.configuration.empty() ? "},\n" : "\n  },\n");
+    write_key(out, "  ", "threads") << report.threads << ",\n";
+
+    // Description of the host and of the build
+    write_key(out, "  ", "host");
+    write_host(out);
+    out << ",\n";
+    write_key(out, "  ", "build");
+    write_build(out);
+    out << ",\n";
+
+    // Coarse timing and the throughput
+    write_key(out, "  ", "timing_ns") << "{";
+    if (report.times != nullptr) {
+        for (std::size_t i = 0; i < report.times->data.size(); ++i) {
+            out << (i == 0 ? "\n" : ",\n");
+            write_key(out, "    ", report.times->data[i].first)
+                << report.times->data[i].second.count();
+        }
+        out << (report.times->data.empty() ? "" : "\n  ");
+    }
+    out << "},\n";
+    write_key(out, "  ", "processed_events")
+        << report.processed_events << ",\n";
+    if ((report.times != nullptr) && (report.processed_events > 0)) {
+        const double seconds =
+            std::chrono::duration<double>(
+                report.times->get_time(report.processing_timer))
+                .count();
+        write_key(out, "  ", "throughput") << "{\n";
+        write_key(out, "    ", "ms_per_event")
+            << seconds * 1e3 / static_cast<double>(report.processed_events)
+            << ",\n";
+        write_key(out, "    ", "events_per_second")
+            << static_cast<double>(report.processed_events) / seconds
+            << "\n  },\n";
+    }
+
+    // Per-stage timing
+    if (report.stage_times != nullptr) {
+        write_key(out, "  ", "stages") << "[";
+        bool first = true;
+        for (std::size_t i = 0; i < n_stages; ++i) {
+            const stage s = static_cast<stage>(i);
+            const std::uint64_t calls = report.stage_times->n_calls(s);
+            if (calls == 0) {
+                continue;
+            }
+            out << (first ? "\n" : ",\n") << "    {";
+            first = false;
+            write_string(out, "name");
+            out << ": ";
+            write_string(out, stage_name(s));
+            out << ", ";
+            write_string(out, "calls");
+            out << ": " << calls << ", ";
+            write_string(out, "total_ns");
+            out << ": " << report.stage_times->total_time(s).count();
+            if (report.stage_times->records_hardware_counters()) {
+                write_counters(out, *(report.stage_times), s);
+            }
+            out << "}";
+        }
+        out << (first ? "],\n" : "\n  ],\n");
+        if (report.stage_times->records_hardware_counters()) {
+            write_key(out, "  ", "counters_note");
+            write_string(out, hw_counter_caveat);
+            out << ",\n";
+        }
+    }
+
+    // Per-event latencies
+    if (report.latencies != nullptr) {
+        write_key(out, "  ", "latency") << "{\n";
+        write_latencies(out, report.latencies->all(), "    ");
+        out << ",\n";
+        write_key(out, "    ", "by_event_size") << "[";
+        bool first = true;
+        for (std::size_t i = 0; i < event_latency_recorder::n_size_classes;
+             ++i) {
+            const latency_histogram& hist = report.latencies->size_class(i);
+            if (hist.count() == 0) {
+                continue;
+            }
+            out << (first ? "\n" : ",\n") << "      {\n";
+            first = false;
+            write_key(out, "        ", "min_size")
+                << (i == 0 ? 0ul : (1ul << i)) << ",\n";
+            write_key(out, "        ", "max_size")
+                << ((2ul << i) - 1) << ",\n";
+            write_latencies(out, hist, "        ");
+            out << "\n      }";
+        }
+        out << (first ? "]\n" : "\n    ]\n") << "  },\n";
+    }
+
+    // Memory allocations of the stages
+    if (report.allocations != nullptr) {
+        write_key(out, "  ", "allocations") << "[\n";
+        for (const auto& [tag, stats] : report.allocations->tags) {
+            write_allocations(out, tag, stats);
+            out << ",\n";
+        }
+        write_allocations(out, "Total", report.allocations->total);
+        out << "\n  ],\n";
+    }
+
+    // Thread-scaling sweep
+    if (report.scaling != nullptr) {
+        write_key(out, "  ", "thread_scaling") << "[";
+        bool first = true;
+        for (const thread_scaling::point& p : report.scaling->points()) {
+            out << (first ? "\n" : ",\n") << "    {";
+            first = false;
+            write_string(out, "threads");
+            out << ": " << p.threads << ", ";
+            write_string(out, "events");
+            out << ": " << p.events << ", ";
+            write_string(out, "total_ns");
+            out << ": " << p.time.count() << ", ";
+            write_string(out, "events_per_second");
+            out << ": " << p.events_per_second() << ", ";
+            write_string(out, "speedup");
+            out << ": " << report.scaling->speedup(p) << ", ";
+            write_string(out, "efficiency");
+            out << ": " << report.scaling->efficiency(p) << "}";
+        }
+        out << (first ? "],\n" : "\n  ],\n");
+    }
+
+    // Memory usage
+    write_key(out, "  ", "memory") << "{\n";
+    write_key(out, "    ", "peak_rss_bytes") << peak_rss() << "\n  }\n";
+    out << "}\n";
+}
+
+}  // namespace traccc::performance
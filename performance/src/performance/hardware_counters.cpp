@@ -0,0 +1,149 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Library include(s).
+#include "traccc/performance/hardware_counters.hpp"
+
+// System include(s).
+#include <stdexcept>
+
+// Linux include(s).
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif  // __linux__
+
+namespace traccc::performance {
+
+namespace {
+
+#ifdef __linux__
+
+/// Open one counter for the calling thread
+int open_counter(hw_counter c) {
+
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format =
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    switch (c) {
+        case hw_counter::cycles:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case hw_counter::instructions:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case hw_counter::l1d_read_misses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D |
+                          (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        case hw_counter::llc_misses:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case hw_counter::branch_misses:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+    }
+
+    // Count for the calling thread, on any CPU.
+    return static_cast<int>(
+        syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+#endif  // __linux__
+
+}  // namespace
+
+std::string_view hw_counter_name(hw_counter c) {
+
+    switch (c) {
+        case hw_counter::cycles:
+            return "cycles";
+        case hw_counter::instructions:
+            return "instructions";
+        case hw_counter::l1d_read_misses:
+            return "l1d_read_misses";
+        case hw_counter::llc_misses:
+            return "llc_misses";
+        case hw_counter::branch_misses:
+            return "branch_misses";
+    }
+    throw std::invalid_argument("Unknown hardware counter received");
+}
+
+hardware_counters::hardware_counters() {
+
+    for (std::size_t i = 0; i < n_hw_counters; ++i) {
+#ifdef __linux__
+        m_fds[i] = open_counter(static_cast<hw_counter>(i));
+#else
+        m_fds[i] = -1;
+#endif  // __linux__
+    }
+}
+
+hardware_counters::~hardware_counters() {
+
+#ifdef __linux__
+    for (int fd : m_fds) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+#endif  // __linux__
+}
+
+bool hardware_counters::is_available(hw_counter c) const {
+
+    return (m_fds[static_cast<std::size_t>(c)] >= 0);
+}
+
+hw_counter_values hardware_counters::read() const {
+
+    hw_counter_values result{};
+#ifdef __linux__
+    for (std::size_t i = 0; i < n_hw_counters; ++i) {
+        if (m_fds[i] < 0) {
+            continue;
+        }
+        // The value, the time enabled and the time running.
+        std::uint64_t data[3] = {0, 0, 0};
+        if (::read(m_fds[i], data, sizeof(data)) !=
+            static_cast<ssize_t>(sizeof(data))) {
+            continue;
+        }
+        if ((data[2] > 0) && (data[2] < data[1])) {
+            data[0] = static_cast<std::uint64_t>(
+                static_cast<double>(data[0]) * static_cast<double>(data[1]) /
+                static_cast<double>(data[2]));
+        }
+        result[i] = data[0];
+    }
+#endif  // __linux__
+    return result;
+}
+
+const hardware_counters& hardware_counters::this_thread() {
+
+    static thread_local const hardware_counters counters;
+    return counters;
+}
+
+}  // namespace traccc::performance
@@ -0,0 +1,198 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Library include(s).
+#include "traccc/performance/latency_histogram.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+namespace traccc::performance {
+
+namespace {
+
+/// Index of the most significant set bit of a (non-zero) value
+unsigned int msb(std::uint64_t value) {
+
+    unsigned int result = 0;
+    while (value >>= 1) {
+        ++result;
+    }
+    return result;
+}
+
+/// Print a duration in microseconds
+std::ostream& print_us(std::ostream& out, std::chrono::nanoseconds time) {
+
+    return out << std::setw(10) << std::right
+               << std::chrono::duration_cast<std::chrono::microseconds>(time)
+                      .count()
+               << " us";
+}
+
+}  // namespace
+
+std::size_t latency_histogram::bucket_index(std::uint64_t value) {
+
+    // Small values each have their own bucket
+    if (value < 2 * sub_bucket_count) {
+        return static_cast<std::size_t>(value);
+    }
+    // Larger ones are binned linearly inside of their power of two
+    const unsigned int shift = msb(value) - sub_bucket_bits;
+    return static_cast<std::size_t>(shift * sub_bucket_count +
+                                    (value >> shift));
+}
+
+std::uint64_t latency_histogram::bucket_upper_edge(std::size_t index) {
+
+    if (index < 2 * sub_bucket_count) {
+        return index;
+    }
+    const std::uint64_t shift = index / sub_bucket_count - 1;
+    const std::uint64_t mantissa = index - shift * sub_bucket_count;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+void latency_histogram::record(std::chrono::nanoseconds latency) {
+
+    const std::uint64_t value =
+        (latency.count() > 0) ? static_cast<std::uint64_t>(latency.count())
+                              : 0u;
+
+    m_counts[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    std::uint64_t max = m_max.load(std::memory_order_relaxed);
+    while (value > max && !m_max.compare_exchange_weak(
+                              max, value, std::memory_order_relaxed)) {
+    }
+}
+
+std::uint64_t latency_histogram::count() const {
+
+    return m_count.load(std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds latency_histogram::max() const {
+
+    return std::chrono::nanoseconds{
+        static_cast<std::chrono::nanoseconds::rep>(
+            m_max.load(std::memory_order_relaxed))};
+}
+
+std::chrono::nanoseconds latency_histogram::mean() const {
+
+    const std::uint64_t n = count();
+    if (n == 0) {
+        return std::chrono::nanoseconds{0};
+    }
+    return std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(
+        m_sum.load(std::memory_order_relaxed) / n)};
+}
+
+std::chrono::nanoseconds latency_histogram::percentile(double fraction) const {
+
+    const std::uint64_t n = count();
+    if (n == 0) {
+        return std::chrono::nanoseconds{0};
+    }
+
+    // The number of values at or below the percentile
+    const std::uint64_t target = std::max<std::uint64_t>(
+        1u, static_cast<std::uint64_t>(
+                std::ceil(std::clamp(fraction, 0., 1.) *
+                          static_cast<double>(n))));
+
+    std::uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+        cumulative += m_counts[i].load(std::memory_order_relaxed);
+        if (cumulative >= target) {
+            // The bucket edge can not be above the largest value
+            return std::min(
+                std::chrono::nanoseconds{
+                    static_cast<std::chrono::nanoseconds::rep>(
+                        bucket_upper_edge(i))},
+                max());
+        }
+    }
+    return max();
+}
+
+void latency_histogram::reset() {
+
+    for (std::atomic<std::uint64_t>& c : m_counts) {
+        c.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+event_latency_recorder::event_latency_recorder()
+    : m_by_size(std::make_unique<latency_histogram[]>(n_size_classes)) {}
+
+void event_latency_recorder::record(std::chrono::nanoseconds latency,
+                                    std::size_t size) {
+
+    m_all.record(latency);
+    const std::size_t size_class =
+        (size == 0) ? 0u
+                    : std::min<std::size_t>(msb(size), n_size_classes - 1);
+    m_by_size[size_class].record(latency);
+}
+
+void event_latency_recorder::reset() {
+
+    m_all.reset();
+    for (std::size_t i = 0; i < n_size_classes; ++i) {
+        m_by_size[i].reset();
+    }
+}
+
+std::ostream& operator<<(std::ostream& out, const event_latency_recorder& rec) {
+
+    const latency_histogram& all = rec.all();
+    out << std::setw(30) << std::right << "Events  " << std::setw(10)
+        << all.count() << "\n";
+    out << std::setw(30) << std::right << "Mean  ";
+    print_us(out, all.mean()) << "\n";
+    for (const auto& [name, fraction] :
+         {std::pair{"p50  ", 0.5}, std::pair{"p90  ", 0.9},
+          std::pair{"p99  ", 0.99}, std::pair{"p99.9  ", 0.999}}) {
+        out << std::setw(30) << std::right << name;
+        print_us(out, all.percentile(fraction)) << "\n";
+    }
+    out << std::setw(30) << std::right << "Max  ";
+    print_us(out, all.max());
+
+    // Latencies per event size class
+    out << "\n"
+        << std::setw(30) << std::right << "Event size  " << std::setw(10)
+        << "events" << std::setw(13) << "p50" << std::setw(13) << "p99"
+        << std::setw(13) << "max";
+    for (std::size_t i = 0; i < event_latency_recorder::n_size_classes; ++i) {
+        const latency_histogram& h = rec.size_class(i);
+        if (h.count() == 0) {
+            continue;
+        }
+        out << "\n"
+            << std::setw(12) << std::right << (i == 0 ? 0u : (1ul << i))
+            << " - " << std::setw(12) << std::left << ((2ul << i) - 1)
+            << "   " << std::setw(10) << std::right << h.count();
+        print_us(out, h.percentile(0.5));
+        print_us(out, h.percentile(0.99));
+        print_us(out, h.max());
+    }
+    return out;
+}
+
+}  // namespace traccc::performance
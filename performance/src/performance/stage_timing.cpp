@@ -0,0 +1,213 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Library include(s).
+#include "traccc/performance/stage_timing.hpp"
+
+// Nividia tool extensions library
+#ifdef TRACCC_HAVE_NVTX
+#include "nvtx3/nvToolsExt.h"
+#endif  // TRACCC_HAVE_NVTX
+
+// System include(s).
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace traccc::performance {
+
+std::string_view stage_name(stage s) {
+
+    switch (s) {
+        case stage::clusterization:
+            return "Clusterization";
+        case stage::spacepoint_formation:
+            return "Spacepoint formation";
+        case stage::spacepoint_binning:
+            return "Spacepoint binning";
+        case stage::seeding:
+            return "Seeding";
+        case stage::track_params_estimation:
+            return "Track parameter estimation";
+        case stage::track_finding:
+            return "Track finding";
+        case stage::ambiguity_resolution:
+            return "Ambiguity resolution";
+        case stage::track_fitting:
+            return "Track fitting";
+        case stage::data_transfer:
+            return "Data transfer";
+    }
+    throw std::invalid_argument("Unknown stage received");
+}
+
+stage_timing::scope::scope(accumulator* acc, stage s,
+                           trace_recorder::buffer* trace)
+    : m_accumulator(acc),
+      m_trace(trace),
+      m_stage(s),
+      m_memory_tag(stage_name(s)) {
+
+    if ((m_accumulator != nullptr) || (m_trace != nullptr)) {
+#ifdef TRACCC_HAVE_NVTX
+        nvtxRangePushA(stage_name(s).data());
+#endif  // TRACCC_HAVE_NVTX
+        if ((m_accumulator != nullptr) &&
+            m_accumulator->records_hardware_counters()) {
+            m_counters_start = hardware_counters::this_thread().read();
+        }
+        m_start = std::chrono::steady_clock::now();
+    }
+}
+
+stage_timing::scope::~scope() {
+
+    if ((m_accumulator != nullptr) || (m_trace != nullptr)) {
+        const auto end = std::chrono::steady_clock::now();
+        if (m_accumulator != nullptr) {
+            m_accumulator->add(m_stage, end - m_start);
+            if (m_accumulator->records_hardware_counters()) {
+                hw_counter_values counters =
+                    hardware_counters::this_thread().read();
+                for (std::size_t i = 0; i < n_hw_counters; ++i) {
+                    counters[i] -= m_counters_start[i];
+                }
+                m_accumulator->add(m_stage, counters);
+            }
+        }
+        if (m_trace != nullptr) {
+            m_trace->record(stage_name(m_stage).data(), m_start, end);
+        }
+#ifdef TRACCC_HAVE_NVTX
+        nvtxRangePop();
+#endif  // TRACCC_HAVE_NVTX
+    }
+}
+
+stage_timing::stage_timing(bool hardware_counters)
+    : m_hardware_counters(hardware_counters) {}
+
+stage_timing::accumulator& stage_timing::make_accumulator() {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    accumulator& result = m_accumulators.emplace_back();
+    result.m_hardware_counters = m_hardware_counters;
+    return result;
+}
+
+std::chrono::nanoseconds stage_timing::total_time(stage s) const {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::chrono::nanoseconds::rep result = 0;
+    for (const accumulator& acc : m_accumulators) {
+        result += acc.m_entries[static_cast<std::size_t>(s)].time.load(
+            std::memory_order_relaxed);
+    }
+    return std::chrono::nanoseconds{result};
+}
+
+std::uint64_t stage_timing::n_calls(stage s) const {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::uint64_t result = 0;
+    for (const accumulator& acc : m_accumulators) {
+        result += acc.m_entries[static_cast<std::size_t>(s)].calls.load(
+            std::memory_order_relaxed);
+    }
+    return result;
+}
+
+std::uint64_t stage_timing::total_count(stage s, hw_counter c) const {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::uint64_t result = 0;
+    for (const accumulator& acc : m_accumulators) {
+        result += acc.m_entries[static_cast<std::size_t>(s)]
+                      .counters[static_cast<std::size_t>(c)]
+                      .load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+void stage_timing::print_hardware_counters(std::ostream& out) const {
+
+    // Only print the counters that are available on this platform.
+    const hardware_counters& counters = hardware_counters::this_thread();
+    if (!counters.is_available(hw_counter::cycles)) {
+        out << "Hardware counters are not available";
+        return;
+    }
+
+    // Print a header.
+    out << std::setw(30) << std::right << "Stage";
+    for (std::size_t i = 0; i < n_hw_counters; ++i) {
+        out << std::setw(17) << hw_counter_name(static_cast<hw_counter>(i));
+    }
+    out << std::setw(7) << "IPC";
+
+    // Print the stages that were called.
+    for (std::size_t i = 0; i < n_stages; ++i) {
+        const stage s = static_cast<stage>(i);
+        if (n_calls(s) == 0) {
+            continue;
+        }
+        out << "\n" << std::setw(30) << std::right << stage_name(s);
+        for (std::size_t j = 0; j < n_hw_counters; ++j) {
+            const hw_counter c = static_cast<hw_counter>(j);
+            if (counters.is_available(c)) {
+                out << std::setw(17) << total_count(s, c);
+            } else {
+                out << std::setw(17) << "n/a";
+            }
+        }
+        const std::uint64_t cycles = total_count(s, hw_counter::cycles);
+        if (counters.is_available(hw_counter::instructions) && (cycles > 0)) {
+            // Format the ratio separately, not to change the state of the
+            // output stream.
+            std::ostringstream ipc;
+            ipc << std::fixed << std::setprecision(2)
+                << static_cast<double>(
+                       total_count(s, hw_counter::instructions)) /
+                       static_cast<double>(cycles);
+            out << std::setw(7) << ipc.str();
+        } else {
+            out << std::setw(7) << "n/a";
+        }
+    }
+    out << "\nNote: " << hw_counter_caveat;
+}
+
+timing_info stage_timing::merge() const {
+
+    timing_info result;
+    for (std::size_t i = 0; i < n_stages; ++i) {
+        const stage s = static_cast<stage>(i);
+        if (n_calls(s) > 0) {
+            result.data.push_back(
+                {std::string(stage_name(s)), total_time(s)});
+        }
+    }
+    return result;
+}
+
+void stage_timing::reset() {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (accumulator& acc : m_accumulators) {
+        for (accumulator::entry& e : acc.m_entries) {
+            e.time.store(0, std::memory_order_relaxed);
+            e.calls.store(0, std::memory_order_relaxed);
+            for (std::atomic<std::uint64_t>& c : e.counters) {
+                c.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+}  // namespace traccc::performance
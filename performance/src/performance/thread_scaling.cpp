@@ -0,0 +1,79 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Library include(s).
+#include "traccc/performance/thread_scaling.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <cassert>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace traccc::performance {
+
+double thread_scaling::point::events_per_second() const {
+
+    const double seconds = std::chrono::duration<double>(time).count();
+    return (seconds > 0.) ? static_cast<double>(events) / seconds : 0.;
+}
+
+void thread_scaling::add(std::size_t threads, std::size_t events,
+                         std::chrono::nanoseconds time) {
+
+    m_points.push_back({threads, events, time});
+}
+
+double thread_scaling::speedup(const point& p) const {
+
+    const point& base = baseline();
+    const double base_throughput = base.events_per_second();
+    if (base_throughput <= 0.) {
+        return 0.;
+    }
+    return p.events_per_second() / base_throughput;
+}
+
+double thread_scaling::efficiency(const point& p) const {
+
+    if (p.threads == 0) {
+        return 0.;
+    }
+    const double thread_ratio = static_cast<double>(p.threads) /
+                                static_cast<double>(baseline().threads);
+    return speedup(p) / thread_ratio;
+}
+
+const thread_scaling::point& thread_scaling::baseline() const {
+
+    assert(!m_points.empty());
+    return *std::min_element(m_points.begin(), m_points.end(),
+                             [](const point& a, const point& b) {
+                                 return a.threads < b.threads;
+                             });
+}
+
+std::ostream& operator<<(std::ostream& out, const thread_scaling& scaling) {
+
+    // Format the numbers on a separate stream, not to change the state of
+    // the output stream
+    std::ostringstream str;
+    str << std::fixed << std::setw(10) << std::right << "Threads"
+        << std::setw(16) << "Events/s" << std::setw(12) << "Speed-up"
+        << std::setw(12) << "Efficiency";
+    for (const thread_scaling::point& p : scaling.points()) {
+        str << "\n"
+            << std::setw(10) << p.threads << std::setw(16)
+            << std::setprecision(2) << p.events_per_second() << std::setw(12)
+            << std::setprecision(2) << scaling.speedup(p) << std::setw(11)
+            << std::setprecision(1) << scaling.efficiency(p) * 100. << "%";
+    }
+    return out << str.str();
+}
+
+}  // namespace traccc::performance
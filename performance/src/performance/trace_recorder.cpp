@@ -0,0 +1,67 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Library include(s).
+#include "traccc/performance/trace_recorder.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+namespace traccc::performance {
+
+trace_recorder::buffer::buffer(unsigned int thread_id, std::size_t capacity)
+    : m_thread_id(thread_id), m_spans(std::max<std::size_t>(capacity, 1u)) {}
+
+trace_recorder::trace_recorder(std::size_t capacity)
+    : m_start(clock::now()), m_capacity(capacity) {}
+
+trace_recorder::buffer& trace_recorder::make_buffer(unsigned int thread_id) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_buffers.emplace_back(thread_id, m_capacity);
+}
+
+void trace_recorder::write_json(std::ostream& out) const {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Time since the start of the trace, in (fractional) microseconds
+    auto to_us = [this](clock::time_point t) {
+        return std::chrono::duration<double, std::micro>(t - m_start).count();
+    };
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    bool first = true;
+    for (const buffer& buf : m_buffers) {
+
+        // Give the threads readable names
+        out << (first ? "\n" : ",\n")
+            << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, "
+               "\"tid\": "
+            << buf.m_thread_id << ", \"args\": {\"name\": \"Thread "
+            << buf.m_thread_id << "\"}}";
+        first = false;
+
+        // Write the spans still in the buffer, oldest first
+        const std::size_t size = buf.m_spans.size();
+        const std::size_t n = std::min(buf.m_next, size);
+        for (std::size_t i = buf.m_next - n; i < buf.m_next; ++i) {
+            const span& s = buf.m_spans[i % size];
+            out << ",\n{\"name\": \"" << s.name
+                << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": "
+                << buf.m_thread_id << ", \"ts\": " << to_us(s.begin)
+                << ", \"dur\": " << to_us(s.end) - to_us(s.begin)
+                << ", \"args\": {\"event\": " << s.event << "}}";
+        }
+    }
+    out << "\n]}\n";
+}
+
+}  // namespace traccc::performance
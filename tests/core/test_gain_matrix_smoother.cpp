@@ -0,0 +1,132 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/edm/measurement.hpp"
+#include "traccc/edm/track_parameters.hpp"
+#include "traccc/edm/track_state.hpp"
+#include "traccc/fitting/kalman_filter/gain_matrix_smoother.hpp"
+
+// Detray include(s).
+#include "detray/masks/masks.hpp"
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+// System include(s).
+#include <cmath>
+
+using namespace traccc;
+
+namespace {
+
+using matrix_operator = typename transform3::matrix_actor;
+
+/// Set bound track parameters with a diagonal covariance
+void set_diagonal(bound_track_parameters& params,
+                  const scalar (&vec)[e_bound_size],
+                  const scalar (&var)[e_bound_size]) {
+
+    bound_vector v = params.vector();
+    bound_covariance cov = params.covariance();
+    for (unsigned int i = 0; i < e_bound_size; ++i) {
+        getter::element(v, i, 0u) = vec[i];
+        for (unsigned int j = 0; j < e_bound_size; ++j) {
+            getter::element(cov, i, j) = (i == j) ? var[i] : 0.f;
+        }
+    }
+    params.set_vector(v);
+    params.set_covariance(cov);
+}
+
+/// Smooth a track state with uncorrelated parameters and a unit transport
+/// jacobian, for which the result is known in closed form
+///
+/// @param predicted_var The predicted variances of the next track state,
+///                      which do not need to be positive
+template <typename update_scalar_t>
+void test_uncorrelated_smoothing(const scalar (&predicted_var)[e_bound_size]) {
+
+    // Measurement on the local coordinates
+    measurement meas;
+    meas.local = {1.f, -2.f};
+    meas.variance = {1.f, 2.f};
+    track_state<transform3> cur_state(meas);
+    track_state<transform3> next_state(meas);
+
+    const scalar filtered_vec[e_bound_size] = {0.9f, -1.9f, 0.1f,
+                                               1.2f, 0.01f, 0.f};
+    const scalar filtered_var[e_bound_size] = {0.04f, 0.09f, 0.01f,
+                                               0.01f, 1e-4f, 1.f};
+    const scalar predicted_vec[e_bound_size] = {1.f, -2.f, 0.12f,
+                                                1.18f, 0.011f, 0.1f};
+    const scalar smoothed_vec[e_bound_size] = {0.95f, -2.1f, 0.11f,
+                                               1.19f, 0.012f, 0.2f};
+    const scalar smoothed_var[e_bound_size] = {0.03f, 0.08f, 0.008f,
+                                               0.009f, 8e-5f, 0.9f};
+    set_diagonal(cur_state.filtered(), filtered_vec, filtered_var);
+    set_diagonal(next_state.predicted(), predicted_vec, predicted_var);
+    set_diagonal(next_state.smoothed(), smoothed_vec, smoothed_var);
+    next_state.jacobian() =
+        matrix_operator().template identity<e_bound_size, e_bound_size>();
+
+    // Run the smoothing
+    gain_matrix_smoother<transform3, update_scalar_t>{}
+        .template smoothe<2u, detray::rectangle2D<>>(cur_state, next_state);
+
+    const auto& smt_vec = cur_state.smoothed().vector();
+    const auto& smt_cov = cur_state.smoothed().covariance();
+    scalar chi2 = 0.f;
+    for (unsigned int i = 0; i < e_bound_size; ++i) {
+        const scalar a = filtered_var[i] / predicted_var[i];
+        const scalar x =
+            filtered_vec[i] + a * (smoothed_vec[i] - predicted_vec[i]);
+        const scalar c =
+            filtered_var[i] + a * a * (smoothed_var[i] - predicted_var[i]);
+        ASSERT_TRUE(std::isfinite(getter::element(smt_vec, i, 0u)));
+        EXPECT_NEAR(getter::element(smt_vec, i, 0u), x,
+                    1e-5f * (1.f + std::abs(x)));
+        EXPECT_NEAR(getter::element(smt_cov, i, i), c,
+                    1e-5f * (1.f + std::abs(c)));
+        for (unsigned int j = 0; j < i; ++j) {
+            EXPECT_NEAR(getter::element(smt_cov, i, j), 0.f, 1e-6f);
+        }
+        if (i < 2u) {
+            const scalar r = meas.local[i] - x;
+            chi2 += r * r / (meas.variance[i] - c);
+        }
+    }
+    EXPECT_NEAR(cur_state.smoothed_chi2(), chi2, 1e-4f);
+}
+
+/// Predicted variances of a positive definite covariance
+constexpr scalar positive_var[e_bound_size] = {0.05f, 0.1f,  0.012f,
+                                               0.011f, 2e-4f, 1.1f};
+/// Predicted variances of a covariance that is not positive definite
+constexpr scalar indefinite_var[e_bound_size] = {-0.05f, 0.1f,  0.012f,
+                                                 0.011f, 2e-4f, 1.1f};
+
+}  // namespace
+
+TEST(gain_matrix_smoother, uncorrelated_smoothing) {
+    test_uncorrelated_smoothing<scalar>(positive_var);
+}
+
+TEST(gain_matrix_smoother, uncorrelated_smoothing_double_precision) {
+    test_uncorrelated_smoothing<double>(positive_var);
+}
+
+// A predicted covariance that is not positive definite can not be inverted
+// through its Cholesky decomposition. The smoother has to fall back to the
+// general inverse, instead of producing NaNs.
+TEST(gain_matrix_smoother, not_positive_definite) {
+    test_uncorrelated_smoothing<scalar>(indefinite_var);
+}
+
+TEST(gain_matrix_smoother, not_positive_definite_double_precision) {
+    test_uncorrelated_smoothing<double>(indefinite_var);
+}
@@ -0,0 +1,92 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/edm/measurement.hpp"
+#include "traccc/edm/track_parameters.hpp"
+#include "traccc/edm/track_state.hpp"
+#include "traccc/fitting/kalman_filter/gain_matrix_updater.hpp"
+
+// Detray include(s).
+#include "detray/masks/masks.hpp"
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+using namespace traccc;
+
+namespace {
+
+/// Run the Kalman update of a 2D measurement on uncorrelated track
+/// parameters, for which the result is known in closed form
+template <typename update_scalar_t>
+void test_uncorrelated_update() {
+
+    // Measurement on the local coordinates
+    measurement meas;
+    meas.local = {1.f, -2.f};
+    meas.variance = {0.01f, 0.04f};
+    track_state<transform3> trk_state(meas);
+
+    // Predicted parameters with a diagonal covariance
+    const scalar x[2] = {0.5f, -1.5f};
+    const scalar p[2] = {0.04f, 0.09f};
+    bound_track_parameters bound_params;
+    bound_vector vec = bound_params.vector();
+    bound_covariance cov = bound_params.covariance();
+    for (unsigned int i = 0; i < e_bound_size; ++i) {
+        getter::element(vec, i, 0u) = 0.f;
+        for (unsigned int j = 0; j < e_bound_size; ++j) {
+            getter::element(cov, i, j) = (i == j) ? 1.f : 0.f;
+        }
+    }
+    for (unsigned int i = 0; i < 2u; ++i) {
+        getter::element(vec, i, 0u) = x[i];
+        getter::element(cov, i, i) = p[i];
+    }
+    bound_params.set_vector(vec);
+    bound_params.set_covariance(cov);
+
+    // Run the update
+    gain_matrix_updater<transform3, update_scalar_t>{}
+        .template update<2u, detray::rectangle2D<>>(trk_state, bound_params);
+
+    const auto& filtered_vec = trk_state.filtered().vector();
+    const auto& filtered_cov = trk_state.filtered().covariance();
+    scalar chi2 = 0.f;
+    for (unsigned int i = 0; i < 2u; ++i) {
+        const scalar m = meas.local[i];
+        const scalar v = meas.variance[i];
+        EXPECT_NEAR(getter::element(filtered_vec, i, 0u),
+                    x[i] + p[i] / (p[i] + v) * (m - x[i]), 1e-5f);
+        EXPECT_NEAR(getter::element(filtered_cov, i, i),
+                    p[i] * v / (p[i] + v), 1e-6f);
+        chi2 += (m - x[i]) * (m - x[i]) / (p[i] + v);
+    }
+    EXPECT_NEAR(getter::element(filtered_cov, 0u, 1u), 0.f, 1e-6f);
+    EXPECT_NEAR(trk_state.filtered_chi2(), chi2, 1e-4f);
+
+    // The unmeasured parameters must not change
+    for (unsigned int i = 2u; i < e_bound_size; ++i) {
+        EXPECT_FLOAT_EQ(getter::element(filtered_vec, i, 0u), 0.f);
+        EXPECT_FLOAT_EQ(getter::element(filtered_cov, i, i), 1.f);
+    }
+
+    // The stepper parameters are updated as well
+    EXPECT_FLOAT_EQ(getter::element(bound_params.vector(), 0u, 0u),
+                    getter::element(filtered_vec, 0u, 0u));
+}
+
+}  // namespace
+
+TEST(gain_matrix_updater, uncorrelated_update) {
+    test_uncorrelated_update<scalar>();
+}
+
+TEST(gain_matrix_updater, uncorrelated_update_double_precision) {
+    test_uncorrelated_update<double>();
+}
@@ -0,0 +1,151 @@
+/**
+ * TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/utils/instrumented_memory_resource.hpp"
+
+// VecMem include(s).
+#include <vecmem/containers/vector.hpp>
+#include <vecmem/memory/host_memory_resource.hpp>
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+// System include(s).
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// Memory resource counting the calls made to it concurrently
+class concurrency_checking_resource : public vecmem::memory_resource {
+
+    public:
+    /// The largest number of calls that were running at the same time
+    std::atomic<int> max_concurrent_calls{0};
+
+    private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        enter();
+        void* ptr = m_host_mr.allocate(bytes, alignment);
+        leave();
+        return ptr;
+    }
+    void do_deallocate(void* ptr, std::size_t bytes,
+                       std::size_t alignment) override {
+        enter();
+        m_host_mr.deallocate(ptr, bytes, alignment);
+        leave();
+    }
+    bool do_is_equal(
+        const vecmem::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+    void enter() {
+        const int calls = ++m_calls;
+        int max = max_concurrent_calls.load();
+        while ((calls > max) &&
+               !max_concurrent_calls.compare_exchange_weak(max, calls)) {
+        }
+        std::this_thread::yield();
+    }
+    void leave() { --m_calls; }
+
+    vecmem::host_memory_resource m_host_mr;
+    std::atomic<int> m_calls{0};
+};
+
+}  // namespace
+
+TEST(instrumented_memory_resource, tags) {
+
+    vecmem::host_memory_resource host_mr;
+    traccc::instrumented_memory_resource mr(host_mr);
+
+    EXPECT_EQ(traccc::instrumented_memory_resource::current_tag(),
+              traccc::instrumented_memory_resource::untagged);
+    {
+        // An allocation that outlives its scope
+        vecmem::vector<int> kept(&mr);
+        {
+            traccc::instrumented_memory_resource::scope s{"Clusterization"};
+            kept.resize(100);
+
+            // Scopes can be nested
+            traccc::instrumented_memory_resource::scope s2{"Seeding"};
+            vecmem::vector<int> tmp(&mr);
+            tmp.resize(10);
+        }
+        EXPECT_EQ(traccc::instrumented_memory_resource::current_tag(),
+                  traccc::instrumented_memory_resource::untagged);
+
+        const traccc::memory_profile profile = mr.profile();
+        ASSERT_EQ(profile.tags.size(), 2u);
+        EXPECT_EQ(profile.tags[0].first, "Clusterization");
+        EXPECT_EQ(profile.tags[0].second.allocations, 1u);
+        EXPECT_EQ(profile.tags[0].second.live_bytes, 100 * sizeof(int));
+        EXPECT_EQ(profile.tags[1].first, "Seeding");
+        EXPECT_EQ(profile.tags[1].second.deallocations, 1u);
+        EXPECT_EQ(profile.tags[1].second.live_bytes, 0u);
+        EXPECT_EQ(profile.tags[1].second.peak_bytes, 10 * sizeof(int));
+        EXPECT_EQ(profile.total.peak_bytes, 110 * sizeof(int));
+    }
+
+    // The deallocation outside of the scope is attributed to the tag that
+    // made the allocation
+    traccc::memory_profile profile = mr.profile();
+    EXPECT_EQ(profile.tags[0].second.deallocations, 1u);
+    EXPECT_EQ(profile.tags[0].second.live_bytes, 0u);
+    EXPECT_EQ(profile.total.live_bytes, 0u);
+
+    // Resetting the counters lowers the peaks to the live bytes
+    mr.reset_counters();
+    profile = mr.profile();
+    EXPECT_EQ(profile.tags[0].second.allocations, 0u);
+    EXPECT_EQ(profile.total.peak_bytes, 0u);
+
+    // Profiles can be combined, and printed
+    traccc::memory_profile sum;
+    sum += mr.profile();
+    sum += mr.profile();
+    EXPECT_EQ(sum.tags.size(), 2u);
+    std::ostringstream out;
+    out << sum;
+    EXPECT_NE(out.str().find("Clusterization"), std::string::npos);
+}
+
+TEST(instrumented_memory_resource, serialised_upstream) {
+
+    // The upstream resource must never be called from multiple threads at
+    // the same time
+    concurrency_checking_resource upstream_mr;
+    traccc::instrumented_memory_resource mr(upstream_mr);
+
+    static constexpr std::size_t n_threads = 8u;
+    static constexpr std::size_t n_allocations = 1000u;
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < n_threads; ++i) {
+        threads.emplace_back([&mr]() {
+            for (std::size_t j = 0; j < n_allocations; ++j) {
+                vecmem::vector<int> v(&mr);
+                v.resize(10);
+            }
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(upstream_mr.max_concurrent_calls.load(), 1);
+    const traccc::memory_profile profile = mr.profile();
+    EXPECT_EQ(profile.total.allocations, n_threads * n_allocations);
+    EXPECT_EQ(profile.total.live_bytes, 0u);
+}
@@ -0,0 +1,142 @@
+/**
+ * TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/utils/monotonic_memory_resource.hpp"
+#include "traccc/utils/monotonic_memory_resource_pool.hpp"
+
+// VecMem include(s).
+#include <vecmem/containers/jagged_vector.hpp>
+#include <vecmem/containers/vector.hpp>
+#include <vecmem/memory/host_memory_resource.hpp>
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+// System include(s).
+#include <cstdint>
+
+namespace {
+
+/// Memory resource counting the allocations made through it
+class counting_memory_resource : public vecmem::memory_resource {
+
+    public:
+    std::size_t n_allocations = 0;
+    std::size_t n_deallocations = 0;
+
+    private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++n_allocations;
+        return m_upstream.allocate(bytes, alignment);
+    }
+    void do_deallocate(void* ptr, std::size_t bytes,
+                       std::size_t alignment) override {
+        ++n_deallocations;
+        m_upstream.deallocate(ptr, bytes, alignment);
+    }
+    bool do_is_equal(
+        const vecmem::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    vecmem::host_memory_resource m_upstream;
+};
+
+/// Fill some containers the way an algorithm would during one event
+void run_event(vecmem::memory_resource& mr) {
+
+    vecmem::vector<double> values(&mr);
+    for (int i = 0; i < 10000; i++) {
+        values.push_back(i);
+    }
+    vecmem::jagged_vector<unsigned int> links(&mr);
+    links.resize(20);
+    for (auto& l : links) {
+        l.resize(100u, 1u);
+    }
+    ASSERT_EQ(values.back(), 9999.);
+    ASSERT_EQ(links[19][99], 1u);
+}
+
+}  // namespace
+
+TEST(monotonic_memory_resource, reuse_after_reset) {
+
+    counting_memory_resource upstream;
+    {
+        traccc::monotonic_memory_resource arena(upstream, 1024u);
+
+        // The first event makes the arena grow
+        arena.reset();
+        run_event(arena);
+        EXPECT_GT(upstream.n_allocations, 1u);
+
+        // The blocks are merged on the next reset, after which the same
+        // workload does not allocate from upstream any more
+        arena.reset();
+        const std::size_t n_allocations = upstream.n_allocations;
+        run_event(arena);
+        arena.reset();
+        run_event(arena);
+        EXPECT_EQ(upstream.n_allocations, n_allocations);
+    }
+
+    // All memory is given back when the arena is destroyed
+    EXPECT_EQ(upstream.n_allocations, upstream.n_deallocations);
+}
+
+TEST(monotonic_memory_resource, alignment) {
+
+    vecmem::host_memory_resource upstream;
+    traccc::monotonic_memory_resource arena(upstream, 256u);
+
+    for (std::size_t alignment : {1u, 8u, 16u, 64u, 128u}) {
+        void* ptr = arena.allocate(3u, alignment);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % alignment, 0u);
+    }
+    // Allocations larger than a block get a block of their own
+    void* ptr = arena.allocate(4096u, 64u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 64u, 0u);
+}
+
+TEST(monotonic_memory_resource, pool) {
+
+    counting_memory_resource upstream;
+    {
+        traccc::monotonic_memory_resource_pool pool(upstream, 1024u);
+
+        // Calls running at the same time get different arenas
+        traccc::monotonic_memory_resource* first_arena = nullptr;
+        {
+            const auto first = pool.acquire();
+            const auto second = pool.acquire();
+            EXPECT_NE(&*first, &*second);
+            run_event(*first);
+            run_event(*second);
+            first_arena = &*first;
+        }
+
+        // The arenas are re-used by the following calls, which stop
+        // allocating from upstream once the arena has grown
+        {
+            const auto lease = pool.acquire();
+            EXPECT_EQ(&*lease, first_arena);
+            run_event(*lease);
+        }
+        const std::size_t n_allocations = upstream.n_allocations;
+        for (int i = 0; i < 2; i++) {
+            const auto lease = pool.acquire();
+            run_event(*lease);
+        }
+        EXPECT_EQ(upstream.n_allocations, n_allocations);
+    }
+
+    // All memory is given back when the pool is destroyed
+    EXPECT_EQ(upstream.n_allocations, upstream.n_deallocations);
+}
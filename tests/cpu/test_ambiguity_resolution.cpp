@@ -0,0 +1,235 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/ambiguity_resolution/greedy_ambiguity_resolution_algorithm.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/host_memory_resource.hpp>
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+// System include(s).
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace traccc;
+
+namespace {
+
+/// Make a track candidate from a list of measurement (surface) identifiers
+void add_track(track_candidate_container_types::host& tracks,
+               const std::vector<detray::dindex>& meas_ids) {
+
+    vecmem::vector<track_candidate> cands;
+    for (detray::dindex id : meas_ids) {
+        track_candidate cand;
+        cand.surface_link = detray::geometry::barcode{}.set_index(id);
+        cands.push_back(cand);
+    }
+    tracks.push_back(bound_track_parameters{}, std::move(cands));
+}
+
+/// Reference implementation, removing the most ambiguous track one by one,
+/// and counting the shared measurements from scratch in every iteration
+///
+/// @return the indices of the surviving tracks
+std::vector<unsigned int> resolve_one_by_one(
+    const std::vector<std::vector<detray::dindex>>& tracks,
+    const ambiguity_resolution_config& cfg) {
+
+    std::vector<char> accepted(tracks.size());
+    for (std::size_t i = 0; i < tracks.size(); i++) {
+        accepted[i] = (tracks[i].size() >= cfg.n_measurements_min);
+    }
+
+    for (unsigned int iter = 0; iter < cfg.maximum_iterations; iter++) {
+
+        // Count the shared measurements of the surviving tracks
+        std::vector<unsigned int> n_shared(tracks.size(), 0u);
+        for (std::size_t i = 0; i < tracks.size(); i++) {
+            for (detray::dindex m : tracks[i]) {
+                for (std::size_t j = 0; j < tracks.size() && accepted[i];
+                     j++) {
+                    if (j != i && accepted[j] &&
+                        std::find(tracks[j].begin(), tracks[j].end(), m) !=
+                            tracks[j].end()) {
+                        ++n_shared[i];
+                        break;
+                    }
+                }
+            }
+        }
+
+        // Find the most ambiguous track
+        int worst = -1;
+        unsigned int max_shared = 0;
+        for (std::size_t i = 0; i < tracks.size(); i++) {
+            if (!accepted[i]) {
+                continue;
+            }
+            max_shared = std::max(max_shared, n_shared[i]);
+            if (worst < 0) {
+                worst = static_cast<int>(i);
+                continue;
+            }
+            const std::size_t w = static_cast<std::size_t>(worst);
+            const std::size_t i_rel = n_shared[i] * tracks[w].size();
+            const std::size_t w_rel = n_shared[w] * tracks[i].size();
+            if (i_rel > w_rel ||
+                (i_rel == w_rel && tracks[i].size() <= tracks[w].size())) {
+                worst = static_cast<int>(i);
+            }
+        }
+        if (worst < 0 || max_shared < cfg.maximum_shared_hits) {
+            break;
+        }
+        accepted[static_cast<std::size_t>(worst)] = 0;
+    }
+
+    std::vector<unsigned int> result;
+    for (unsigned int i = 0; i < tracks.size(); i++) {
+        if (accepted[i]) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(ambiguity_resolution, shared_measurements) {
+
+    // Memory resource used by the EDM.
+    vecmem::host_memory_resource host_mr;
+
+    track_candidate_container_types::host tracks;
+    // Two duplicates of the same track, the second one is shorter
+    add_track(tracks, {0u, 1u, 2u, 3u, 4u});
+    add_track(tracks, {0u, 1u, 2u, 3u});
+    // A track sharing a single measurement with the first one
+    add_track(tracks, {4u, 5u, 6u, 7u});
+    // An independent track
+    add_track(tracks, {8u, 9u, 10u});
+    // A track that is too short
+    add_track(tracks, {11u, 12u});
+
+    ambiguity_resolution_config cfg;
+    cfg.maximum_shared_hits = 1;
+    cfg.n_measurements_min = 3;
+
+    greedy_ambiguity_resolution_algorithm resolution(cfg, host_mr);
+    const auto resolved = resolution(tracks);
+
+    // The shorter duplicate and the track that shares the measurement with
+    // the first one are removed. The short track is not considered.
+    ASSERT_EQ(resolved.size(), 2u);
+    EXPECT_EQ(resolved[0].items.size(), 5u);
+    EXPECT_EQ(resolved[1].items.size(), 3u);
+}
+
+TEST(ambiguity_resolution, no_shared_measurements) {
+
+    // Memory resource used by the EDM.
+    vecmem::host_memory_resource host_mr;
+
+    track_candidate_container_types::host tracks;
+    add_track(tracks, {0u, 1u, 2u});
+    add_track(tracks, {3u, 4u, 5u});
+    add_track(tracks, {6u, 7u, 8u});
+
+    greedy_ambiguity_resolution_algorithm resolution(
+        ambiguity_resolution_config{}, host_mr);
+    const auto resolved = resolution(tracks);
+
+    ASSERT_EQ(resolved.size(), 3u);
+    for (unsigned int i = 0; i < 3u; i++) {
+        EXPECT_EQ(resolved[i].items.size(), 3u);
+    }
+}
+
+// Removing the tracks in batches must give the same result as removing them
+// one by one
+TEST(ambiguity_resolution, one_by_one) {
+
+    // Memory resource used by the EDM.
+    vecmem::host_memory_resource host_mr;
+
+    std::mt19937 rng(42u);
+    std::uniform_int_distribution<detray::dindex> meas_dist(0u, 99u);
+    std::uniform_int_distribution<std::size_t> size_dist(2u, 8u);
+
+    for (unsigned int maximum_shared_hits : {1u, 2u, 3u}) {
+        for (unsigned int maximum_iterations : {5u, 1000u}) {
+
+            // Random tracks, with distinct measurements each
+            std::vector<std::vector<detray::dindex>> meas_ids(200u);
+            track_candidate_container_types::host tracks;
+            for (auto& ids : meas_ids) {
+                const std::size_t size = size_dist(rng);
+                while (ids.size() < size) {
+                    const detray::dindex id = meas_dist(rng);
+                    if (std::find(ids.begin(), ids.end(), id) == ids.end()) {
+                        ids.push_back(id);
+                    }
+                }
+                add_track(tracks, ids);
+            }
+
+            ambiguity_resolution_config cfg;
+            cfg.maximum_shared_hits = maximum_shared_hits;
+            cfg.maximum_iterations = maximum_iterations;
+            cfg.n_measurements_min = 3;
+
+            greedy_ambiguity_resolution_algorithm resolution(cfg, host_mr);
+            const auto resolved = resolution(tracks);
+            const std::vector<unsigned int> expected =
+                resolve_one_by_one(meas_ids, cfg);
+
+            ASSERT_EQ(resolved.size(), expected.size());
+            for (std::size_t i = 0; i < expected.size(); i++) {
+                const auto& items = resolved[i].items;
+                ASSERT_EQ(items.size(), meas_ids[expected[i]].size());
+                for (std::size_t j = 0; j < items.size(); j++) {
+                    EXPECT_EQ(items[j].surface_link.index(),
+                              meas_ids[expected[i]][j]);
+                }
+            }
+        }
+    }
+}
+
+TEST(ambiguity_resolution, short_tracks) {
+
+    // Memory resource used by the EDM.
+    vecmem::host_memory_resource host_mr;
+
+    track_candidate_container_types::host tracks;
+    add_track(tracks, {0u, 1u});
+    add_track(tracks, {2u});
+    add_track(tracks, {3u, 4u, 5u});
+
+    // Short tracks that do not share measurements are kept without the
+    // minimum length cut
+    greedy_ambiguity_resolution_algorithm resolution(
+        ambiguity_resolution_config{}, host_mr);
+    const auto resolved = resolution(tracks);
+    ASSERT_EQ(resolved.size(), 3u);
+    EXPECT_EQ(resolved[0].items.size(), 2u);
+    EXPECT_EQ(resolved[1].items.size(), 1u);
+    EXPECT_EQ(resolved[2].items.size(), 3u);
+
+    // ...and removed with it
+    ambiguity_resolution_config cfg;
+    cfg.n_measurements_min = 3;
+    greedy_ambiguity_resolution_algorithm resolution_with_cut(cfg, host_mr);
+    const auto resolved_with_cut = resolution_with_cut(tracks);
+    ASSERT_EQ(resolved_with_cut.size(), 1u);
+    EXPECT_EQ(resolved_with_cut[0].items.size(), 3u);
+}
@@ -0,0 +1,93 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/performance/benchmark_report.hpp"
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+// System include(s).
+#include <chrono>
+#include <sstream>
+#include <string>
+
+using namespace traccc::performance;
+
+TEST(benchmark_report, json) {
+
+    timing_info times;
+    times.data.push_back({"Event processing", std::chrono::milliseconds{200}});
+
+    event_latency_recorder latencies;
+    latencies.record(std::chrono::microseconds{10}, 100);
+
+    benchmark_report report;
+    report.application = "test \"application\"";
+    report.add_configuration("loaded_events", 10);
+    report.add_configuration("use_host_caching", true);
+    report.threads = 4;
+    report.processed_events = 10;
+    report.times = &times;
+    report.latencies = &latencies;
+
+    std::ostringstream out;
+    write_json(out, report);
+    const std::string json = out.str();
+
+    // Check some of the members, and that strings are escaped
+    EXPECT_NE(json.find("\"application\": \"test \\\"application\\\"\""),
+              std::string::npos);
+    EXPECT_NE(json.find("\"use_host_caching\": \"true\""), std::string::npos);
+    EXPECT_NE(json.find("\"threads\": 4"), std::string::npos);
+    EXPECT_NE(json.find("\"ms_per_event\": 20"), std::string::npos);
+    EXPECT_NE(json.find("\"p99_ns\": 10000"), std::string::npos);
+    EXPECT_NE(json.find("\"peak_rss_bytes\""), std::string::npos);
+    // No stage timing was given
+    EXPECT_EQ(json.find("\"stages\""), std::string::npos);
+}
+
+TEST(benchmark_report, allocations) {
+
+    traccc::memory_profile allocations;
+    allocations.tags.push_back({"Seeding", {}});
+    allocations.tags.back().second.allocations = 3;
+    allocations.tags.back().second.peak_bytes = 1024;
+    allocations.total = allocations.tags.back().second;
+
+    benchmark_report report;
+    report.allocations = &allocations;
+
+    std::ostringstream out;
+    write_json(out, report);
+    const std::string json = out.str();
+    EXPECT_NE(json.find("{\"tag\": \"Seeding\", \"allocations\": 3, "),
+              std::string::npos);
+    EXPECT_NE(json.find("{\"tag\": \"Total\""), std::string::npos);
+    EXPECT_NE(json.find("\"peak_bytes\": 1024"), std::string::npos);
+}
+
+TEST(benchmark_report, hardware_counters) {
+
+    stage_timing stage_times{true};
+    {
+        stage_timing::scope t{&stage_times.make_accumulator(), stage::seeding};
+    }
+
+    benchmark_report report;
+    report.stage_times = &stage_times;
+
+    std::ostringstream out;
+    write_json(out, report);
+    const std::string json = out.str();
+    EXPECT_NE(json.find("{\"name\": \"Seeding\", \"calls\": 1"),
+              std::string::npos);
+    // The scope of the counters is stated next to them
+    EXPECT_NE(json.find("\"counters_note\": \"" +
+                        std::string(hw_counter_caveat) + "\""),
+              std::string::npos);
+}
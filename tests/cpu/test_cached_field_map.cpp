@@ -0,0 +1,226 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/definitions/common.hpp"
+#include "traccc/edm/track_parameters.hpp"
+#include "traccc/utils/cached_field_map.hpp"
+
+// detray include(s).
+#include "detray/detectors/bfield.hpp"
+#include "detray/detectors/create_telescope_detector.hpp"
+#include "detray/intersection/detail/trajectories.hpp"
+#include "detray/propagator/actor_chain.hpp"
+#include "detray/propagator/actors/aborters.hpp"
+#include "detray/propagator/actors/parameter_transporter.hpp"
+#include "detray/propagator/navigator.hpp"
+#include "detray/propagator/propagator.hpp"
+#include "detray/propagator/rk_stepper.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/host_memory_resource.hpp>
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+// System include(s).
+#include <stdexcept>
+#include <vector>
+
+using namespace traccc;
+
+namespace {
+
+/// Field that changes linearly with the position, which the trilinear
+/// interpolation reproduces exactly
+struct linear_field {
+    cached_field_map::vector_type at(scalar x, scalar y, scalar z) const {
+        return {1.f + 0.1f * x, -0.2f * y + 0.05f * z, 2.f + 0.01f * x};
+    }
+};
+
+// Types of the propagation through a telescope detector
+using detector_type =
+    detray::detector<detray::telescope_metadata<detray::rectangle2D<>>,
+                     detray::host_container_types>;
+using navigator_type = detray::navigator<const detector_type>;
+using actor_type =
+    detray::actor_chain<std::tuple, detray::pathlimit_aborter,
+                        detray::parameter_transporter<transform3>,
+                        detray::next_surface_aborter>;
+using matrix_operator = typename transform3::matrix_actor;
+
+/// Propagate a track from the first plane of a telescope detector through
+/// all of its other planes, recording the bound parameters on every plane
+template <typename field_view_t>
+std::vector<bound_track_parameters> propagate_through(
+    const detector_type& det, const field_view_t& field,
+    const bound_track_parameters& start) {
+
+    using stepper_type = detray::rk_stepper<field_view_t, transform3,
+                                            detray::constrained_step<>>;
+    using propagator_type =
+        detray::propagator<stepper_type, navigator_type, actor_type>;
+
+    propagator_type propagator({}, {});
+    std::vector<bound_track_parameters> result;
+    bound_track_parameters param = start;
+    while (true) {
+        typename propagator_type::state propagation(param, field, det);
+        typename detray::pathlimit_aborter::state s0;
+        typename detray::parameter_transporter<transform3>::state s1;
+        typename detray::next_surface_aborter::state s2{
+            0.1f * detray::unit<scalar>::mm};
+
+        propagation._navigation.set_volume(param.surface_link().volume());
+        propagator.propagate_sync(propagation, std::tie(s0, s1, s2));
+        if (!s2.success) {
+            break;
+        }
+        param = propagation._stepping._bound_params;
+        result.push_back(param);
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(cached_field_map, invalid_grid) {
+
+    const linear_field field;
+
+    // The interpolation needs at least one cell along every axis
+    EXPECT_THROW(cached_field_map(field, {0.f, 0.f, 0.f}, {1.f, 1.f, 1.f},
+                                  {2u, 1u, 2u}),
+                 std::invalid_argument);
+    EXPECT_THROW(cached_field_map(field, {0.f, 0.f, 0.f}, {1.f, 1.f, 1.f},
+                                  {0u, 2u, 2u}),
+                 std::invalid_argument);
+    // The grid must have a positive extent along every axis
+    EXPECT_THROW(cached_field_map(field, {0.f, 0.f, 0.f}, {1.f, 0.f, 1.f},
+                                  {2u, 2u, 2u}),
+                 std::invalid_argument);
+    EXPECT_NO_THROW(cached_field_map(field, {0.f, 0.f, 0.f}, {1.f, 1.f, 1.f},
+                                     {2u, 2u, 2u}));
+}
+
+TEST(cached_field_map, interpolation) {
+
+    const linear_field field;
+    const cached_field_map map(field, {-10.f, -10.f, -10.f}, {10.f, 10.f, 10.f},
+                               {5u, 5u, 5u});
+    const cached_field_map::view_t view(map);
+
+    for (const auto& pos :
+         {cached_field_map::vector_type{0.f, 0.f, 0.f},
+          cached_field_map::vector_type{1.3f, -7.2f, 4.9f},
+          cached_field_map::vector_type{-9.9f, 9.9f, -0.1f}}) {
+        const auto expected = field.at(pos[0], pos[1], pos[2]);
+        const auto b = view.at(pos[0], pos[1], pos[2]);
+        for (unsigned int i = 0; i < 3; ++i) {
+            EXPECT_NEAR(b[i], expected[i], 1e-4f);
+        }
+    }
+
+    // Points outside of the grid are clamped onto its boundary
+    const auto b_out = view.at(20.f, 0.f, 0.f);
+    EXPECT_NEAR(b_out[0], field.at(10.f, 0.f, 0.f)[0], 1e-4f);
+}
+
+TEST(cached_field_map, cell_cache) {
+
+    const linear_field field;
+    const cached_field_map map(field, {0.f, 0.f, 0.f}, {10.f, 10.f, 10.f},
+                               {11u, 11u, 11u});
+    {
+        const cached_field_map::view_t view(map);
+
+        // Successive lookups inside of the same cell only load it once
+        view.at(0.1f, 0.1f, 0.1f);
+        view.at(0.5f, 0.2f, 0.9f);
+        view.at(0.9f, 0.9f, 0.3f);
+        EXPECT_EQ(view.n_lookups(), 3u);
+        EXPECT_EQ(view.n_cell_loads(), 1u);
+
+        // Moving into a new cell loads it
+        view.at(1.5f, 0.1f, 0.1f);
+        EXPECT_EQ(view.n_lookups(), 4u);
+        EXPECT_EQ(view.n_cell_loads(), 2u);
+
+        // Copies of the view start with an empty cache
+        const cached_field_map::view_t copy(view);
+        copy.at(1.5f, 0.1f, 0.1f);
+        EXPECT_EQ(copy.n_lookups(), 1u);
+        EXPECT_EQ(copy.n_cell_loads(), 1u);
+
+        // The counts are only added to the map by the destroyed views
+        EXPECT_EQ(map.n_lookups(), 0u);
+    }
+    EXPECT_EQ(map.n_lookups(), 5u);
+    EXPECT_EQ(map.n_cell_loads(), 3u);
+}
+
+// Propagating with the Runge-Kutta stepper through a map sampled from a
+// constant field gives the same result as the constant field itself
+TEST(cached_field_map, rk_propagation) {
+
+    vecmem::host_memory_resource host_mr;
+
+    // Telescope detector with 9 planes along the x axis
+    detray::mask<detray::rectangle2D<>> rectangle{
+        0u, 1000.f * detray::unit<scalar>::mm,
+        1000.f * detray::unit<scalar>::mm};
+    detray::detail::ray<transform3> traj{{0, 0, 0}, 0, {1, 0, 0}, -1};
+    const std::vector<scalar> plane_positions = {
+        0.f, 100.f, 200.f, 300.f, 400.f, 500.f, 600.f, 700.f, 800.f};
+
+    detray::tel_det_config<> tel_cfg{rectangle};
+    tel_cfg.positions(plane_positions);
+    tel_cfg.pilot_track(traj);
+    const auto [det, names] = create_telescope_detector(host_mr, tel_cfg);
+
+    // Constant 2T field, and a map sampled from it with 100 mm cells
+    const vector3 B{0, 0, 2 * detray::unit<scalar>::T};
+    const auto const_field = detray::bfield::create_const_field(B);
+    using const_view_t = typename decltype(const_field)::view_t;
+    const cached_field_map map(const_view_t(const_field),
+                               {-100.f, -1100.f, -1100.f},
+                               {900.f, 1100.f, 1100.f}, {11u, 23u, 23u});
+
+    // A 1 GeV track leaving the first plane at an angle
+    const detray::geometry::barcode first = det.surface_lookup()[0].barcode();
+    bound_vector vec = matrix_operator().template zero<e_bound_size, 1>();
+    getter::element(vec, e_bound_phi, 0u) = 0.1f;
+    getter::element(vec, e_bound_theta, 0u) = 1.4f;
+    getter::element(vec, e_bound_qoverp, 0u) =
+        -1.f / detray::unit<scalar>::GeV;
+    const bound_track_parameters start{
+        first, vec,
+        matrix_operator().template zero<e_bound_size, e_bound_size>()};
+
+    const auto expected =
+        propagate_through(det, const_view_t(const_field), start);
+    const auto result =
+        propagate_through(det, cached_field_map::view_t(map), start);
+
+    // The track reaches all other planes in both fields
+    ASSERT_EQ(expected.size(), plane_positions.size() - 1u);
+    ASSERT_EQ(result.size(), expected.size());
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        EXPECT_EQ(result[i].surface_link(), expected[i].surface_link());
+        EXPECT_NEAR(result[i].bound_local()[0], expected[i].bound_local()[0],
+                    1e-3f);
+        EXPECT_NEAR(result[i].bound_local()[1], expected[i].bound_local()[1],
+                    1e-3f);
+        EXPECT_NEAR(result[i].phi(), expected[i].phi(), 1e-5f);
+        EXPECT_NEAR(result[i].theta(), expected[i].theta(), 1e-5f);
+    }
+
+    // The stepper read the field through the map, re-using the cached cells
+    EXPECT_GT(map.n_lookups(), 0u);
+    EXPECT_LT(map.n_cell_loads(), map.n_lookups());
+}
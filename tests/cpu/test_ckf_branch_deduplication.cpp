@@ -0,0 +1,133 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/definitions/common.hpp"
+#include "traccc/edm/measurement.hpp"
+#include "traccc/edm/track_parameters.hpp"
+#include "traccc/finding/finding_algorithm.hpp"
+
+// detray include(s).
+#include "detray/detectors/bfield.hpp"
+#include "detray/detectors/create_telescope_detector.hpp"
+#include "detray/intersection/detail/trajectories.hpp"
+#include "detray/propagator/navigator.hpp"
+#include "detray/propagator/rk_stepper.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/host_memory_resource.hpp>
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+// System include(s).
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace traccc;
+
+namespace {
+
+// Type declarations
+using detector_type =
+    detray::detector<detray::telescope_metadata<detray::rectangle2D<>>,
+                     detray::host_container_types>;
+using b_field_t = covfie::field<detray::bfield::const_bknd_t>;
+using rk_stepper_type = detray::rk_stepper<b_field_t::view_t, transform3,
+                                           detray::constrained_step<>>;
+using navigator_type = detray::navigator<const detector_type>;
+using matrix_operator = typename transform3::matrix_actor;
+
+}  // namespace
+
+// Branches are only duplicates of each other if they come from the same seed
+// and picked up the same measurements on all surfaces, not just on the last
+// ones.
+TEST(ckf_branch_deduplication, measurement_history) {
+
+    vecmem::host_memory_resource host_mr;
+
+    // Telescope detector with 5 planes along the x axis, in no field
+    detray::mask<detray::rectangle2D<>> rectangle{
+        0u, 100.f * detray::unit<scalar>::mm, 100.f * detray::unit<scalar>::mm};
+    detray::detail::ray<transform3> traj{{0, 0, 0}, 0, {1, 0, 0}, -1};
+    const std::vector<scalar> plane_positions = {20.f, 40.f, 60.f, 80.f,
+                                                 100.f};
+
+    detray::tel_det_config<> tel_cfg{rectangle};
+    tel_cfg.positions(plane_positions);
+    tel_cfg.pilot_track(traj);
+    const auto [det, names] = create_telescope_detector(host_mr, tel_cfg);
+    const auto field = detray::bfield::create_const_field(vector3{0, 0, 0});
+
+    std::vector<detray::geometry::barcode> planes;
+    for (const auto& sf_desc : det.surface_lookup()) {
+        if (sf_desc.is_sensitive()) {
+            planes.push_back(sf_desc.barcode());
+        }
+    }
+    ASSERT_EQ(planes.size(), plane_positions.size());
+
+    // Two compatible measurements on the first plane, and one on every other
+    // plane. Tracks with either of the first measurements share all other
+    // measurements.
+    measurement_collection_types::host measurements(&host_mr);
+    const auto add_measurement = [&](detray::geometry::barcode plane,
+                                     scalar loc1) {
+        measurement meas;
+        meas.local = {0.f, loc1};
+        meas.variance = {0.01f, 0.01f};
+        meas.surface_link = plane;
+        measurements.push_back(meas);
+    };
+    add_measurement(planes[0], 0.1f);
+    add_measurement(planes[0], -0.1f);
+    for (std::size_t i = 1; i < planes.size(); ++i) {
+        add_measurement(planes[i], 0.f);
+    }
+    std::sort(measurements.begin(), measurements.end());
+
+    // Two identical seeds on the first plane, moving along the planes, as
+    // they could come from a seeding without seed deduplication
+    bound_vector vec = matrix_operator().template zero<e_bound_size, 1>();
+    getter::element(vec, e_bound_phi, 0u) = 0.f;
+    getter::element(vec, e_bound_theta, 0u) = static_cast<scalar>(M_PI_2);
+    getter::element(vec, e_bound_qoverp, 0u) =
+        -1.f / detray::unit<scalar>::GeV;
+    bound_covariance cov =
+        matrix_operator().template zero<e_bound_size, e_bound_size>();
+    getter::element(cov, e_bound_loc0, e_bound_loc0) = 1.f;
+    getter::element(cov, e_bound_loc1, e_bound_loc1) = 1.f;
+    getter::element(cov, e_bound_phi, e_bound_phi) = 1e-4f;
+    getter::element(cov, e_bound_theta, e_bound_theta) = 1e-4f;
+    getter::element(cov, e_bound_qoverp, e_bound_qoverp) = 1e-6f;
+    getter::element(cov, e_bound_time, e_bound_time) = 1.f;
+    bound_track_parameters_collection_types::host seeds(&host_mr);
+    seeds.push_back({planes[0], vec, cov});
+    seeds.push_back({planes[0], vec, cov});
+
+    typename finding_algorithm<rk_stepper_type, navigator_type>::config_type
+        cfg;
+    finding_algorithm<rk_stepper_type, navigator_type> host_finding(cfg);
+    const auto track_candidates =
+        host_finding(det, field, measurements, seeds);
+
+    // The branches of the two seeds are not merged, even though they pick up
+    // the same measurements, and neither are the branches starting with
+    // different measurements on the first plane.
+    ASSERT_EQ(track_candidates.size(), 4u);
+    unsigned int n_upper = 0u;
+    for (std::size_t i = 0; i < track_candidates.size(); ++i) {
+        ASSERT_EQ(track_candidates[i].items.size(), planes.size());
+        for (std::size_t j = 1; j < planes.size(); ++j) {
+            EXPECT_EQ(track_candidates[i].items[j].surface_link, planes[j]);
+        }
+        n_upper += (track_candidates[i].items[0].local[1] > 0.f);
+    }
+    EXPECT_EQ(n_upper, 2u);
+}
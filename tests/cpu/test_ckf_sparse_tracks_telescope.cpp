@@ -32,6 +32,7 @@
 #include <gtest/gtest.h>
 
 // System include(s).
+#include <cmath>
 #include <filesystem>
 #include <string>
 
@@ -193,6 +194,67 @@ TEST_P(CkfSparseTrackTelescopeTests, Run) {
             fit_performance_writer.write(track_states_per_track, fit_info,
                                          host_det, evt_map);
         }
+
+        // Run finding, keeping the filtered track states, and only smooth
+        // the tracks afterwards
+        traccc::track_state_container_types::host filtered_states{&host_mr};
+        auto track_candidates2 = host_finding(
+            host_det, field, measurements_per_event, seeds, filtered_states);
+
+        ASSERT_EQ(track_candidates2.size(), n_truth_tracks);
+        ASSERT_EQ(filtered_states.size(), n_truth_tracks);
+
+        auto smoothed_states =
+            host_fitting(host_det, field, std::move(filtered_states));
+
+        ASSERT_EQ(smoothed_states.size(), n_truth_tracks);
+
+        for (unsigned int i_trk = 0; i_trk < n_truth_tracks; i_trk++) {
+
+            const auto& track_states_per_track = smoothed_states[i_trk].items;
+            const auto& fit_info = smoothed_states[i_trk].header;
+
+            ASSERT_EQ(track_states_per_track.size(),
+                      track_candidates2[i_trk].items.size());
+
+            consistency_tests(track_states_per_track);
+
+            // The smoothing of the filtered states must agree with the full
+            // refit of the same track, up to the small differences of the
+            // propagation between the finding and the fitting
+            const auto& refit_states = track_states[i_trk].items;
+            const auto& refit_info = track_states[i_trk].header;
+            ASSERT_EQ(track_states_per_track.size(), refit_states.size());
+
+            EXPECT_FLOAT_EQ(fit_info.ndf, refit_info.ndf);
+            EXPECT_NEAR(fit_info.chi2, refit_info.chi2,
+                        1e-2f * (1.f + refit_info.chi2));
+
+            for (unsigned int i = 0; i < refit_states.size(); i++) {
+                const auto& state = track_states_per_track[i];
+                const auto& refit_state = refit_states[i];
+
+                ASSERT_EQ(state.is_hole, refit_state.is_hole);
+                ASSERT_EQ(state.surface_link(), refit_state.surface_link());
+                if (state.is_hole) {
+                    continue;
+                }
+                EXPECT_NEAR(state.smoothed_chi2(), refit_state.smoothed_chi2(),
+                            1e-2f * (1.f + refit_state.smoothed_chi2()));
+
+                // Compare the parameters in units of their uncertainty
+                const auto& vec = state.smoothed().vector();
+                const auto& refit_vec = refit_state.smoothed().vector();
+                const auto& refit_cov = refit_state.smoothed().covariance();
+                for (unsigned int j : {e_bound_loc0, e_bound_loc1, e_bound_phi,
+                                       e_bound_theta, e_bound_qoverp}) {
+                    EXPECT_NEAR(getter::element(vec, j, 0u),
+                                getter::element(refit_vec, j, 0u),
+                                0.1f * std::sqrt(getter::element(
+                                           refit_cov, j, j)));
+                }
+            }
+        }
     }
 
     fit_performance_writer.finalize();
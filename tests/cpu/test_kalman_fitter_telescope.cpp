@@ -30,8 +30,11 @@
 #include <gtest/gtest.h>
 
 // System include(s).
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
 #include <string>
+#include <vector>
 
 using namespace traccc;
 
@@ -175,6 +178,131 @@ TEST_P(KalmanFittingTelescopeTests, Run) {
     std::filesystem::remove_all(full_path);
 }
 
+// The fit iterations stop once the chi-square of a track changes by less than
+// the configured tolerance, with the result of the last iteration that ran
+TEST_F(KalmanFittingTelescopeTests, IterationConvergence) {
+
+    const unsigned int n_truth_tracks = 100;
+    const std::size_t max_iterations = 5;
+
+    // Memory resources used by the application.
+    vecmem::host_memory_resource host_mr;
+
+    // Read back detector file
+    detray::io::detector_reader_config reader_cfg{};
+    reader_cfg.add_file("telescope_detector_geometry.json")
+        .add_file("telescope_detector_homogeneous_material.json")
+        .add_file("telescope_detector_surface_grids.json");
+
+    const auto [host_det, names] =
+        detray::io::read_detector<host_detector_type>(host_mr, reader_cfg);
+    auto field = detray::bfield::create_const_field(B);
+
+    // Simulate one event of 1 GeV tracks
+    using generator_type =
+        detray::random_track_generator<traccc::free_track_parameters,
+                                       uniform_gen_t>;
+    generator_type::configuration gen_cfg{};
+    gen_cfg.n_tracks(n_truth_tracks);
+    gen_cfg.origin({0.f, 0.f, 0.f});
+    gen_cfg.origin_stddev({0.f, 0.f, 0.f});
+    gen_cfg.phi_range(0.f, 0.f);
+    gen_cfg.theta_range(static_cast<scalar>(M_PI_2),
+                        static_cast<scalar>(M_PI_2));
+    gen_cfg.mom_range(1.f, 1.f);
+    generator_type generator(gen_cfg);
+
+    traccc::measurement_smearer<transform3> meas_smearer(smearing[0],
+                                                         smearing[1]);
+    using writer_type =
+        traccc::smearing_writer<traccc::measurement_smearer<transform3>>;
+    typename writer_type::config smearer_writer_cfg{meas_smearer};
+
+    const std::string path = "telescope_iteration_convergence/";
+    const std::string full_path = io::data_directory() + path;
+    std::filesystem::create_directories(full_path);
+    auto sim = traccc::simulator<host_detector_type, b_field_t, generator_type,
+                                 writer_type>(
+        1, host_det, field, std::move(generator),
+        std::move(smearer_writer_cfg), full_path);
+    sim.run();
+
+    seed_generator<host_detector_type> sg(host_det, stddevs);
+    traccc::event_map2 evt_map(0, path, path, path);
+    const traccc::track_candidate_container_types::host track_candidates =
+        evt_map.generate_truth_candidates(sg, host_mr);
+    ASSERT_EQ(track_candidates.size(), n_truth_tracks);
+
+    // Fit the tracks with a fixed number of iterations, from 1 up to the
+    // maximum
+    using fitting_type = fitting_algorithm<host_fitter_type>;
+    std::vector<fitting_type::output_type> fixed_fits;
+    for (std::size_t n = 1; n <= max_iterations; n++) {
+        fitting_type::config_type fit_cfg;
+        fit_cfg.n_iterations = n;
+        fixed_fits.push_back(
+            fitting_type(fit_cfg)(host_det, field, track_candidates));
+        ASSERT_EQ(fixed_fits.back().size(), n_truth_tracks);
+    }
+
+    // Change of the chi-square of a track from the iteration before
+    auto chi2_change = [&fixed_fits](std::size_t n, std::size_t i_trk) {
+        return std::abs(fixed_fits[n - 1][i_trk].header.chi2 -
+                        fixed_fits[n - 2][i_trk].header.chi2);
+    };
+
+    // Use the median chi-square change of the second iteration as the
+    // tolerance, so that a good fraction of the tracks stops early
+    std::vector<scalar> first_changes;
+    for (std::size_t i_trk = 0; i_trk < n_truth_tracks; i_trk++) {
+        first_changes.push_back(chi2_change(2u, i_trk));
+    }
+    std::nth_element(first_changes.begin(),
+                     first_changes.begin() + n_truth_tracks / 2,
+                     first_changes.end());
+    const scalar tolerance = first_changes[n_truth_tracks / 2];
+    ASSERT_GT(tolerance, 0.f);
+
+    fitting_type::config_type conv_cfg;
+    conv_cfg.n_iterations = max_iterations;
+    conv_cfg.chi2_tolerance = tolerance;
+    const auto conv_fits =
+        fitting_type(conv_cfg)(host_det, field, track_candidates);
+    ASSERT_EQ(conv_fits.size(), n_truth_tracks);
+
+    std::size_t n_early = 0;
+    for (std::size_t i_trk = 0; i_trk < n_truth_tracks; i_trk++) {
+
+        // The number of iterations that the fit is expected to run
+        std::size_t n = 2;
+        while (n < max_iterations && !(chi2_change(n, i_trk) < tolerance)) {
+            ++n;
+        }
+        n_early += (n < max_iterations);
+
+        // The fit stopped after that many iterations...
+        const auto& conv_info = conv_fits[i_trk].header;
+        const auto& fixed_info = fixed_fits[n - 1][i_trk].header;
+        EXPECT_FLOAT_EQ(conv_info.chi2, fixed_info.chi2);
+        EXPECT_FLOAT_EQ(conv_info.fit_params.qop(),
+                        fixed_info.fit_params.qop());
+        EXPECT_FLOAT_EQ(conv_info.ndf, fixed_info.ndf);
+
+        // ...and, if it stopped early, differs from the fit with all
+        // iterations by no more than the tolerance per skipped iteration
+        if (n < max_iterations) {
+            const auto& full_info =
+                fixed_fits[max_iterations - 1][i_trk].header;
+            EXPECT_NEAR(conv_info.chi2, full_info.chi2,
+                        static_cast<scalar>(max_iterations - n) * tolerance);
+        }
+    }
+    EXPECT_GT(n_early, 0u);
+
+    // Remove the data
+    std::filesystem::remove_all(full_path);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     KalmanFitTelescopeValidation0, KalmanFittingTelescopeTests,
     ::testing::Values(std::make_tuple(
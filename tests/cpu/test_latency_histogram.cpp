@@ -0,0 +1,96 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/performance/latency_histogram.hpp"
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+// System include(s).
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace traccc::performance;
+
+TEST(latency_histogram, percentiles) {
+
+    latency_histogram hist;
+
+    // Record the latencies 1, 2, ..., 10000 us
+    for (int i = 1; i <= 10000; ++i) {
+        hist.record(std::chrono::microseconds{i});
+    }
+    ASSERT_EQ(hist.count(), 10000u);
+    EXPECT_EQ(hist.max(), std::chrono::microseconds{10000});
+    EXPECT_EQ(hist.mean().count(), 5000500);
+
+    // The percentiles are precise to the width of the buckets
+    for (double fraction : {0.5, 0.9, 0.99, 0.999}) {
+        const double expected = fraction * 1e7;
+        const double result =
+            static_cast<double>(hist.percentile(fraction).count());
+        EXPECT_GE(result, expected);
+        EXPECT_LE(result, expected * 1.04);
+    }
+    EXPECT_EQ(hist.percentile(1.), hist.max());
+
+    hist.reset();
+    EXPECT_EQ(hist.count(), 0u);
+    EXPECT_EQ(hist.percentile(0.5).count(), 0);
+}
+
+TEST(latency_histogram, value_range) {
+
+    latency_histogram hist;
+
+    // Small values are recorded exactly, and huge ones do not overflow
+    hist.record(std::chrono::nanoseconds{0});
+    hist.record(std::chrono::nanoseconds{3});
+    hist.record(std::chrono::nanoseconds{
+        std::numeric_limits<std::chrono::nanoseconds::rep>::max()});
+
+    EXPECT_EQ(hist.percentile(0.3).count(), 0);
+    EXPECT_EQ(hist.percentile(0.6).count(), 3);
+    EXPECT_EQ(hist.percentile(1.).count(),
+              std::numeric_limits<std::chrono::nanoseconds::rep>::max());
+}
+
+TEST(event_latency_recorder, multi_threaded) {
+
+    event_latency_recorder rec;
+
+    // Record small, fast events and large, slow ones from multiple threads
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < 4; ++i) {
+        threads.emplace_back([&rec]() {
+            for (unsigned int j = 0; j < 1000; ++j) {
+                rec.record(std::chrono::microseconds{100}, 1000);
+                rec.record(std::chrono::microseconds{5000}, 100000);
+            }
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(rec.all().count(), 8000u);
+    // 1000 is in [2^9, 2^10), 100000 is in [2^16, 2^17)
+    EXPECT_EQ(rec.size_class(9).count(), 4000u);
+    EXPECT_EQ(rec.size_class(16).count(), 4000u);
+    EXPECT_EQ(rec.size_class(9).max(), std::chrono::microseconds{100});
+    EXPECT_EQ(rec.size_class(16).max(), std::chrono::microseconds{5000});
+
+    // The printout works
+    std::ostringstream out;
+    out << rec;
+    EXPECT_FALSE(out.str().empty());
+}
@@ -0,0 +1,57 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/seeding/seed_deduplication.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/host_memory_resource.hpp>
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+using namespace traccc;
+
+TEST(seed_deduplication, shared_spacepoints) {
+
+    // Memory resource used by the EDM.
+    vecmem::host_memory_resource host_mr;
+
+    // Make seeds with (partially) shared spacepoints
+    seed_collection_types::host seeds;
+    // Shares two spacepoints with the next seed, but has a lower weight
+    seeds.push_back({0u, 1u, 2u, 1.f, 0.f});
+    seeds.push_back({0u, 1u, 3u, 2.f, 0.f});
+    // Shares only one spacepoint with the other seeds
+    seeds.push_back({3u, 4u, 5u, 0.5f, 0.f});
+    // Shares two spacepoints (in a different order) with the previous seed
+    seeds.push_back({5u, 6u, 3u, 0.1f, 0.f});
+    // Does not share any spacepoints
+    seeds.push_back({7u, 8u, 9u, 0.f, 0.f});
+
+    // Run the seed deduplication
+    traccc::seed_deduplication sd(host_mr);
+    const auto unique_seeds = sd(seeds);
+
+    // Make sure that the highest weight seeds were kept, in their original
+    // order
+    ASSERT_EQ(unique_seeds.size(), 3u);
+    EXPECT_EQ(unique_seeds[0].spT_link, 3u);
+    EXPECT_EQ(unique_seeds[1].spB_link, 3u);
+    EXPECT_EQ(unique_seeds[2].spB_link, 7u);
+}
+
+TEST(seed_deduplication, empty) {
+
+    // Memory resource used by the EDM.
+    vecmem::host_memory_resource host_mr;
+
+    seed_collection_types::host seeds;
+
+    traccc::seed_deduplication sd(host_mr);
+    EXPECT_EQ(sd(seeds).size(), 0u);
+}
@@ -0,0 +1,117 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/performance/stage_timing.hpp"
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+// System include(s).
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace traccc::performance;
+
+TEST(stage_timing, multi_threaded) {
+
+    stage_timing timing;
+
+    // Record the same measurements from a number of threads, each one using
+    // its own accumulator
+    static constexpr unsigned int n_threads = 4;
+    static constexpr unsigned int n_calls = 1000;
+    std::vector<stage_timing::accumulator*> accumulators;
+    for (unsigned int i = 0; i < n_threads; ++i) {
+        accumulators.push_back(&timing.make_accumulator());
+    }
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < n_threads; ++i) {
+        threads.emplace_back([acc = accumulators[i]]() {
+            for (unsigned int j = 0; j < n_calls; ++j) {
+                acc->add(stage::seeding, std::chrono::nanoseconds{2});
+                acc->add(stage::clusterization, std::chrono::nanoseconds{1});
+            }
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(timing.n_calls(stage::seeding), n_threads * n_calls);
+    EXPECT_EQ(timing.total_time(stage::seeding).count(),
+              2 * n_threads * n_calls);
+    EXPECT_EQ(timing.total_time(stage::clusterization).count(),
+              n_threads * n_calls);
+    EXPECT_EQ(timing.n_calls(stage::track_fitting), 0u);
+
+    // Only the stages that were called show up in the merged timing
+    const timing_info merged = timing.merge();
+    ASSERT_EQ(merged.data.size(), 2u);
+    EXPECT_EQ(merged.get_time(stage_name(stage::seeding)).count(),
+              2 * n_threads * n_calls);
+
+    timing.reset();
+    EXPECT_EQ(timing.n_calls(stage::seeding), 0u);
+    EXPECT_EQ(timing.merge().data.size(), 0u);
+}
+
+TEST(stage_timing, scope) {
+
+    stage_timing timing;
+    stage_timing::accumulator& acc = timing.make_accumulator();
+
+    {
+        stage_timing::scope t{&acc, stage::track_finding};
+    }
+    // Scopes without an accumulator do not record anything
+    {
+        stage_timing::scope t{nullptr, stage::track_finding};
+    }
+    EXPECT_EQ(timing.n_calls(stage::track_finding), 1u);
+}
+
+TEST(stage_timing, hardware_counters) {
+
+    stage_timing timing{true};
+    stage_timing::accumulator& acc = timing.make_accumulator();
+    ASSERT_TRUE(acc.records_hardware_counters());
+
+    // Do some work in a stage
+    volatile double sum = 0.;
+    {
+        stage_timing::scope t{&acc, stage::seeding};
+        for (int i = 0; i < 100000; ++i) {
+            sum = sum + static_cast<double>(i);
+        }
+    }
+    EXPECT_EQ(timing.n_calls(stage::seeding), 1u);
+
+    // The counters can only be checked where the platform provides them
+    const hardware_counters& counters = hardware_counters::this_thread();
+    if (counters.is_available(hw_counter::instructions)) {
+        EXPECT_GT(timing.total_count(stage::seeding, hw_counter::instructions),
+                  100000u);
+    }
+    EXPECT_EQ(timing.total_count(stage::track_fitting, hw_counter::cycles),
+              0u);
+
+    // The table of the counters states what they include
+    std::ostringstream table;
+    timing.print_hardware_counters(table);
+    if (counters.is_available(hw_counter::cycles)) {
+        EXPECT_NE(table.str().find(hw_counter_caveat), std::string::npos);
+    }
+
+    // The counters are reset together with the times
+    timing.reset();
+    EXPECT_EQ(timing.total_count(stage::seeding, hw_counter::instructions),
+              0u);
+}
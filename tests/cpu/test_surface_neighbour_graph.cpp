@@ -0,0 +1,270 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/definitions/common.hpp"
+#include "traccc/edm/track_parameters.hpp"
+#include "traccc/finding/surface_neighbour_graph.hpp"
+
+// detray include(s).
+#include "detray/detectors/bfield.hpp"
+#include "detray/detectors/create_telescope_detector.hpp"
+#include "detray/geometry/surface.hpp"
+#include "detray/intersection/detail/trajectories.hpp"
+#include "detray/propagator/actor_chain.hpp"
+#include "detray/propagator/actors/aborters.hpp"
+#include "detray/propagator/actors/parameter_transporter.hpp"
+#include "detray/propagator/navigator.hpp"
+#include "detray/propagator/propagator.hpp"
+#include "detray/propagator/rk_stepper.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/host_memory_resource.hpp>
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+// System include(s).
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <vector>
+
+using namespace traccc;
+
+namespace {
+
+// Type declarations
+using detector_type =
+    detray::detector<detray::telescope_metadata<detray::rectangle2D<>>,
+                     detray::host_container_types>;
+using b_field_t = covfie::field<detray::bfield::const_bknd_t>;
+using rk_stepper_type = detray::rk_stepper<b_field_t::view_t, transform3,
+                                           detray::constrained_step<>>;
+using navigator_type = detray::navigator<const detector_type>;
+using matrix_operator = typename transform3::matrix_actor;
+
+/// Make track parameters on a surface from a global position and direction
+bound_track_parameters make_parameters(const detector_type& det,
+                                       detray::geometry::barcode surface,
+                                       const point3& pos, const vector3& dir) {
+
+    const free_track_parameters free_param(
+        pos, 0.f, 10.f * detray::unit<scalar>::GeV * vector::normalize(dir),
+        -1.f);
+    const detray::surface<detector_type> sf{det, surface};
+    return {surface, sf.free_to_bound_vector({}, free_param.vector()),
+            matrix_operator().template zero<e_bound_size, e_bound_size>()};
+}
+
+/// Make track parameters on a surface from a local position and a direction
+bound_track_parameters make_local_parameters(detray::geometry::barcode surface,
+                                             scalar loc0, scalar loc1,
+                                             const vector3& dir) {
+
+    bound_vector vec = matrix_operator().template zero<e_bound_size, 1>();
+    getter::element(vec, e_bound_loc0, 0u) = loc0;
+    getter::element(vec, e_bound_loc1, 0u) = loc1;
+    getter::element(vec, e_bound_phi, 0u) = getter::phi(dir);
+    getter::element(vec, e_bound_theta, 0u) = getter::theta(dir);
+    getter::element(vec, e_bound_qoverp, 0u) =
+        -1.f / (10.f * detray::unit<scalar>::GeV);
+    return {surface, vec,
+            matrix_operator().template zero<e_bound_size, e_bound_size>()};
+}
+
+/// Find the next sensitive surface of a track with the full navigation
+///
+/// @return @c true if the track reached another sensitive surface
+///
+bool navigate_to_next_surface(const detector_type& det,
+                              const rk_stepper_type::magnetic_field_type& field,
+                              const bound_track_parameters& param,
+                              detray::geometry::barcode& next) {
+
+    using actor_type =
+        detray::actor_chain<std::tuple, detray::pathlimit_aborter,
+                            detray::parameter_transporter<transform3>,
+                            detray::next_surface_aborter>;
+    using propagator_type =
+        detray::propagator<rk_stepper_type, navigator_type, actor_type>;
+
+    propagator_type propagator({}, {});
+    typename propagator_type::state propagation(param, field, det);
+
+    typename detray::pathlimit_aborter::state s0;
+    typename detray::parameter_transporter<transform3>::state s1;
+    typename detray::next_surface_aborter::state s2{
+        0.1f * detray::unit<scalar>::mm};
+
+    propagation._navigation.set_volume(param.surface_link().volume());
+    propagator.propagate_sync(propagation, std::tie(s0, s1, s2));
+
+    if (s2.success) {
+        next = propagation._stepping._bound_params.surface_link();
+    }
+    return s2.success;
+}
+
+}  // namespace
+
+// Tracks close to the edge of a surface may reach a next surface that the
+// probes of their bin, started from the centre of the surface, did not.
+TEST(surface_neighbour_graph, surface_edges) {
+
+    vecmem::host_memory_resource host_mr;
+
+    // Two small planes, 20 mm apart, with a half-length of 10 mm
+    detray::mask<detray::rectangle2D<>> rectangle{
+        0u, 10.f * detray::unit<scalar>::mm, 10.f * detray::unit<scalar>::mm};
+    detray::detail::ray<transform3> traj{{0, 0, 0}, 0, {1, 0, 0}, -1};
+    std::vector<scalar> plane_positions = {20.f, 40.f};
+
+    detray::tel_det_config<> tel_cfg{rectangle};
+    tel_cfg.positions(plane_positions);
+    tel_cfg.pilot_track(traj);
+
+    const auto [det, names] = create_telescope_detector(host_mr, tel_cfg);
+    const auto field = detray::bfield::create_const_field(vector3{0, 0, 0});
+
+    const auto surfaces = det.surface_lookup();
+    const detray::geometry::barcode first = surfaces[0].barcode();
+    const detray::geometry::barcode second = surfaces[1].barcode();
+
+    // A graph probing the surfaces from their centres only
+    surface_neighbour_graph_config graph_cfg;
+    graph_cfg.n_phi_bins = 64;
+    graph_cfg.n_theta_bins = 32;
+    graph_cfg.n_momentum_bins = 1;
+    graph_cfg.local_positions = {{0.f, 0.f}};
+    const auto centre_graph =
+        surface_neighbour_graph::build<rk_stepper_type, navigator_type>(
+            det, field, graph_cfg);
+    ASSERT_EQ(centre_graph.n_surfaces(), 2u);
+
+    // The planes reach each other
+    const auto [begin, end] = centre_graph.next_surfaces(first);
+    ASSERT_EQ(std::distance(begin, end), 1);
+    EXPECT_EQ(*begin, second);
+
+    // Tracks leaving the first plane at a steep angle. From its centre the
+    // track misses the second plane, from close to its edge it reaches it.
+    const vector3 dir{1.f, 0.8f, 0.8f};
+    const bound_track_parameters centre_track =
+        make_parameters(det, first, {20.f, 0.f, 0.f}, dir);
+    const bound_track_parameters edge_track =
+        make_parameters(det, first, {20.f, -8.f, -8.f}, dir);
+
+    // The bin of the tracks is predicted to be terminal...
+    EXPECT_TRUE(centre_graph.is_terminal(centre_track));
+    EXPECT_TRUE(centre_graph.is_terminal(edge_track));
+    // ...but the full navigation takes the edge track to the second plane.
+    // So skipping the propagation of the predicted terminal tracks would
+    // lose tracks.
+    detray::geometry::barcode next;
+    EXPECT_FALSE(navigate_to_next_surface(det, field, centre_track, next));
+    ASSERT_TRUE(navigate_to_next_surface(det, field, edge_track, next));
+    EXPECT_EQ(next, second);
+
+    // Probing the surfaces from close to their corners as well finds the
+    // bin to be reachable
+    graph_cfg.local_positions = {{0.f, 0.f},
+                                 {-8.f, -8.f},
+                                 {-8.f, 8.f},
+                                 {8.f, -8.f},
+                                 {8.f, 8.f}};
+    const auto corner_graph =
+        surface_neighbour_graph::build<rk_stepper_type, navigator_type>(
+            det, field, graph_cfg);
+    EXPECT_FALSE(corner_graph.is_terminal(edge_track));
+
+    // Tracks leaving the last plane forward never reach another plane, even
+    // though the first plane is reachable from it backwards
+    const bound_track_parameters last_track =
+        make_parameters(det, second, {40.f, 0.f, 0.f}, {1.f, 0.f, 0.f});
+    EXPECT_TRUE(centre_graph.is_terminal(last_track));
+    EXPECT_FALSE(navigate_to_next_surface(det, field, last_track, next));
+}
+
+// Compare the predictions of the graph with the full navigation, for tracks
+// spread over the planes of a telescope in a magnetic field
+TEST(surface_neighbour_graph, navigator_efficiency) {
+
+    vecmem::host_memory_resource host_mr;
+
+    // Nine planes, 20 mm apart, with a half-length of 100 mm
+    detray::mask<detray::rectangle2D<>> rectangle{
+        0u, 100.f * detray::unit<scalar>::mm,
+        100.f * detray::unit<scalar>::mm};
+    detray::detail::ray<transform3> traj{{0, 0, 0}, 0, {1, 0, 0}, -1};
+    std::vector<scalar> plane_positions = {20.f,  40.f,  60.f,  80.f, 100.f,
+                                           120.f, 140.f, 160.f, 180.f};
+
+    detray::tel_det_config<> tel_cfg{rectangle};
+    tel_cfg.positions(plane_positions);
+    tel_cfg.pilot_track(traj);
+
+    const auto [det, names] = create_telescope_detector(host_mr, tel_cfg);
+    const auto field = detray::bfield::create_const_field(
+        vector3{0, 0, 2.f * detray::unit<scalar>::T});
+
+    const auto graph =
+        surface_neighbour_graph::build<rk_stepper_type, navigator_type>(
+            det, field);
+    ASSERT_EQ(graph.n_surfaces(), plane_positions.size());
+
+    // Tracks from every plane, forward and backward, at different positions
+    // and angles
+    std::size_t n_tracks = 0;
+    std::size_t n_reached = 0;
+    std::size_t n_candidate = 0;
+    std::size_t n_terminal = 0;
+    std::size_t n_false_terminal = 0;
+    for (const auto& sf_desc : det.surface_lookup()) {
+        if (!sf_desc.is_sensitive()) {
+            continue;
+        }
+        const detray::geometry::barcode surface = sf_desc.barcode();
+        for (const scalar loc : {-60.f, 0.f, 60.f}) {
+            for (const scalar slope : {-1.f, -0.3f, 0.f, 0.3f, 1.f}) {
+                for (const scalar dir_x : {-1.f, 1.f}) {
+
+                    const bound_track_parameters param =
+                        make_local_parameters(
+                            surface, loc, -loc,
+                            vector::normalize(
+                                vector3{dir_x, slope, 0.5f * slope}));
+                    ++n_tracks;
+
+                    detray::geometry::barcode next;
+                    const bool reached =
+                        navigate_to_next_surface(det, field, param, next);
+                    const bool terminal = graph.is_terminal(param);
+                    n_terminal += terminal;
+                    if (!reached) {
+                        continue;
+                    }
+                    ++n_reached;
+                    n_false_terminal += terminal;
+
+                    // The only surfaces to intersect with the graph
+                    const auto [begin, end] = graph.next_surfaces(surface);
+                    n_candidate += (std::find(begin, end, next) != end);
+                }
+            }
+        }
+    }
+
+    // Every surface that the navigator finds is one of the candidates of the
+    // graph, and the graph does not predict a reached track to be terminal
+    ASSERT_GT(n_reached, 0u);
+    EXPECT_LT(n_reached, n_tracks);
+    EXPECT_EQ(n_candidate, n_reached);
+    EXPECT_EQ(n_false_terminal, 0u);
+    EXPECT_GT(n_terminal, 0u);
+}
@@ -0,0 +1,77 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/performance/benchmark_report.hpp"
+#include "traccc/performance/thread_scaling.hpp"
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+// System include(s).
+#include <chrono>
+#include <sstream>
+#include <string>
+
+using namespace traccc::performance;
+
+TEST(thread_scaling, speedup_and_efficiency) {
+
+    // Points added out of order, to make sure that the baseline is the one
+    // with the fewest threads
+    thread_scaling scaling;
+    scaling.add(4, 400, std::chrono::seconds{2});
+    scaling.add(1, 100, std::chrono::seconds{2});
+    scaling.add(2, 200, std::chrono::seconds{1});
+
+    ASSERT_EQ(scaling.points().size(), 3u);
+    const thread_scaling::point& four = scaling.points()[0];
+    const thread_scaling::point& one = scaling.points()[1];
+    const thread_scaling::point& two = scaling.points()[2];
+
+    EXPECT_DOUBLE_EQ(one.events_per_second(), 50.);
+    EXPECT_DOUBLE_EQ(scaling.speedup(one), 1.);
+    EXPECT_DOUBLE_EQ(scaling.efficiency(one), 1.);
+    EXPECT_DOUBLE_EQ(scaling.speedup(two), 4.);
+    EXPECT_DOUBLE_EQ(scaling.efficiency(two), 2.);
+    EXPECT_DOUBLE_EQ(scaling.speedup(four), 4.);
+    EXPECT_DOUBLE_EQ(scaling.efficiency(four), 1.);
+}
+
+TEST(thread_scaling, baseline_with_multiple_threads) {
+
+    // If the sweep did not start from one thread, the speed-up and the
+    // efficiency are relative to its smallest thread count
+    thread_scaling scaling;
+    scaling.add(2, 100, std::chrono::seconds{1});
+    scaling.add(8, 300, std::chrono::seconds{1});
+
+    EXPECT_DOUBLE_EQ(scaling.speedup(scaling.points()[0]), 1.);
+    EXPECT_DOUBLE_EQ(scaling.efficiency(scaling.points()[0]), 1.);
+    EXPECT_DOUBLE_EQ(scaling.speedup(scaling.points()[1]), 3.);
+    EXPECT_DOUBLE_EQ(scaling.efficiency(scaling.points()[1]), 0.75);
+}
+
+TEST(thread_scaling, output) {
+
+    thread_scaling scaling;
+    scaling.add(1, 10, std::chrono::seconds{1});
+    scaling.add(2, 15, std::chrono::seconds{1});
+
+    std::ostringstream table;
+    table << scaling;
+    EXPECT_NE(table.str().find("Efficiency"), std::string::npos);
+    EXPECT_NE(table.str().find("75.0%"), std::string::npos);
+
+    benchmark_report report;
+    report.scaling = &scaling;
+    std::ostringstream json;
+    write_json(json, report);
+    EXPECT_NE(json.str().find("{\"threads\": 2, \"events\": 15, "),
+              std::string::npos);
+    EXPECT_NE(json.str().find("\"efficiency\": 0.75}"), std::string::npos);
+}
@@ -0,0 +1,124 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2023 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/performance/stage_timing.hpp"
+#include "traccc/performance/trace_recorder.hpp"
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+// System include(s).
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace traccc::performance;
+
+namespace {
+
+/// Count the occurrences of a string in another one
+std::size_t count(const std::string& str, const std::string& what) {
+
+    std::size_t result = 0;
+    for (std::size_t pos = str.find(what); pos != std::string::npos;
+         pos = str.find(what, pos + what.size())) {
+        ++result;
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(trace_recorder, multi_threaded) {
+
+    trace_recorder trace;
+
+    // Record spans from a number of threads, each one using its own buffer
+    static constexpr unsigned int n_threads = 4;
+    static constexpr unsigned int n_events = 10;
+    std::vector<trace_recorder::buffer*> buffers;
+    for (unsigned int i = 0; i < n_threads; ++i) {
+        buffers.push_back(&trace.make_buffer(i));
+    }
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < n_threads; ++i) {
+        threads.emplace_back([buf = buffers[i]]() {
+            for (unsigned int event = 0; event < n_events; ++event) {
+                buf->set_event(event);
+                trace_recorder::scope span{buf, "Seeding"};
+            }
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    // Check the trace-event output
+    std::ostringstream out;
+    trace.write_json(out);
+    const std::string json = out.str();
+    EXPECT_EQ(count(json, "\"ph\": \"X\""), n_threads * n_events);
+    EXPECT_EQ(count(json, "\"thread_name\""), n_threads);
+    EXPECT_EQ(count(json, "\"name\": \"Seeding\""), n_threads * n_events);
+    EXPECT_EQ(count(json, "\"args\": {\"event\": 9}"), n_threads);
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.substr(json.size() - 3), "]}\n");
+}
+
+TEST(trace_recorder, ring_buffer) {
+
+    // Only the most recent spans are kept
+    trace_recorder trace{4};
+    trace_recorder::buffer& buf = trace.make_buffer(0);
+    for (std::size_t event = 0; event < 10; ++event) {
+        buf.set_event(event);
+        const auto now = trace_recorder::clock::now();
+        buf.record("Clusterization", now, now);
+    }
+
+    std::ostringstream out;
+    trace.write_json(out);
+    const std::string json = out.str();
+    EXPECT_EQ(count(json, "\"ph\": \"X\""), 4u);
+    for (std::size_t event = 0; event < 10; ++event) {
+        const std::string tag =
+            "\"args\": {\"event\": " + std::to_string(event) + "}";
+        EXPECT_EQ(count(json, tag), (event >= 6 ? 1u : 0u));
+    }
+    // The spans are written oldest first
+    EXPECT_LT(json.find("\"event\": 6}"), json.find("\"event\": 9}"));
+}
+
+TEST(trace_recorder, stage_scope) {
+
+    // Stage scopes record into the trace, with or without an accumulator
+    trace_recorder trace;
+    trace_recorder::buffer& buf = trace.make_buffer(0);
+    stage_timing timing;
+    stage_timing::accumulator& acc = timing.make_accumulator();
+    {
+        stage_timing::scope s{&acc, stage::track_finding, &buf};
+    }
+    {
+        stage_timing::scope s{nullptr, stage::track_fitting, &buf};
+    }
+    {
+        stage_timing::scope s{&acc, stage::seeding};
+    }
+
+    std::ostringstream out;
+    trace.write_json(out);
+    const std::string json = out.str();
+    EXPECT_EQ(count(json, "\"ph\": \"X\""), 2u);
+    EXPECT_EQ(count(json, "\"Track finding\""), 1u);
+    EXPECT_EQ(count(json, "\"Track fitting\""), 1u);
+    EXPECT_EQ(timing.n_calls(stage::track_finding), 1u);
+    EXPECT_EQ(timing.n_calls(stage::track_fitting), 0u);
+    EXPECT_EQ(timing.n_calls(stage::seeding), 1u);
+}
@@ -9,6 +9,7 @@
 #include "traccc/cuda/fitting/fitting_algorithm.hpp"
 #include "traccc/device/container_d2h_copy_alg.hpp"
 #include "traccc/device/container_h2d_copy_alg.hpp"
+#include "traccc/edm/fitted_track_state.hpp"
 #include "traccc/edm/track_state.hpp"
 #include "traccc/fitting/fitting_algorithm.hpp"
 #include "traccc/io/utils.hpp"
@@ -140,6 +141,10 @@ TEST_P(KalmanFittingTelescopeTests, Run) {
     traccc::device::container_d2h_copy_alg<traccc::track_state_container_types>
         track_state_d2h{mr, copy};
 
+    traccc::device::container_d2h_copy_alg<
+        traccc::fitted_track_state_container_types>
+        fitted_state_d2h{mr, copy};
+
     // Seed generator
     seed_generator<host_detector_type> sg(host_det, stddevs);
 
@@ -195,6 +200,39 @@ TEST_P(KalmanFittingTelescopeTests, Run) {
             fit_performance_writer.write(track_states_per_track, fit_info,
                                          host_det, evt_map);
         }
+
+        // Keep only the fit results, which must not change
+        traccc::fitted_track_state_container_types::host fitted_states_cuda =
+            fitted_state_d2h(device_fitting.compact(track_states_cuda_buffer));
+
+        ASSERT_EQ(fitted_states_cuda.size(), n_truth_tracks);
+
+        for (std::size_t i_trk = 0; i_trk < n_truth_tracks; i_trk++) {
+
+            const auto& track_states_per_track = track_states_cuda[i_trk].items;
+            const auto& fitted_states_per_track =
+                fitted_states_cuda[i_trk].items;
+
+            ASSERT_EQ(fitted_states_per_track.size(),
+                      track_states_per_track.size());
+            EXPECT_FLOAT_EQ(fitted_states_cuda[i_trk].header.ndf,
+                            track_states_cuda[i_trk].header.ndf);
+
+            for (unsigned int i = 0; i < fitted_states_per_track.size(); i++) {
+                const auto& fitted = fitted_states_per_track[i];
+                const auto& full = track_states_per_track[i];
+
+                EXPECT_EQ(fitted.measurement_index, i);
+                EXPECT_EQ(fitted.is_hole, full.is_hole);
+                EXPECT_EQ(fitted.surface_link(), full.surface_link());
+                if (!full.is_hole) {
+                    EXPECT_FLOAT_EQ(fitted.smoothed_chi2,
+                                    full.smoothed_chi2());
+                    EXPECT_FLOAT_EQ(fitted.smoothed.qop(),
+                                    full.smoothed().qop());
+                }
+            }
+        }
     }
 
     fit_performance_writer.finalize();